@@ -0,0 +1,27 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <chrono>
+#include <stdio.h>
+
+// Runs fn() repeatedly for at least minDuration and prints the average time
+template <typename TFunction>
+inline double benchmark(const char* name, TFunction fn,
+                        double minDuration = 0.5) {
+  using clock = std::chrono::steady_clock;
+  auto start = clock::now();
+  size_t iterations = 0;
+  double elapsed;
+  do {
+    fn();
+    iterations++;
+    elapsed = std::chrono::duration<double>(clock::now() - start).count();
+  } while (elapsed < minDuration);
+  double average = elapsed / static_cast<double>(iterations);
+  printf("%-40s %12.3f ms  (%zu iterations)\n", name, average * 1e3,
+         iterations);
+  return average;
+}
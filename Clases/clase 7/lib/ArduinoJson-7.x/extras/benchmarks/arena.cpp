@@ -0,0 +1,57 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <string>
+
+#include "Benchmark.hpp"
+
+static const char request[] =
+    "{\"model\":\"gemini-2.0-flash\",\"contents\":[{\"role\":\"user\","
+    "\"parts\":[{\"text\":\"What is the temperature in the kitchen?\"}]}],"
+    "\"generationConfig\":{\"temperature\":0.7,\"maxOutputTokens\":256},"
+    "\"sensors\":[{\"id\":\"kitchen\",\"temperature\":21.5,\"humidity\":40},"
+    "{\"id\":\"garage\",\"temperature\":12.25,\"humidity\":70},"
+    "{\"id\":\"bedroom\",\"temperature\":19,\"humidity\":45}]}";
+
+// Like a server: parses a request, then builds and sends a response
+static size_t handleRequest(Allocator* allocator) {
+  JsonDocument req(allocator);
+  deserializeJson(req, request);
+
+  JsonDocument res(allocator);
+  res["model"] = req["model"];
+  JsonObject candidate = res["candidates"].add<JsonObject>();
+  candidate["role"] = std::string("model");
+  JsonArray readings = candidate["readings"].to<JsonArray>();
+  for (JsonObject sensor : req["sensors"].as<JsonArray>()) {
+    JsonObject reading = readings.add<JsonObject>();
+    reading["id"] = sensor["id"].as<std::string>();
+    reading["temperature"] = sensor["temperature"];
+  }
+
+  std::string output;
+  serializeJson(res, output);
+  return output.size();
+}
+
+int main() {
+  const int n = 1000;
+  ArenaAllocator arena;
+
+  benchmark("1000 requests, default allocator", [&]() {
+    for (int i = 0; i < n; i++)
+      handleRequest(detail::DefaultAllocator::instance());
+  });
+
+  benchmark("1000 requests, arena", [&]() {
+    for (int i = 0; i < n; i++) {
+      handleRequest(&arena);
+      arena.reset();
+    }
+  });
+
+  printf("arena capacity: %zu bytes\n", arena.capacity());
+}
@@ -0,0 +1,45 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include "Benchmark.hpp"
+
+int main() {
+  printf("Collection cache size: %d\n", ARDUINOJSON_COLLECTION_CACHE_SIZE);
+
+  const int sizes[] = {1000, 10000, 30000};
+  for (int n : sizes) {
+    JsonDocument doc;
+    JsonArray array = doc.to<JsonArray>();
+    for (int i = 0; i < n; i++)
+      array.add(i);
+    char name[64];
+
+    snprintf(name, sizeof(name), "size() (%d elements)", n);
+    benchmark(name, [&]() {
+      if (array.size() != size_t(n))
+        printf("unexpected size\n");
+    });
+
+    snprintf(name, sizeof(name), "array[i] loop (%d elements)", n);
+    benchmark(name, [&]() {
+      long sum = 0;
+      for (size_t i = 0; i < array.size(); i++)
+        sum += array[i].as<long>();
+      if (sum != long(n) * (n - 1) / 2)
+        printf("unexpected sum: %ld\n", sum);
+    });
+
+    snprintf(name, sizeof(name), "array[i] = i loop (%d elements)", n);
+    JsonDocument doc2;
+    benchmark(name, [&]() {
+      JsonArray other = doc2.to<JsonArray>();
+      for (int i = 0; i < n; i++)
+        other[size_t(i)] = i;
+      if (other.size() != size_t(n))
+        printf("unexpected size\n");
+    });
+  }
+}
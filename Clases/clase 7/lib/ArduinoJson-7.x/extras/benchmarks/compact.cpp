@@ -0,0 +1,96 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <stdlib.h>
+
+#include "Benchmark.hpp"
+
+// Counts the bytes currently allocated
+class CountingAllocator : public ArduinoJson::Allocator {
+ public:
+  virtual ~CountingAllocator() {}
+
+  void* allocate(size_t size) override {
+    auto p = static_cast<size_t*>(malloc(sizeof(size_t) + size));
+    *p = size;
+    bytes_ += size;
+    return p + 1;
+  }
+
+  void deallocate(void* ptr) override {
+    if (!ptr)
+      return;
+    auto p = static_cast<size_t*>(ptr) - 1;
+    bytes_ -= *p;
+    free(p);
+  }
+
+  void* reallocate(void* ptr, size_t size) override {
+    auto p = static_cast<size_t*>(ptr) - 1;
+    bytes_ -= *p;
+    p = static_cast<size_t*>(realloc(p, sizeof(size_t) + size));
+    *p = size;
+    bytes_ += size;
+    return p + 1;
+  }
+
+  size_t bytes() const {
+    return bytes_;
+  }
+
+ private:
+  size_t bytes_ = 0;
+};
+
+static long sumValues(JsonArrayConst sensors) {
+  long sum = 0;
+  for (JsonObjectConst sensor : sensors)
+    for (JsonVariantConst value : sensor["values"].as<JsonArrayConst>())
+      sum += value.as<long>();
+  return sum;
+}
+
+int main() {
+  const int sensorCount = 2000;
+  const int valueCount = 50;
+
+  CountingAllocator allocator;
+  JsonDocument doc(&allocator);
+  JsonArray sensors = doc.to<JsonArray>();
+  for (int i = 0; i < sensorCount; i++)
+    sensors.add<JsonObject>()["values"].to<JsonArray>();
+
+  // Append the values round-robin, like a logger would, so that the slots of
+  // each array are scattered, then remove every other value
+  for (int j = 0; j < valueCount; j++)
+    for (JsonObject sensor : sensors)
+      sensor["values"].add(j);
+  for (JsonObject sensor : sensors) {
+    JsonArray values = sensor["values"];
+    for (size_t i = 0; i < values.size(); i++)
+      values.remove(i);
+  }
+  doc.shrinkToFit();
+  long expected = sumValues(sensors);
+
+  printf("Before compact(): %zu bytes\n", allocator.bytes());
+  benchmark("iterate (fragmented)", [&]() {
+    if (sumValues(sensors) != expected)
+      printf("unexpected sum\n");
+  });
+
+  using clock = std::chrono::steady_clock;
+  auto start = clock::now();
+  bool ok = doc.compact();
+  auto elapsed = std::chrono::duration<double>(clock::now() - start).count();
+  printf("compact(): %s in %.3f ms\n", ok ? "ok" : "failed", elapsed * 1e3);
+
+  printf("After compact():  %zu bytes\n", allocator.bytes());
+  benchmark("iterate (compacted)", [&]() {
+    if (sumValues(sensors) != expected)
+      printf("unexpected sum\n");
+  });
+}
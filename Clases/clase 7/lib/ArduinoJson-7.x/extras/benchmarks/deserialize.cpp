@@ -0,0 +1,263 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+
+// Builds a 5-day forecast like the one in IntegrationTests/openweathermap.cpp
+static std::string makeForecast(int entries) {
+  static const char* descriptions[] = {"clear sky", "overcast clouds",
+                                       "light rain", "moderate rain"};
+  std::string json = "{\"cod\":\"200\",\"message\":0,\"cnt\":" +
+                     std::to_string(entries) + ",\"list\":[";
+  char buffer[1024];
+  for (int i = 0; i < entries; i++) {
+    snprintf(
+        buffer, sizeof(buffer),
+        "%s{\"dt\":%d,\"main\":{\"temp\":%d.%02d,\"feels_like\":-%d.%02d,"
+        "\"temp_min\":%d.%02d,\"temp_max\":%d.%02d,\"pressure\":%d,"
+        "\"sea_level\":%d,\"grnd_level\":%d,\"humidity\":%d,\"temp_kf\":-%d."
+        "%02d},\"weather\":[{\"id\":%d,\"main\":\"Clouds\",\"description\":"
+        "\"%s\",\"icon\":\"0%dd\"}],\"clouds\":{\"all\":%d},\"wind\":{"
+        "\"speed\":%d.%02d,\"deg\":%d},\"sys\":{\"pod\":\"d\"},\"dt_txt\":"
+        "\"2020-02-%02d %02d:00:00\"}",
+        i ? "," : "", 1581498000 + i * 10800, i % 15, i % 100, i % 7, i % 97,
+        i % 15, i % 89, i % 16, i % 83, 990 + i % 30, 990 + i % 30,
+        985 + i % 30, 40 + i % 60, i % 2, i % 79, 800 + i % 5,
+        descriptions[i % 4], i % 5, i % 101, i % 13, i % 71, i % 360,
+        12 + i / 8, (i % 8) * 3);
+    json += buffer;
+  }
+  json +=
+      "],\"city\":{\"id\":2643743,\"name\":\"London\",\"coord\":{\"lat\":51."
+      "5085,\"lon\":-0.1257},\"country\":\"GB\",\"population\":1000000,"
+      "\"timezone\":0,\"sunrise\":1581492085,\"sunset\":1581527294}}";
+  return json;
+}
+
+// Builds a chat completion response with a long text, like an LLM would send
+static std::string makeCompletion(size_t textLength) {
+  static const char* sentence =
+      "The quick brown fox jumps over the lazy dog, then it says \\\"hi\\\". ";
+  std::string text;
+  while (text.size() < textLength) {
+    text += sentence;
+    if (text.size() % 5 == 0)
+      text += "\\n\\n";
+  }
+  return "{\"id\":\"chatcmpl-123\",\"object\":\"chat.completion\","
+         "\"choices\":[{\"index\":0,\"message\":{\"role\":\"assistant\",\"content\":\"" +
+         text + "\"},\"finish_reason\":\"stop\"}]}";
+}
+
+// Builds an array of numbers, like a data logger would send: timestamps,
+// coordinates, and measurements printed with all their digits
+static std::string makeNumbers(int count) {
+  std::string json = "[";
+  char buffer[128];
+  for (int i = 0; i < count; i++) {
+    snprintf(buffer, sizeof(buffer), "%s[%d,%.6f,%.6f,%.17g,%d.%02d]",
+             i ? "," : "", 1581498000 + i * 60, 48.858 + i * 1e-5,
+             2.2945 - i * 3e-6, 1.0 / (i + 3), i % 40, i % 100);
+    json += buffer;
+  }
+  return json + "]";
+}
+
+int main() {
+  auto input = makeForecast(40);
+  printf("Input size: %zu bytes\n", input.size());
+
+  JsonDocument doc;
+  auto check = [&](DeserializationError err) {
+    if (err || doc["list"].size() != 40)
+      printf("unexpected result: %s\n", err.c_str());
+  };
+
+  benchmark("deserializeJson(const char*)",
+            [&]() { check(deserializeJson(doc, input.c_str())); });
+
+  benchmark("deserializeJson(const char*, size_t)", [&]() {
+    check(deserializeJson(doc, input.c_str(), input.size()));
+  });
+
+  // the input is destroyed, so each run parses a fresh copy
+  std::vector<char> writable;
+  benchmark("deserializeJsonInPlace(char*)", [&]() {
+    writable.assign(input.begin(), input.end());
+    check(deserializeJsonInPlace(doc, writable.data(), writable.size()));
+  });
+
+  benchmark("deserializeJson(const std::string&)",
+            [&]() { check(deserializeJson(doc, input)); });
+
+  benchmark("deserializeJson(std::istream&)", [&]() {
+    std::istringstream stream(input);
+    check(deserializeJson(doc, stream));
+  });
+
+  JsonDocument filter;
+  filter["list"][0]["dt"] = true;
+  filter["list"][0]["main"]["temp"] = true;
+  filter["list"][0]["weather"][0]["description"] = true;
+  benchmark("deserializeJson(const char*, Filter)", [&]() {
+    check(deserializeJson(doc, input.c_str(),
+                          DeserializationOption::Filter(filter)));
+  });
+
+  JsonDocument rejectAll;
+  rejectAll.set(false);
+  benchmark("deserializeJson(const char*, skip all)", [&]() {
+    deserializeJson(doc, input.c_str(),
+                    DeserializationOption::Filter(rejectAll));
+  });
+
+  auto completion = makeCompletion(16000);
+  printf("Input size: %zu bytes\n", completion.size());
+
+  benchmark("deserializeJson(completion)", [&]() {
+    deserializeJson(doc, completion);
+    if (doc["choices"][0]["finish_reason"] != "stop")
+      printf("unexpected result\n");
+  });
+
+  benchmark("deserializeJsonInPlace(completion)", [&]() {
+    writable.assign(completion.begin(), completion.end());
+    deserializeJsonInPlace(doc, writable.data(), writable.size());
+    if (doc["choices"][0]["finish_reason"] != "stop")
+      printf("unexpected result\n");
+  });
+
+  JsonDocument skipContent;
+  skipContent["choices"][0]["finish_reason"] = true;
+  benchmark("deserializeJson(completion, Filter)", [&]() {
+    deserializeJson(doc, completion,
+                    DeserializationOption::Filter(skipContent));
+  });
+
+  const char* finishReason[] = {"/choices/0/finish_reason"};
+  benchmark("extractJson(completion)", [&]() {
+    extractJson(doc, completion, finishReason);
+    if (doc[0] != "stop")
+      printf("unexpected result\n");
+  });
+
+  auto numbers = makeNumbers(2000);
+  printf("Input size: %zu bytes\n", numbers.size());
+  auto checkNumbers = [&](DeserializationError err) {
+    if (err || doc.size() != 2000)
+      printf("unexpected result: %s\n", err.c_str());
+  };
+
+  benchmark("deserializeJson(numbers)",
+            [&]() { checkNumbers(deserializeJson(doc, numbers)); });
+
+  benchmark("deserializeJson(numbers, std::istream&)", [&]() {
+    std::istringstream stream(numbers);
+    checkNumbers(deserializeJson(doc, stream));
+  });
+
+  auto large = makeForecast(4000);
+  printf("Input size: %zu bytes\n", large.size());
+  auto checkLarge = [&](DeserializationError err) {
+    if (err || doc["list"].size() != 4000)
+      printf("unexpected result: %s\n", err.c_str());
+  };
+
+  benchmark("deserializeJson(large)",
+            [&]() { checkLarge(deserializeJson(doc, large)); });
+
+  benchmark("deserializeJson(large, Filter)", [&]() {
+    checkLarge(
+        deserializeJson(doc, large, DeserializationOption::Filter(filter)));
+  });
+
+  DeserializationOption::CompiledFilter compiledFilter(filter);
+  benchmark("deserializeJson(large, CompiledFilter)", [&]() {
+    checkLarge(deserializeJson(doc, large, compiledFilter));
+  });
+
+  // a filter with many keys, like one that lists the fields of a struct
+  JsonDocument wideFilter;
+  JsonObject entry = wideFilter["list"].add<JsonObject>();
+  for (const char* key : {"dt", "dt_txt", "visibility", "pop", "rain", "snow"})
+    entry[key] = true;
+  for (const char* key : {"temp", "feels_like", "temp_min", "temp_max",
+                          "pressure", "sea_level", "grnd_level", "humidity"})
+    entry["main"][key] = true;
+  for (const char* key : {"id", "main", "description"})
+    entry["weather"][0][key] = true;
+  entry["wind"]["speed"] = true;
+  entry["wind"]["gust"] = true;
+  benchmark("deserializeJson(large, wide, Filter)", [&]() {
+    checkLarge(
+        deserializeJson(doc, large, DeserializationOption::Filter(wideFilter)));
+  });
+
+  DeserializationOption::CompiledFilter compiledWideFilter(wideFilter);
+  benchmark("deserializeJson(large, wide, compiled)", [&]() {
+    checkLarge(deserializeJson(doc, large, compiledWideFilter));
+  });
+
+  const char* lastEntry[] = {"/list/3999/main/temp", "/city/name"};
+  benchmark("extractJson(large)", [&]() {
+    extractJson(doc, large, lastEntry);
+    if (doc[1] != "London")
+      printf("unexpected result\n");
+  });
+
+  // feeds the input as it would arrive from the network, one TCP segment at a
+  // time, instead of buffering it
+  benchmark("JsonStreamParser(large, 1460 B chunks)", [&]() {
+    JsonStreamParser parser(doc);
+    DeserializationError err;
+    for (size_t i = 0; i < large.size(); i += 1460)
+      err = parser.feed(large.data() + i,
+                        std::min<size_t>(1460, large.size() - i));
+    checkLarge(err);
+  });
+
+  // reads the same values as the filter, without building a document
+  auto readTemperatures = [](JsonReader<std::istream>& reader) {
+    size_t count = 0;
+    bool isTemp = false;
+    for (;;) {
+      switch (reader.next()) {
+        case JsonEvent::Key:
+          isTemp = reader.as<JsonString>() == "temp";
+          break;
+        case JsonEvent::Number:
+          count += isTemp;
+          break;
+        case JsonEvent::End:
+          if (count != 4000)
+            printf("unexpected result: %zu\n", count);
+          return;
+        case JsonEvent::Error:
+          printf("unexpected result: %s\n", reader.error().c_str());
+          return;
+        default:
+          break;
+      }
+    }
+  };
+
+  benchmark("deserializeJson(large, stream, Filter)", [&]() {
+    std::istringstream stream(large);
+    checkLarge(
+        deserializeJson(doc, stream, DeserializationOption::Filter(filter)));
+  });
+
+  benchmark("JsonReader(large, stream)", [&]() {
+    std::istringstream stream(large);
+    JsonReader<std::istream> reader(stream);
+    readTemperatures(reader);
+  });
+}
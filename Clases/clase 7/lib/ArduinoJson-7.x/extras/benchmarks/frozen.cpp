@@ -0,0 +1,76 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+
+// Looks up every key, then reads every element of the arrays by index
+template <typename TDocument>
+static long readAll(const TDocument& doc,
+                    const std::vector<std::string>& keys) {
+  long sum = 0;
+  for (auto& key : keys) {
+    JsonArrayConst values = doc[key];
+    for (size_t i = 0; i < values.size(); i++)
+      sum += values[i].template as<long>();
+  }
+  return sum;
+}
+
+// Reads the last element of each array, which is the worst case of a list
+template <typename TDocument>
+static long readLast(const TDocument& doc,
+                     const std::vector<std::string>& keys, size_t index) {
+  long sum = 0;
+  for (auto& key : keys)
+    sum += doc[key][index].template as<long>();
+  return sum;
+}
+
+int main() {
+  const int keyCount = 1000;
+  const int valueCount = 100;
+
+  std::vector<std::string> keys;
+  JsonDocument doc;
+  for (int i = 0; i < keyCount; i++) {
+    keys.push_back("setting" + std::to_string(i * 7919 % keyCount));
+    JsonArray values = doc[keys.back()].to<JsonArray>();
+    for (int j = 0; j < valueCount; j++)
+      values.add(j);
+  }
+  long expected = readAll(doc, keys);
+
+  using clock = std::chrono::steady_clock;
+  auto start = clock::now();
+  JsonFrozenDocument frozen(doc);
+  auto elapsed = std::chrono::duration<double>(clock::now() - start).count();
+  printf("JsonFrozenDocument(): %.3f ms\n", elapsed * 1e3);
+
+  benchmark("read all (JsonDocument)", [&]() {
+    if (readAll(doc, keys) != expected)
+      printf("unexpected sum\n");
+  });
+
+  benchmark("read all (JsonFrozenDocument)", [&]() {
+    if (readAll(frozen, keys) != expected)
+      printf("unexpected sum\n");
+  });
+
+  long expectedLast = long(keyCount) * (valueCount - 1);
+
+  benchmark("last element (JsonDocument)", [&]() {
+    if (readLast(doc, keys, valueCount - 1) != expectedLast)
+      printf("unexpected sum\n");
+  });
+
+  benchmark("last element (JsonFrozenDocument)", [&]() {
+    if (readLast(frozen, keys, valueCount - 1) != expectedLast)
+      printf("unexpected sum\n");
+  });
+}
@@ -0,0 +1,110 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <stdlib.h>
+#include <string>
+
+#include "Benchmark.hpp"
+
+// Counts the calls to the allocator and the bytes allocated
+class MeasuringAllocator : public Allocator {
+ public:
+  virtual ~MeasuringAllocator() {}
+
+  void* allocate(size_t n) override {
+    calls++;
+    auto p = static_cast<size_t*>(malloc(n + sizeof(size_t)));
+    *p = n;
+    add(n);
+    return p + 1;
+  }
+
+  void deallocate(void* p) override {
+    calls++;
+    auto block = static_cast<size_t*>(p) - 1;
+    current -= *block;
+    free(block);
+  }
+
+  void* reallocate(void* p, size_t n) override {
+    calls++;
+    auto block = static_cast<size_t*>(p) - 1;
+    current -= *block;
+    block = static_cast<size_t*>(realloc(block, n + sizeof(size_t)));
+    *block = n;
+    add(n);
+    return block + 1;
+  }
+
+  void reset() {
+    calls = 0;
+    total = 0;
+    peak = current;
+  }
+
+  size_t calls = 0;
+  size_t total = 0;  // bytes allocated since reset()
+  size_t current = 0;
+  size_t peak = 0;
+
+ private:
+  void add(size_t n) {
+    total += n;
+    current += n;
+    if (current > peak)
+      peak = current;
+  }
+};
+
+// A response of a chat API: the keys are the same in every message
+static std::string makeMessage(int n) {
+  std::string text = "Here is answer number " + std::to_string(n) + ".";
+  return "{\"candidates\":[{\"content\":{\"parts\":[{\"text\":\"" + text +
+         "\"}],\"role\":\"model\"},\"finishReason\":\"STOP\",\"index\":0,"
+         "\"safetyRatings\":[{\"category\":\"HARM_CATEGORY_HATE_SPEECH\","
+         "\"probability\":\"NEGLIGIBLE\"},{\"category\":"
+         "\"HARM_CATEGORY_HARASSMENT\",\"probability\":\"NEGLIGIBLE\"}]}],"
+         "\"usageMetadata\":{\"promptTokenCount\":" +
+         std::to_string(n % 100) +
+         ",\"candidatesTokenCount\":12,\"totalTokenCount\":" +
+         std::to_string(n % 100 + 12) + "},\"modelVersion\":\"chat-1.0\"}";
+}
+
+static void parseDocuments(const std::string messages[], int n,
+                           MeasuringAllocator& allocator,
+                           StringInternTable* table) {
+  for (int i = 0; i < n; i++) {
+    JsonDocument doc(table, &allocator);
+    deserializeJson(doc, messages[i % 100]);
+  }
+}
+
+static void run(const char* name, const std::string messages[], int n,
+                MeasuringAllocator& allocator, StringInternTable* table) {
+  benchmark(name, [&]() { parseDocuments(messages, n, allocator, table); });
+  allocator.reset();
+  parseDocuments(messages, n, allocator, table);
+  printf("  per document: %.1f allocator calls, %.0f bytes, peak %zu bytes\n",
+         double(allocator.calls) / n, double(allocator.total) / n,
+         allocator.peak);
+}
+
+int main() {
+  const int n = 10000;
+  std::string messages[100];
+  for (int i = 0; i < 100; i++)
+    messages[i] = makeMessage(i);
+
+  MeasuringAllocator allocator;
+  run("10000 documents", messages, n, allocator, nullptr);
+
+  MeasuringAllocator tableAllocator;
+  StringInternTable table(64, &tableAllocator);
+  run("10000 documents, StringInternTable", messages, n, allocator,
+      &table);
+  printf("  table: %zu strings, %zu bytes\n", table.size(),
+         tableAllocator.current);
+}
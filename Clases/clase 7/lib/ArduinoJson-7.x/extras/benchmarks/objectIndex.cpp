@@ -0,0 +1,60 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+
+// Builds an object with n members
+static std::string makeInput(const std::vector<std::string>& keys) {
+  std::string json = "{";
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (i)
+      json += ",";
+    json += "\"" + keys[i] + "\":" + std::to_string(i);
+  }
+  json += "}";
+  return json;
+}
+
+int main() {
+  printf("Object index threshold: %d\n", ARDUINOJSON_OBJECT_INDEX_THRESHOLD);
+
+  const int sizes[] = {1000, 10000, 30000};
+  for (int n : sizes) {
+    std::vector<std::string> keys;
+    for (int i = 0; i < n; i++)
+      keys.push_back("member" + std::to_string(i));
+    auto input = makeInput(keys);
+    JsonDocument doc;
+    char name[64];
+
+    snprintf(name, sizeof(name), "deserializeJson(%d members)", n);
+    benchmark(name, [&]() {
+      auto err = deserializeJson(doc, input);
+      if (err || doc.size() != size_t(n))
+        printf("unexpected result: %s\n", err.c_str());
+    });
+
+    snprintf(name, sizeof(name), "deserializeJson(%d members, unique)", n);
+    benchmark(name, [&]() {
+      auto err = deserializeJson(doc, input,
+                                 DeserializationOption::AssumeUniqueKeys());
+      if (err || doc.size() != size_t(n))
+        printf("unexpected result: %s\n", err.c_str());
+    });
+
+    snprintf(name, sizeof(name), "lookup all (%d members)", n);
+    benchmark(name, [&]() {
+      long sum = 0;
+      for (auto& key : keys)
+        sum += doc[key].as<long>();
+      if (sum != long(n) * (n - 1) / 2)
+        printf("unexpected sum: %ld\n", sum);
+    });
+  }
+}
@@ -0,0 +1,97 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include "Benchmark.hpp"
+
+// Counts the calls to the allocator and the peak of allocated bytes
+class MeasuringAllocator : public Allocator {
+ public:
+  virtual ~MeasuringAllocator() {}
+
+  void* allocate(size_t n) override {
+    calls++;
+    auto p = static_cast<size_t*>(malloc(n + sizeof(size_t)));
+    if (!p)
+      return nullptr;
+    *p = n;
+    add(n);
+    return p + 1;
+  }
+
+  void deallocate(void* ptr) override {
+    calls++;
+    auto p = static_cast<size_t*>(ptr) - 1;
+    current -= *p;
+    free(p);
+  }
+
+  void* reallocate(void* ptr, size_t n) override {
+    calls++;
+    auto p = static_cast<size_t*>(ptr) - 1;
+    current -= *p;
+    p = static_cast<size_t*>(realloc(p, n + sizeof(size_t)));
+    *p = n;
+    add(n);
+    return p + 1;
+  }
+
+  size_t calls = 0;
+  size_t current = 0;
+  size_t peak = 0;
+
+ private:
+  void add(size_t n) {
+    current += n;
+    if (current > peak)
+      peak = current;
+  }
+};
+
+int main() {
+  printf("Pool capacity: %d to %lu slots\n", ARDUINOJSON_POOL_CAPACITY,
+         static_cast<unsigned long>(ARDUINOJSON_MAX_POOL_CAPACITY));
+
+  const int n = 1000000;
+  std::string input = "[";
+  for (int i = 0; i < n; i++) {
+    if (i)
+      input += ',';
+    input += std::to_string(i % 1000);
+  }
+  input += "]";
+
+  MeasuringAllocator allocator;
+  JsonDocument doc(&allocator);
+
+  benchmark("deserializeJson() (1M elements)",
+            [&]() { deserializeJson(doc, input); });
+
+  allocator.calls = 0;
+  allocator.peak = allocator.current;
+  deserializeJson(doc, input);
+  printf("  allocator calls: %zu\n", allocator.calls);
+  printf("  peak memory:     %.1f MB\n", double(allocator.peak) / 1e6);
+  printf("  final memory:    %.1f MB\n", double(allocator.current) / 1e6);
+
+  benchmark("add() (1M elements)", [&]() {
+    JsonArray array = doc.to<JsonArray>();
+    for (int i = 0; i < n; i++)
+      array.add(i % 1000);
+  });
+
+  long sum = 0;
+  benchmark("iterate (1M elements)", [&]() {
+    sum = 0;
+    for (JsonVariant value : doc.as<JsonArray>())
+      sum += value.as<long>();
+  });
+  if (sum != 499500L * (n / 1000))
+    printf("unexpected sum: %ld\n", sum);
+}
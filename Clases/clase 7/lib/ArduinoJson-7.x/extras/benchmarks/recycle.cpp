@@ -0,0 +1,81 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <stdlib.h>
+#include <string>
+
+#include "Benchmark.hpp"
+
+// Counts the calls to the allocator
+class CountingAllocator : public Allocator {
+ public:
+  virtual ~CountingAllocator() {}
+
+  void* allocate(size_t n) override {
+    calls++;
+    return malloc(n);
+  }
+
+  void deallocate(void* p) override {
+    calls++;
+    free(p);
+  }
+
+  void* reallocate(void* p, size_t n) override {
+    calls++;
+    return realloc(p, n);
+  }
+
+  size_t calls = 0;
+};
+
+static std::string makeMessage(int n) {
+  std::string json = "{\"device\":\"thermostat-" + std::to_string(n % 10) +
+                     "\",\"readings\":[";
+  for (int i = 0; i < 50; i++) {
+    if (i)
+      json += ",";
+    json += "{\"sensor\":\"sensor-" + std::to_string(100 + i) +
+            "\",\"value\":" + std::to_string(i * 7 % 100) + ".5}";
+  }
+  json += "]}";
+  return json;
+}
+
+static void parseAndSerialize(JsonDocument& doc, const std::string messages[],
+                              int n) {
+  std::string output;
+  for (int i = 0; i < n; i++) {
+    deserializeJson(doc, messages[i % 10]);
+    output.clear();
+    serializeJson(doc, output);
+  }
+}
+
+int main() {
+  const int n = 1000;
+  std::string messages[10];
+  for (int i = 0; i < 10; i++)
+    messages[i] = makeMessage(i);
+
+  CountingAllocator allocator;
+  JsonDocument doc(&allocator);
+
+  benchmark("1000 messages",
+            [&]() { parseAndSerialize(doc, messages, n); });
+  allocator.calls = 0;
+  parseAndSerialize(doc, messages, n);
+  printf("  allocator calls per message: %.1f\n",
+         double(allocator.calls) / n);
+
+  doc.recycle();
+  benchmark("1000 messages, after recycle()",
+            [&]() { parseAndSerialize(doc, messages, n); });
+  allocator.calls = 0;
+  parseAndSerialize(doc, messages, n);
+  printf("  allocator calls per message: %.1f\n",
+         double(allocator.calls) / n);
+}
@@ -0,0 +1,61 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include "Benchmark.hpp"
+
+static void fill(JsonDocument& doc, int n) {
+  JsonArray array = doc.to<JsonArray>();
+  for (int i = 0; i < n; i++)
+    array.add(i);
+}
+
+static bool isOdd(JsonVariant value) {
+  return value.as<int>() % 2 != 0;
+}
+
+// Like telemetry samples that expire: the oldest half is removed
+static bool isOld(JsonVariant value) {
+  return value.as<int>() < 10000;
+}
+
+int main() {
+  const int n = 20000;
+  JsonDocument doc;
+
+  benchmark("remove(iterator) in a loop, every other", [&]() {
+    fill(doc, n);
+    JsonArray array = doc.as<JsonArray>();
+    for (JsonArray::iterator it = array.begin(); it != array.end(); ++it)
+      if (isOdd(*it))
+        array.remove(it);
+    if (array.size() != n / 2)
+      printf("unexpected size\n");
+  });
+
+  benchmark("removeIf(), every other", [&]() {
+    fill(doc, n);
+    if (doc.as<JsonArray>().removeIf(isOdd) != n / 2)
+      printf("unexpected count\n");
+  });
+
+  benchmark("remove(iterator) in a loop, first half", [&]() {
+    fill(doc, n);
+    JsonArray array = doc.as<JsonArray>();
+    for (JsonArray::iterator it = array.begin(); it != array.end(); ++it)
+      if (isOld(*it))
+        array.remove(it);
+    if (array.size() != n / 2)
+      printf("unexpected size\n");
+  });
+
+  benchmark("removeIf(), first half", [&]() {
+    fill(doc, n);
+    if (doc.as<JsonArray>().removeIf(isOld) != n / 2)
+      printf("unexpected count\n");
+  });
+
+  benchmark("fill only", [&]() { fill(doc, n); });
+}
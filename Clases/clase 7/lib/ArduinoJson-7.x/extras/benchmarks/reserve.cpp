@@ -0,0 +1,76 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <stdlib.h>
+#include <string>
+
+#include "Benchmark.hpp"
+
+// Counts the calls to the allocator
+class CountingAllocator : public Allocator {
+ public:
+  virtual ~CountingAllocator() {}
+
+  void* allocate(size_t n) override {
+    calls++;
+    return malloc(n);
+  }
+
+  void deallocate(void* p) override {
+    calls++;
+    free(p);
+  }
+
+  void* reallocate(void* p, size_t n) override {
+    calls++;
+    return realloc(p, n);
+  }
+
+  size_t calls = 0;
+};
+
+static std::string makeMessage(int count) {
+  std::string json = "{\"device\":\"gateway-42\",\"readings\":[";
+  for (int i = 0; i < count; i++) {
+    if (i)
+      json += ",";
+    json += "{\"sensor\":\"sensor-" + std::to_string(100000 + i) +
+            "\",\"value\":" + std::to_string(i * 7 % 100) +
+            ".5,\"note\":\"" + std::string(size_t(i % 50), 'n') + "\"}";
+  }
+  json += "]}";
+  return json;
+}
+
+// Parses the message into a new document, like a server that keeps each
+// request for a while
+static void parse(const std::string& json, bool reserve,
+                  CountingAllocator& allocator) {
+  JsonDocument doc(&allocator);
+  if (reserve) {
+    JsonDocumentSize size;
+    measureDeserializeJson(size, json);
+    doc.reserve(size.variantSlots, size.stringBytes);
+  }
+  deserializeJson(doc, json);
+}
+
+int main() {
+  for (int count : {100, 10000}) {
+    std::string json = makeMessage(count);
+    printf("%d readings (%zu bytes)\n", count, json.size());
+
+    for (bool reserve : {false, true}) {
+      CountingAllocator allocator;
+      benchmark(reserve ? "  measure + reserve() + deserializeJson()"
+                        : "  deserializeJson()",
+                [&]() { parse(json, reserve, allocator); });
+      allocator.calls = 0;
+      parse(json, reserve, allocator);
+      printf("    allocator calls per document: %zu\n", allocator.calls);
+    }
+  }
+}
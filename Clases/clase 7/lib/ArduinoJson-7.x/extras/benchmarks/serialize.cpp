@@ -0,0 +1,163 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <sstream>
+#include <string>
+
+#include "Benchmark.hpp"
+
+// Builds a prompt for a generative AI API: short keys, long text values
+static void makePrompt(JsonDocument& doc, int turns, size_t textLength) {
+  static const char* sentence =
+      "Summarize the sensor readings below and tell me if the \"greenhouse\" "
+      "needs watering.\n";
+  std::string text;
+  while (text.size() < textLength)
+    text += sentence;
+
+  JsonArray contents = doc["contents"].to<JsonArray>();
+  for (int i = 0; i < turns; i++) {
+    JsonObject content = contents.add<JsonObject>();
+    content["role"] = i % 2 ? "model" : "user";
+    content["parts"][0]["text"] = text;
+  }
+  doc["generationConfig"]["temperature"] = 0.7;
+  doc["generationConfig"]["maxOutputTokens"] = 1024;
+}
+
+// Builds a document with many short keys and short values
+static void makeReadings(JsonDocument& doc, int count) {
+  JsonArray readings = doc["readings"].to<JsonArray>();
+  for (int i = 0; i < count; i++) {
+    JsonObject reading = readings.add<JsonObject>();
+    reading["id"] = i;
+    reading["sensor"] = i % 2 ? "humidity" : "temperature";
+    reading["unit"] = i % 2 ? "%" : "C";
+    reading["ok"] = true;
+  }
+}
+
+// Writes the same content as makeReadings(), without a document
+template <typename TWriter>
+static void writeReadings(TWriter& writer, int count) {
+  writer.beginObject(1);
+  writer.key("readings");
+  writer.beginArray(size_t(count));
+  for (int i = 0; i < count; i++) {
+    writer.beginObject(4);
+    writer.key("id");
+    writer.value(i);
+    writer.key("sensor");
+    writer.value(i % 2 ? "humidity" : "temperature");
+    writer.key("unit");
+    writer.value(i % 2 ? "%" : "C");
+    writer.key("ok");
+    writer.value(true);
+    writer.endObject();
+  }
+  writer.endArray();
+  writer.endObject();
+}
+
+// Adapts JsonWriter to writeReadings(), which passes the sizes for
+// MsgPackWriter
+struct SizeIgnoringJsonWriter : JsonWriter<std::string> {
+  using JsonWriter<std::string>::JsonWriter;
+
+  void beginObject(size_t) {
+    JsonWriter<std::string>::beginObject();
+  }
+
+  void beginArray(size_t) {
+    JsonWriter<std::string>::beginArray();
+  }
+};
+
+// Builds a document with many timestamps and measurements
+static void makeSamples(JsonDocument& doc, int count) {
+  JsonArray samples = doc["samples"].to<JsonArray>();
+  for (int i = 0; i < count; i++) {
+    JsonObject sample = samples.add<JsonObject>();
+    sample["time"] = 1700000000L + 60L * i;
+    sample["temperature"] = 21.5 + 0.37 * i;
+    sample["pressure"] = 1013.25f - 0.11f * float(i);
+    sample["ratio"] = 1.0 / (i + 3);
+  }
+}
+
+int main() {
+  JsonDocument prompt;
+  makePrompt(prompt, 8, 700);
+  std::string output;
+  output.reserve(measureJson(prompt));
+  printf("Output size: %zu bytes\n", measureJson(prompt));
+
+  benchmark("serializeJson(prompt, std::string)",
+            [&]() { serializeJson(prompt, output); });
+
+  char buffer[8192];
+  benchmark("serializeJson(prompt, char*)",
+            [&]() { serializeJson(prompt, buffer, sizeof(buffer)); });
+
+  benchmark("serializeJson(prompt, std::ostream&)", [&]() {
+    std::ostringstream stream;
+    serializeJson(prompt, stream);
+  });
+
+  benchmark("measureJson(prompt)", [&]() { measureJson(prompt); });
+
+  JsonDocument readings;
+  makeReadings(readings, 100);
+  printf("Output size: %zu bytes\n", measureJson(readings));
+
+  benchmark("serializeJson(readings, std::string)",
+            [&]() { serializeJson(readings, output); });
+
+  benchmark("serializeJson(readings, char*)",
+            [&]() { serializeJson(readings, buffer, sizeof(buffer)); });
+
+  benchmark("serializeJson(readings, std::ostream&)", [&]() {
+    std::ostringstream stream;
+    serializeJson(readings, stream);
+  });
+
+  benchmark("serializeMsgPack(readings, std::string)",
+            [&]() { serializeMsgPack(readings, output); });
+
+  // The whole job for an outbound message: build, then serialize
+  benchmark("build + serializeJson(readings)", [&]() {
+    JsonDocument doc;
+    makeReadings(doc, 100);
+    output.clear();
+    serializeJson(doc, output);
+  });
+
+  benchmark("JsonWriter(readings)", [&]() {
+    output.clear();
+    SizeIgnoringJsonWriter writer(output);
+    writeReadings(writer, 100);
+  });
+
+  benchmark("build + serializeMsgPack(readings)", [&]() {
+    JsonDocument doc;
+    makeReadings(doc, 100);
+    output.clear();
+    serializeMsgPack(doc, output);
+  });
+
+  benchmark("MsgPackWriter(readings)", [&]() {
+    output.clear();
+    MsgPackWriter<std::string> writer(output);
+    writeReadings(writer, 100);
+  });
+
+  JsonDocument samples;
+  makeSamples(samples, 100);
+  printf("Output size: %zu bytes\n", measureJson(samples));
+
+  benchmark("serializeJson(samples, char*)",
+            [&]() { serializeJson(samples, buffer, sizeof(buffer)); });
+}
@@ -0,0 +1,38 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+
+#include <string>
+
+#include "Benchmark.hpp"
+
+// Builds an array of n distinct strings
+static std::string makeInput(int n) {
+  std::string json = "[";
+  char buffer[32];
+  for (int i = 0; i < n; i++) {
+    snprintf(buffer, sizeof(buffer), "%s\"value%d\"", i ? "," : "", i);
+    json += buffer;
+  }
+  json += "]";
+  return json;
+}
+
+int main() {
+  printf("String index threshold: %d\n", ARDUINOJSON_STRING_INDEX_THRESHOLD);
+
+  const int sizes[] = {10000, 30000, 100000};
+  for (int n : sizes) {
+    auto input = makeInput(n);
+    JsonDocument doc;
+    char name[64];
+    snprintf(name, sizeof(name), "deserializeJson(%d strings)", n);
+    benchmark(name, [&]() {
+      auto err = deserializeJson(doc, input);
+      if (err || doc.size() != size_t(n))
+        printf("unexpected result: %s\n", err.c_str());
+    });
+  }
+}
@@ -0,0 +1,112 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+// These tests mix indexing, size(), and modifications to make sure the cached
+// size and cursor stay in sync with the array in JsonArrayCacheTests
+TEST_CASE("JsonArray indexing") {
+  JsonDocument doc;
+  JsonArray array = doc.to<JsonArray>();
+  for (int i = 0; i < 100; i++)
+    array.add(i);
+
+  SECTION("forward") {
+    for (size_t i = 0; i < array.size(); i++)
+      REQUIRE(array[i] == i);
+    REQUIRE(array[100].isNull());
+  }
+
+  SECTION("backward") {
+    for (int i = 99; i >= 0; i--)
+      REQUIRE(array[size_t(i)] == i);
+  }
+
+  SECTION("random") {
+    REQUIRE(array[50] == 50);
+    REQUIRE(array[10] == 10);
+    REQUIRE(array[99] == 99);
+    REQUIRE(array[51] == 51);
+  }
+
+  SECTION("add() after indexing") {
+    REQUIRE(array[99] == 99);
+    REQUIRE(array.size() == 100);
+    array.add(100);
+    REQUIRE(array.size() == 101);
+    REQUIRE(array[100] == 100);
+  }
+
+  SECTION("assign past the end") {
+    REQUIRE(array.size() == 100);
+    array[102] = 102;
+    REQUIRE(array.size() == 103);
+    REQUIRE(array[100].isNull());
+    REQUIRE(array[101].isNull());
+    REQUIRE(array[102] == 102);
+  }
+
+  SECTION("remove() while indexing") {
+    REQUIRE(array[50] == 50);
+    array.remove(50);
+    REQUIRE(array.size() == 99);
+    REQUIRE(array[50] == 51);
+    array.remove(0);
+    REQUIRE(array.size() == 98);
+    REQUIRE(array[50] == 52);
+    REQUIRE(array[97] == 99);
+    REQUIRE(array[98].isNull());
+  }
+
+  SECTION("remove() with an iterator") {
+    REQUIRE(array[2] == 2);
+    auto it = array.begin();
+    ++it;
+    ++it;
+    array.remove(it);
+    REQUIRE(array.size() == 99);
+    REQUIRE(array[2] == 3);
+  }
+
+  SECTION("clear() then add()") {
+    REQUIRE(array[99] == 99);
+    array.clear();
+    REQUIRE(array.size() == 0);
+    REQUIRE(array[0].isNull());
+    array.add(42);
+    REQUIRE(array.size() == 1);
+    REQUIRE(array[0] == 42);
+  }
+
+  SECTION("several arrays at once") {
+    JsonArray others[3];
+    for (int j = 0; j < 3; j++) {
+      others[j] = array.add<JsonArray>();
+      for (int i = 0; i < 10; i++)
+        others[j].add(i * (j + 1));
+    }
+
+    for (size_t i = 0; i < 10; i++) {
+      for (int j = 0; j < 3; j++) {
+        REQUIRE(array[100 + size_t(j)][i] == int(i) * (j + 1));
+        REQUIRE(others[j].size() == 10);
+      }
+    }
+    REQUIRE(array.size() == 103);
+  }
+
+  SECTION("reuse the slot of a nested array") {
+    JsonArray nested = array.add<JsonArray>();
+    nested.add(1);
+    nested.add(2);
+    REQUIRE(nested.size() == 2);
+    REQUIRE(nested[1] == 2);
+
+    array.remove(100);
+    JsonArray other = array.add<JsonArray>();  // reuses the slot
+    REQUIRE(other.size() == 0);
+    REQUIRE(other[0].isNull());
+  }
+}
@@ -5,6 +5,8 @@
 #include <ArduinoJson.h>
 #include <catch.hpp>
 
+#include <string>
+
 #include "Allocators.hpp"
 
 TEST_CASE("JsonArray::remove()") {
@@ -85,6 +87,27 @@ TEST_CASE("JsonArray::remove()") {
     REQUIRE(array[1] == 3);
   }
 
+  SECTION("consecutive elements in a loop") {
+    array.add(4);
+    for (JsonArray::iterator it = array.begin(); it != array.end(); ++it) {
+      if (*it == 2 || *it == 3)
+        array.remove(it);
+    }
+
+    REQUIRE(2 == array.size());
+    REQUIRE(array[0] == 1);
+    REQUIRE(array[1] == 4);
+  }
+
+  SECTION("all elements in a loop") {
+    for (JsonArray::iterator it = array.begin(); it != array.end(); ++it)
+      array.remove(it);
+
+    REQUIRE(0 == array.size());
+    array.add(5);
+    REQUIRE(doc.as<std::string>() == "[5]");
+  }
+
   SECTION("remove by index on unbound reference") {
     JsonArray unboundArray;
     unboundArray.remove(20);
@@ -0,0 +1,98 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+
+TEST_CASE("JsonArray::removeIf()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+  JsonArray array = doc.to<JsonArray>();
+  for (int i = 1; i <= 6; i++)
+    array.add(i);
+
+  SECTION("removes the matching elements") {
+    size_t n = array.removeIf([](JsonVariant v) { return v.as<int>() % 2; });
+
+    REQUIRE(n == 3);
+    REQUIRE(doc.as<std::string>() == "[2,4,6]");
+    REQUIRE(array.size() == 3);
+    REQUIRE(array[2] == 6);
+  }
+
+  SECTION("consecutive elements, at both ends") {
+    size_t n = array.removeIf([](JsonVariant v) {
+      return v.as<int>() <= 2 || v.as<int>() >= 5;
+    });
+
+    REQUIRE(n == 4);
+    REQUIRE(doc.as<std::string>() == "[3,4]");
+  }
+
+  SECTION("all elements") {
+    REQUIRE(array.removeIf([](JsonVariant) { return true; }) == 6);
+
+    REQUIRE(array.size() == 0);
+    array.add(7);
+    REQUIRE(doc.as<std::string>() == "[7]");
+  }
+
+  SECTION("no element") {
+    REQUIRE(array.removeIf([](JsonVariant) { return false; }) == 0);
+
+    REQUIRE(doc.as<std::string>() == "[1,2,3,4,5,6]");
+  }
+
+  SECTION("the array can grow again") {
+    array.removeIf([](JsonVariant v) { return v.as<int>() > 3; });
+    array.add(8);
+
+    REQUIRE(doc.as<std::string>() == "[1,2,3,8]");
+  }
+
+  SECTION("after size() and subscript, which use the cache") {
+    REQUIRE(array.size() == 6);
+    REQUIRE(array[4] == 5);
+
+    array.removeIf([](JsonVariant v) { return v.as<int>() < 5; });
+
+    REQUIRE(array.size() == 2);
+    REQUIRE(array[0] == 5);
+    REQUIRE(array[1] == 6);
+  }
+
+  SECTION("releases the strings") {
+    doc.clear();
+    array = doc.to<JsonArray>();
+    array.add(std::string("hello"));
+    array.add(std::string("world"));
+    spy.clearLog();
+
+    array.removeIf([](JsonVariant v) { return v == "hello"; });
+
+    REQUIRE(doc.as<std::string>() == "[\"world\"]");
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofString("hello")),
+                         });
+  }
+
+  SECTION("the removed slots are reused") {
+    array.removeIf([](JsonVariant v) { return v.as<int>() < 4; });
+    spy.clearLog();
+
+    for (int i = 0; i < 3; i++)
+      array.add(i);
+
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("unbound") {
+    JsonArray unbound;
+    REQUIRE(unbound.removeIf([](JsonVariant) { return true; }) == 0);
+  }
+}
@@ -0,0 +1,87 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+using DeserializationOption::AssumeUniqueKeys;
+using DeserializationOption::Filter;
+using DeserializationOption::NestingLimit;
+
+TEST_CASE("deserializeJson(..., AssumeUniqueKeys)") {
+  JsonDocument doc;
+
+  SECTION("unique keys") {
+    auto err = deserializeJson(doc, "{\"a\":1,\"b\":{\"c\":2,\"d\":3}}",
+                               AssumeUniqueKeys());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1,\"b\":{\"c\":2,\"d\":3}}");
+  }
+
+  SECTION("keeps duplicate keys") {
+    auto err = deserializeJson(doc, "{\"a\":1,\"a\":2}", AssumeUniqueKeys());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.size() == 2);
+    REQUIRE(doc["a"] == 1);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1,\"a\":2}");
+  }
+
+  SECTION("without the option, the last duplicate wins") {
+    auto err = deserializeJson(doc, "{\"a\":1,\"a\":2}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":2}");
+  }
+}
+
+TEST_CASE("Overloads with AssumeUniqueKeys") {
+  JsonDocument doc;
+  JsonDocument filter;
+  filter["a"] = true;
+  const char* input = "{\"a\":[1],\"b\":2}";
+
+  SECTION("const char*, AssumeUniqueKeys, NestingLimit") {
+    auto err = deserializeJson(doc, input, AssumeUniqueKeys(), NestingLimit(1));
+    REQUIRE(err == DeserializationError::TooDeep);
+  }
+
+  SECTION("const char*, NestingLimit, AssumeUniqueKeys") {
+    auto err = deserializeJson(doc, input, NestingLimit(1), AssumeUniqueKeys());
+    REQUIRE(err == DeserializationError::TooDeep);
+  }
+
+  SECTION("const char*, Filter, AssumeUniqueKeys") {
+    deserializeJson(doc, input, Filter(filter), AssumeUniqueKeys());
+    REQUIRE(doc.as<std::string>() == "{\"a\":[1]}");
+  }
+
+  SECTION("const char*, AssumeUniqueKeys, Filter") {
+    deserializeJson(doc, input, AssumeUniqueKeys(), Filter(filter));
+    REQUIRE(doc.as<std::string>() == "{\"a\":[1]}");
+  }
+
+  SECTION("const char*, size_t, Filter, NestingLimit, AssumeUniqueKeys") {
+    auto err = deserializeJson(doc, input, 15, Filter(filter), NestingLimit(1),
+                               AssumeUniqueKeys());
+    REQUIRE(err == DeserializationError::TooDeep);
+  }
+
+  SECTION("const std::string&, AssumeUniqueKeys, NestingLimit, Filter") {
+    auto err = deserializeJson(doc, std::string(input), AssumeUniqueKeys(),
+                               NestingLimit(2), Filter(filter));
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":[1]}");
+  }
+
+  SECTION("std::istream&, AssumeUniqueKeys") {
+    std::stringstream s(input);
+    deserializeJson(doc, s, AssumeUniqueKeys());
+    REQUIRE(doc.as<std::string>() == "{\"a\":[1],\"b\":2}");
+  }
+}
@@ -0,0 +1,192 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+#include "Allocators.hpp"
+
+static const char* const response =
+    "{\"candidates\":[{\"content\":{\"parts\":[{\"text\":\"Hello!\"},"
+    "{\"text\":\"Second part\"}],\"role\":\"model\"},\"finishReason\":"
+    "\"STOP\",\"safetyRatings\":[{\"category\":\"HARM\",\"probability\":"
+    "\"NEGLIGIBLE\"}]}],\"usageMetadata\":{\"promptTokenCount\":12,"
+    "\"totalTokenCount\":20}}";
+
+static std::string toJson(const JsonDocument& doc) {
+  std::string json;
+  serializeJson(doc, json);
+  return json;
+}
+
+TEST_CASE("extractJson()") {
+  JsonDocument doc;
+
+  SECTION("one pointer") {
+    const char* pointers[] = {"/candidates/0/content/parts/0/text"};
+    REQUIRE(extractJson(doc, response, pointers) == DeserializationError::Ok);
+    REQUIRE(toJson(doc) == "[\"Hello!\"]");
+  }
+
+  SECTION("several pointers") {
+    const char* pointers[] = {
+        "/usageMetadata/totalTokenCount",
+        "/candidates/0/content/parts/1/text",
+        "/candidates/0/finishReason",
+    };
+    REQUIRE(extractJson(doc, response, pointers) == DeserializationError::Ok);
+    REQUIRE(toJson(doc) == "[20,\"Second part\",\"STOP\"]");
+  }
+
+  SECTION("the leading slash is optional") {
+    const char* pointers[] = {"candidates/0/content/role"};
+    REQUIRE(extractJson(doc, response, pointers) == DeserializationError::Ok);
+    REQUIRE(toJson(doc) == "[\"model\"]");
+  }
+
+  SECTION("objects and arrays") {
+    const char* pointers[] = {"/usageMetadata", "/candidates/0/safetyRatings"};
+    REQUIRE(extractJson(doc, response, pointers) == DeserializationError::Ok);
+    REQUIRE(toJson(doc) ==
+            "[{\"promptTokenCount\":12,\"totalTokenCount\":20},"
+            "[{\"category\":\"HARM\",\"probability\":\"NEGLIGIBLE\"}]]");
+  }
+
+  SECTION("the whole document") {
+    const char* pointers[] = {""};
+    REQUIRE(extractJson(doc, "[1,2]", pointers) == DeserializationError::Ok);
+    REQUIRE(toJson(doc) == "[[1,2]]");
+  }
+
+  SECTION("missing values are null") {
+    const char* pointers[] = {
+        "/candidates/1/content",  // index out of range
+        "/candidates/0/missing",  // no such key
+        "/usageMetadata/totalTokenCount/x",  // not a container
+        nullptr,
+        "/usageMetadata/promptTokenCount",
+    };
+    REQUIRE(extractJson(doc, response, pointers) == DeserializationError::Ok);
+    REQUIRE(toJson(doc) == "[null,null,null,null,12]");
+  }
+
+  SECTION("a pointer inside another") {
+    const char* pointers[] = {
+        "/a/b/c",
+        "/a",
+        "/a/b/c",
+        "/a/d/0",
+    };
+    REQUIRE(extractJson(doc, "{\"a\":{\"b\":{\"c\":1},\"d\":[true]}}",
+                        pointers) == DeserializationError::Ok);
+    REQUIRE(toJson(doc) == "[1,{\"b\":{\"c\":1},\"d\":[true]},1,true]");
+  }
+
+  SECTION("escaped tokens") {
+    const char* pointers[] = {"/a~1b", "/m~0n", "/~01", "/", "/x~2"};
+    REQUIRE(extractJson(doc,
+                        "{\"a/b\":1,\"m~n\":2,\"~1\":3,\"\":4,\"x~2\":5}",
+                        pointers) == DeserializationError::Ok);
+    REQUIRE(toJson(doc) == "[1,2,3,4,null]");
+  }
+
+  SECTION("array indexes") {
+    const char* pointers[] = {"/0", "/10", "/01", "/-", "/1a", "/"};
+    REQUIRE(extractJson(doc, "[0,1,2,3,4,5,6,7,8,9,10]", pointers) ==
+            DeserializationError::Ok);
+    REQUIRE(toJson(doc) == "[0,10,null,null,null,null]");
+  }
+
+  SECTION("the last duplicate key wins") {
+    const char* pointers[] = {"/a"};
+    REQUIRE(extractJson(doc, "{\"a\":1,\"b\":2,\"a\":3}", pointers) ==
+            DeserializationError::Ok);
+    REQUIRE(toJson(doc) == "[3]");
+  }
+
+  SECTION("replaces the content of the document") {
+    doc["hello"] = "world";
+    const char* pointers[] = {"/a"};
+    REQUIRE(extractJson(doc, "{}", pointers) == DeserializationError::Ok);
+    REQUIRE(toJson(doc) == "[null]");
+  }
+
+  SECTION("std::istream") {
+    std::istringstream input(response);
+    const char* pointers[] = {"/candidates/0/content/parts/0/text"};
+    REQUIRE(extractJson(doc, input, pointers) == DeserializationError::Ok);
+    REQUIRE(toJson(doc) == "[\"Hello!\"]");
+  }
+
+  SECTION("char* and size") {
+    const char* pointers[] = {"/0"};
+    REQUIRE(extractJson(doc, "[1]garbage", 3, pointers) ==
+            DeserializationError::Ok);
+    REQUIRE(toJson(doc) == "[1]");
+  }
+
+  SECTION("errors") {
+    const char* pointers[] = {"/a"};
+
+    SECTION("in a skipped value") {
+      REQUIRE(extractJson(doc, "{\"b\":[1,}", pointers) ==
+              DeserializationError::InvalidInput);
+    }
+
+    SECTION("after the extracted value") {
+      REQUIRE(extractJson(doc, "{\"a\":1,\"b\":", pointers) ==
+              DeserializationError::IncompleteInput);
+    }
+
+    SECTION("EmptyInput") {
+      REQUIRE(extractJson(doc, "", pointers) ==
+              DeserializationError::EmptyInput);
+    }
+
+    SECTION("TooDeep") {
+      REQUIRE(extractJson(doc, "{\"b\":[[1]]}", pointers,
+                          DeserializationOption::NestingLimit(2)) ==
+              DeserializationError::TooDeep);
+      REQUIRE(extractJson(doc, "{\"b\":[1]}", pointers,
+                          DeserializationOption::NestingLimit(2)) ==
+              DeserializationError::Ok);
+    }
+  }
+}
+
+TEST_CASE("extractJson() memory usage") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("only the extracted values are allocated") {
+    std::string input = "{\"skipped\":[";
+    for (int i = 0; i < 100; i++)
+      input += "{\"a long key\":\"a long string that is skipped\",\"n\":42},";
+    input += "{}],\"text\":\"hello\"}";
+    const char* pointers[] = {"/text"};
+
+    REQUIRE(extractJson(doc, input, pointers) == DeserializationError::Ok);
+
+    REQUIRE(toJson(doc) == "[\"hello\"]");
+    REQUIRE(spy.log() ==
+            AllocatorLog{
+                Allocate(sizeofPool()),
+                Allocate(sizeofStringBuffer()),  // the keys
+                Reallocate(sizeofStringBuffer(), sizeofString("hello")),
+                Reallocate(sizeofPool(), sizeofPool(1)),
+            });
+  }
+
+  SECTION("NoMemory") {
+    KillswitchAllocator killswitch;
+    JsonDocument doc2(&killswitch);
+    killswitch.on();
+    const char* pointers[] = {"/a"};
+    REQUIRE(extractJson(doc2, "{\"a\":1}", pointers) ==
+            DeserializationError::NoMemory);
+  }
+}
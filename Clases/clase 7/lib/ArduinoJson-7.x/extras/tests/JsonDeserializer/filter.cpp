@@ -721,6 +721,21 @@ TEST_CASE("Filtering") {
 
       doc.shrinkToFit();
       CHECK(spy.allocatedBytes() == tc.memoryUsage);
+
+      // same result with a compiled filter
+      SpyingAllocator compiledSpy;
+      JsonDocument compiledDoc(&compiledSpy);
+      DeserializationOption::CompiledFilter compiled(filter);
+
+      CHECK(deserializeJson(
+                compiledDoc, tc.input, compiled,
+                DeserializationOption::NestingLimit(tc.nestingLimit)) ==
+            tc.error);
+
+      CHECK(compiledDoc.as<std::string>() == tc.output);
+
+      compiledDoc.shrinkToFit();
+      CHECK(compiledSpy.allocatedBytes() == tc.memoryUsage);
     }
   }
 }
@@ -829,3 +844,108 @@ TEST_CASE("shrink filter") {
                            Reallocate(sizeofPool(), sizeofObject(1)),
                        });
 }
+
+TEST_CASE("CompiledFilter") {
+  JsonDocument doc;
+
+  SECTION("can be reused after the filter document is destroyed") {
+    JsonDocument* filter = new JsonDocument;
+    (*filter)["list"][0]["dt"] = true;
+    (*filter)["list"][0]["main"]["temp"] = true;
+    DeserializationOption::CompiledFilter compiled(*filter);
+    delete filter;
+
+    for (int i = 0; i < 2; i++) {
+      REQUIRE(deserializeJson(doc,
+                              "{\"cod\":200,\"list\":[{\"dt\":1,\"main\":"
+                              "{\"temp\":2,\"humidity\":3}},{\"dt\":4}]}",
+                              compiled) == DeserializationError::Ok);
+      REQUIRE(doc.as<std::string>() ==
+              "{\"list\":[{\"dt\":1,\"main\":{\"temp\":2}},{\"dt\":4}]}");
+    }
+  }
+
+  SECTION("many keys") {
+    JsonDocument filter;
+    for (int i = 0; i < 50; i += 2)
+      filter["key" + std::to_string(i)] = true;
+    DeserializationOption::CompiledFilter compiled(filter);
+
+    std::string input = "{";
+    for (int i = 0; i < 50; i++)
+      input += "\"key" + std::to_string(i) + "\":" + std::to_string(i) + ",";
+    input.back() = '}';
+
+    JsonDocument expected;
+    deserializeJson(expected, input, DeserializationOption::Filter(filter));
+    REQUIRE(deserializeJson(doc, input, compiled) == DeserializationError::Ok);
+    REQUIRE(doc == expected);
+    REQUIRE(doc.size() == 25);
+  }
+
+  SECTION("MessagePack") {
+    JsonDocument filter;
+    filter["b"] = true;
+    DeserializationOption::CompiledFilter compiled(filter);
+
+    REQUIRE(deserializeMsgPack(doc, "\x82\xA1"
+                                    "a\x01\xA1"
+                                    "b\x02",
+                               compiled) == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"b\":2}");
+  }
+
+  SECTION("after NestingLimit") {
+    JsonDocument filter;
+    filter["a"] = true;
+    DeserializationOption::CompiledFilter compiled(filter);
+
+    REQUIRE(deserializeJson(doc, "{\"a\":[1]}",
+                            DeserializationOption::NestingLimit(1),
+                            compiled) == DeserializationError::TooDeep);
+  }
+
+  SECTION("can be moved") {
+    JsonDocument filter;
+    filter["a"] = true;
+    DeserializationOption::CompiledFilter compiled(filter);
+    DeserializationOption::CompiledFilter moved(std::move(compiled));
+
+    REQUIRE(deserializeJson(doc, "{\"a\":1,\"b\":2}", moved) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1}");
+  }
+
+  SECTION("uses the allocator") {
+    SpyingAllocator spy;
+    JsonDocument filter;
+    filter["a"] = true;
+
+    // deny, allow all, and the root
+    size_t size = 3 * sizeof(ArduinoJson::detail::CompiledFilterNode) +
+                  sizeof(ArduinoJson::detail::CompiledFilterMember) + 1;
+
+    {
+      DeserializationOption::CompiledFilter compiled(filter, &spy);
+      REQUIRE(compiled.overflowed() == false);
+    }
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(size),
+                             Deallocate(size),
+                         });
+  }
+
+  SECTION("overflowed") {
+    KillswitchAllocator killswitch;
+    killswitch.on();
+    JsonDocument filter;
+    filter["a"] = true;
+    DeserializationOption::CompiledFilter compiled(filter, &killswitch);
+
+    REQUIRE(compiled.overflowed() == true);
+    REQUIRE(deserializeJson(doc, "{\"a\":1}", compiled) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.isNull());
+  }
+}
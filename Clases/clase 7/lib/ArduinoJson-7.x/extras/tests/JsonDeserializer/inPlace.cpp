@@ -0,0 +1,152 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+#include <vector>
+
+#include "Allocators.hpp"
+
+using DeserializationOption::Filter;
+
+static bool pointsInto(const char* p, const std::vector<char>& buffer) {
+  return p >= buffer.data() && p < buffer.data() + buffer.size();
+}
+
+static std::vector<char> makeBuffer(const char* json) {
+  return std::vector<char>(json, json + strlen(json) + 1);
+}
+
+static const char* const inputs[] = {
+    "{\"hello\":\"world\",\"nested\":{\"array\":[\"one\",\"two\",\"three\"]}}",
+    "[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\",\"escaped\\tstring\"]",
+    "[\"\\u00e9\\u2665\\uD83D\\uDE00\",\"\\u0041BCD\"]",
+    "{\"a\":1,\"a\":\"second value\"}",
+    "{unquoted_key:'single quoted',other:\"double quoted\"}",
+    "[\"a\",\"ab\",\"abc\",\"abcd\",\"\"]",
+    "[\"NUL\\u0000inside\"]",
+    "\"root string\"",
+    "[\"unterminated",
+    "{\"a\":}",
+};
+
+TEST_CASE("deserializeJsonInPlace() gives the same result as deserializeJson()") {
+  SECTION("no option") {
+    for (auto input : inputs) {
+      CAPTURE(input);
+      std::vector<char> buffer = makeBuffer(input);
+      JsonDocument expected, actual;
+      auto expectedErr = deserializeJson(expected, input);
+      auto actualErr = deserializeJsonInPlace(actual, buffer.data());
+      REQUIRE(actualErr == expectedErr);
+      REQUIRE(actual == expected);
+    }
+  }
+
+  SECTION("size") {
+    for (auto input : inputs) {
+      CAPTURE(input);
+      std::vector<char> buffer = makeBuffer(input);
+      JsonDocument expected, actual;
+      auto expectedErr = deserializeJson(expected, input, strlen(input) - 1);
+      auto actualErr =
+          deserializeJsonInPlace(actual, buffer.data(), strlen(input) - 1);
+      REQUIRE(actualErr == expectedErr);
+      REQUIRE(actual == expected);
+    }
+  }
+}
+
+TEST_CASE("deserializeJsonInPlace()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("strings point into the input") {
+    std::vector<char> buffer =
+        makeBuffer("{\"hello\":\"world\",\"list\":[\"one\\ttwo\"]}");
+
+    auto err = deserializeJsonInPlace(doc, buffer.data());
+
+    REQUIRE(err == DeserializationError::Ok);
+    JsonObject obj = doc.as<JsonObject>();
+    JsonPair pair = *obj.begin();
+    REQUIRE(pair.key() == "hello");
+    REQUIRE(pointsInto(pair.key().c_str(), buffer));
+    REQUIRE(doc["hello"] == "world");
+    REQUIRE(pointsInto(doc["hello"].as<const char*>(), buffer));
+    REQUIRE(doc["list"][0] == "one\ttwo");
+    REQUIRE(pointsInto(doc["list"][0].as<const char*>(), buffer));
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Reallocate(sizeofPool(), sizeofPool(5)),
+                         });
+  }
+
+  SECTION("tiny strings are stored in the variants") {
+    std::vector<char> buffer = makeBuffer("[\"abc\"]");
+
+    auto err = deserializeJsonInPlace(doc, buffer.data());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "abc");
+    REQUIRE_FALSE(pointsInto(doc[0].as<const char*>(), buffer));
+  }
+
+  SECTION("strings with a NUL are copied") {
+    std::vector<char> buffer = makeBuffer("[\"hello\\u0000world\"]");
+
+    auto err = deserializeJsonInPlace(doc, buffer.data());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == std::string("hello\0world", 11));
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofString("hello?world")),
+                             Reallocate(sizeofPool(), sizeofPool(1)),
+                         });
+  }
+
+  SECTION("filtered out strings don't use the buffer") {
+    std::vector<char> buffer = makeBuffer(
+        "{\"skipped\":\"xxxxxxxxxxxxxxx\",\"kept\":\"hello\","
+        "\"other\":\"yyyyyyyyyyyyyyy\"}");
+    JsonDocument filter;
+    filter["kept"] = true;
+
+    auto err = deserializeJsonInPlace(doc, buffer.data(), Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"kept\":\"hello\"}");
+    REQUIRE(doc["kept"].as<const char*>() == buffer.data() + 5);
+  }
+
+  SECTION("copying the document copies the strings") {
+    std::vector<char> buffer = makeBuffer("{\"hello\":\"world\"}");
+    REQUIRE(deserializeJsonInPlace(doc, buffer.data()) ==
+            DeserializationError::Ok);
+
+    JsonDocument copy(doc);
+    buffer.assign(buffer.size(), 'x');
+
+    REQUIRE(copy.as<std::string>() == "{\"hello\":\"world\"}");
+  }
+
+  SECTION("null input") {
+    auto err = deserializeJsonInPlace(doc, static_cast<char*>(nullptr));
+
+    REQUIRE(err == DeserializationError::EmptyInput);
+  }
+
+  SECTION("variant destination") {
+    std::vector<char> buffer = makeBuffer("\"value\"");
+
+    auto err = deserializeJsonInPlace(doc["key"], buffer.data());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["key"] == "value");
+    REQUIRE(pointsInto(doc["key"].as<const char*>(), buffer));
+  }
+}
@@ -6,6 +6,7 @@
 
 #include <catch.hpp>
 #include <sstream>
+#include <vector>
 
 #include "Allocators.hpp"
 #include "CustomReader.hpp"
@@ -58,6 +59,33 @@ TEST_CASE("deserializeJson(uint8_t*, size_t)") {  // issue #1898
   REQUIRE(err == DeserializationError::Ok);
 }
 
+TEST_CASE("deserializeJson(const char*, size_t) with a null pointer") {
+  JsonDocument doc;
+  const char* input = nullptr;
+
+  SECTION("deserializeJson()") {
+    REQUIRE(deserializeJson(doc, input, 0) == DeserializationError::EmptyInput);
+    REQUIRE(deserializeJson(doc, input, 10) ==
+            DeserializationError::EmptyInput);
+  }
+
+  SECTION("deserializeJson() without size") {
+    REQUIRE(deserializeJson(doc, input) == DeserializationError::EmptyInput);
+  }
+
+  SECTION("extractJson()") {
+    const char* pointers[] = {""};
+    REQUIRE(extractJson(doc, input, 0, pointers) ==
+            DeserializationError::EmptyInput);
+  }
+
+  SECTION("measureDeserializeJson()") {
+    JsonDocumentSize size;
+    REQUIRE(measureDeserializeJson(size, input, 0) ==
+            DeserializationError::EmptyInput);
+  }
+}
+
 TEST_CASE("deserializeJson(const std::string&)") {
   JsonDocument doc;
 
@@ -87,6 +115,92 @@ TEST_CASE("deserializeJson(const std::string&)") {
   }
 }
 
+TEST_CASE("deserializeJson(const std::vector<char>&)") {
+  JsonDocument doc;
+  std::vector<char> input = {'[', '4', '2', ']'};  // no terminator
+
+  DeserializationError err = deserializeJson(doc, input);
+
+  REQUIRE(err == DeserializationError::Ok);
+  REQUIRE(doc.as<std::string>() == "[42]");
+}
+
+TEST_CASE("deserializeJson() gives the same result for RAM and streams") {
+  // RAM inputs are consumed in runs, streams are read one char at a time
+  std::string testCases[] = {
+      // strings
+      "\"hello world\"",
+      "\"hello",
+      "\"hello\\",
+      "\"a\\tb\\u00e9c\\\"d\"",
+      "'single'",
+      "\"\xC3\xA9\xFF\"",
+      "\"embedded\0nul\""_s,
+      // objects and arrays
+      "{ \"a\" : [ 1 , 2.5 , -3e2 ] , \"b\" : { \"a\" : \"x\" } }",
+      "{a:1,b_c:true}",
+      "{a",
+      "[1,",
+      "[1,\0 2]"_s,
+      // spaces
+      "  ",
+      "",
+      " \t\r\n[ \t\r\n1 \t\r\n] \t\r\n",
+      // numbers
+      "12345678901234567890",
+      "1234567890123456789012345678901234567890123456789012345678901234567",
+      "1.5",
+      "1.5x",
+      "1.5 ",
+      "[1.5x]",
+      // keywords
+      "nul",
+      "[true,false,null]",
+      // comments
+      "// comment\n[1]",
+      "/* comment */ [1]",
+      "/* comment",
+      "[1]/",
+  };
+
+  JsonDocument filter;
+  filter["a"] = true;
+
+  for (auto& input : testCases) {
+    SECTION(input) {
+      JsonDocument expected, actual;
+
+      SECTION("no filter") {
+        std::istringstream stream(input);
+        auto expectedError = deserializeJson(expected, stream);
+
+        CHECK(deserializeJson(actual, input) == expectedError);
+        CHECK(actual == expected);
+
+        CHECK(deserializeJson(actual, input.c_str(), input.size()) ==
+              expectedError);
+        CHECK(actual == expected);
+      }
+
+      SECTION("filter") {
+        std::istringstream stream(input);
+        auto expectedError = deserializeJson(
+            expected, stream, DeserializationOption::Filter(filter));
+
+        CHECK(deserializeJson(actual, input,
+                              DeserializationOption::Filter(filter)) ==
+              expectedError);
+        CHECK(actual == expected);
+
+        CHECK(deserializeJson(actual, input.c_str(), input.size(),
+                              DeserializationOption::Filter(filter)) ==
+              expectedError);
+        CHECK(actual == expected);
+      }
+    }
+  }
+}
+
 TEST_CASE("deserializeJson(std::istream&)") {
   JsonDocument doc;
 
@@ -0,0 +1,110 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+static size_t sizeofBlockString(size_t n) {
+  return ArduinoJson::detail::StringBlock::sizeForLength(n);
+}
+
+// The room for the string that StringBuilder grows
+static size_t scratch(size_t longest = 0) {
+  return sizeofBlockString(2 * longest + 1 > 31 ? 2 * longest + 1 : 31);
+}
+
+TEST_CASE("measureDeserializeJson()") {
+  JsonDocumentSize size;
+
+  SECTION("scalar") {
+    DeserializationError err = measureDeserializeJson(size, "42");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(size.variantSlots == 0);
+    REQUIRE(size.stringBytes == 0);
+  }
+
+  SECTION("empty collections") {
+    DeserializationError err = measureDeserializeJson(size, "[ {}, [] ]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(size.variantSlots == 2);
+    REQUIRE(size.stringBytes == 0);
+  }
+
+  SECTION("one slot per element, two per member") {
+    DeserializationError err = measureDeserializeJson(
+        size, "{\"a\":[1,true,null,2.5],\"b\":{\"c\":false}}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(size.variantSlots == 4 + 4 + 2);
+  }
+
+  SECTION("tiny strings only need the scratch string") {
+    DeserializationError err = measureDeserializeJson(size, "{\"a\":\"bc\"}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(size.stringBytes == scratch());
+  }
+
+  SECTION("longer strings") {
+    DeserializationError err =
+        measureDeserializeJson(size, "{hello:'world',\"key\":\"value\"}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(size.variantSlots == 4);
+    REQUIRE(size.stringBytes == 3 * sizeofBlockString(5) + scratch());
+  }
+
+  SECTION("escape sequences") {
+    DeserializationError err =
+        measureDeserializeJson(size, "[\"\\u00e9t\\u00e9\",\"a\\\"b\"]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(size.stringBytes == sizeofBlockString(5) + scratch());
+  }
+
+  SECTION("the scratch string grows with the longest string") {
+    std::string json = "[\"" + std::string(100, 'x') + "\"]";
+
+    DeserializationError err = measureDeserializeJson(size, json);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(size.stringBytes == sizeofBlockString(100) + scratch(100));
+  }
+
+  SECTION("input size") {
+    DeserializationError err = measureDeserializeJson(size, "[1,2][3]", 5);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(size.variantSlots == 2);
+  }
+
+  SECTION("IncompleteInput") {
+    DeserializationError err = measureDeserializeJson(size, "[1,\"abc");
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("InvalidInput") {
+    DeserializationError err = measureDeserializeJson(size, "[1;2]");
+
+    REQUIRE(err == DeserializationError::InvalidInput);
+  }
+
+  SECTION("EmptyInput") {
+    DeserializationError err = measureDeserializeJson(size, "  ");
+
+    REQUIRE(err == DeserializationError::EmptyInput);
+  }
+
+  SECTION("TooDeep") {
+    DeserializationError err = measureDeserializeJson(
+        size, "[[1]]", DeserializationOption::NestingLimit(1));
+
+    REQUIRE(err == DeserializationError::TooDeep);
+  }
+}
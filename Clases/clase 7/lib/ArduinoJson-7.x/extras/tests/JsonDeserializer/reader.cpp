@@ -0,0 +1,224 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Allocators.hpp"
+
+static const char* const nestedJson =
+    "{\"a\":[1,2.5,\"x\"],\"b\":{\"c\":true,\"d\":null},\"e\":[]}";
+
+template <typename TReader>
+static std::string readAll(TReader& reader) {
+  std::ostringstream out;
+  for (;;) {
+    switch (reader.next()) {
+      case JsonEvent::End:
+        return out.str();
+      case JsonEvent::Error:
+        out << "error:" << reader.error().c_str();
+        return out.str();
+      case JsonEvent::StartObject:
+        out << '{';
+        break;
+      case JsonEvent::EndObject:
+        out << '}';
+        break;
+      case JsonEvent::StartArray:
+        out << '[';
+        break;
+      case JsonEvent::EndArray:
+        out << ']';
+        break;
+      case JsonEvent::Key:
+        out << "k:" << reader.template as<const char*>() << ' ';
+        break;
+      case JsonEvent::String:
+        out << "s:" << reader.template as<const char*>() << ' ';
+        break;
+      case JsonEvent::Number:
+        out << "n:" << reader.template as<double>() << ' ';
+        break;
+      case JsonEvent::Boolean:
+        out << (reader.template as<bool>() ? "true " : "false ");
+        break;
+      case JsonEvent::Null:
+        out << "null ";
+        break;
+    }
+  }
+}
+
+static const char* const nestedEvents =
+    "{k:a [n:1 n:2.5 s:x ]k:b {k:c true k:d null }k:e []}";
+
+TEST_CASE("JsonReader") {
+  SECTION("const char*") {
+    JsonReader<const char*> reader(nestedJson);
+    REQUIRE(readAll(reader) == nestedEvents);
+  }
+
+  SECTION("char*") {
+    char input[] = "[1,2]";
+    JsonReader<char*> reader(input);
+    REQUIRE(readAll(reader) == "[n:1 n:2 ]");
+  }
+
+  SECTION("const char* and size") {
+    JsonReader<const char*> reader("[1,2]garbage", 5);
+    REQUIRE(readAll(reader) == "[n:1 n:2 ]");
+  }
+
+  SECTION("null pointer") {
+    JsonReader<const char*> reader(nullptr);
+    REQUIRE(readAll(reader) == "error:EmptyInput");
+  }
+
+  SECTION("std::string") {
+    std::string input(nestedJson);
+    JsonReader<std::string> reader(input);
+    REQUIRE(readAll(reader) == nestedEvents);
+  }
+
+  SECTION("std::vector<char>") {
+    std::vector<char> input(nestedJson, nestedJson + strlen(nestedJson));
+    JsonReader<std::vector<char>> reader(input);
+    REQUIRE(readAll(reader) == nestedEvents);
+  }
+
+  SECTION("std::istream") {
+    std::istringstream input(nestedJson);
+    JsonReader<std::istream> reader(input);
+    REQUIRE(readAll(reader) == nestedEvents);
+  }
+
+  SECTION("stops after the root value") {
+    std::istringstream input("[1] [2]");
+    JsonReader<std::istream> reader(input);
+    REQUIRE(readAll(reader) == "[n:1 ]");
+    REQUIRE(reader.next() == JsonEvent::End);
+    REQUIRE(input.get() == ' ');
+  }
+
+  SECTION("scalar root") {
+    JsonReader<const char*> reader("  \"hello\"  ");
+    REQUIRE(readAll(reader) == "s:hello ");
+  }
+
+  SECTION("escape sequences, spaces, and single quotes") {
+    JsonReader<const char*> reader("\t{'k\\u00e9y' : \"a\\tb\" ,\n n: -1e3}");
+    REQUIRE(readAll(reader) == "{k:k\xC3\xA9y s:a\tb k:n n:-1000 }");
+  }
+
+  SECTION("as()") {
+    JsonReader<const char*> reader("[42,\"hi\",true]");
+
+    REQUIRE(reader.next() == JsonEvent::StartArray);
+    REQUIRE(reader.as<int>() == 0);
+    REQUIRE(reader.as<JsonString>().isNull());
+
+    REQUIRE(reader.next() == JsonEvent::Number);
+    REQUIRE(reader.as<int>() == 42);
+    REQUIRE(reader.as<uint8_t>() == 42);
+    REQUIRE(reader.as<float>() == 42.0f);
+    REQUIRE(reader.as<bool>() == false);
+
+    REQUIRE(reader.next() == JsonEvent::String);
+    REQUIRE(reader.as<JsonString>() == "hi");
+    REQUIRE(reader.as<int>() == 0);
+
+    REQUIRE(reader.next() == JsonEvent::Boolean);
+    REQUIRE(reader.as<bool>() == true);
+
+    REQUIRE(reader.next() == JsonEvent::EndArray);
+    REQUIRE(reader.next() == JsonEvent::End);
+  }
+
+  SECTION("errors") {
+    SECTION("EmptyInput") {
+      JsonReader<const char*> reader("  ");
+      REQUIRE(readAll(reader) == "error:EmptyInput");
+    }
+
+    SECTION("IncompleteInput") {
+      JsonReader<const char*> reader("{\"a\":[1,");
+      REQUIRE(readAll(reader) == "{k:a [n:1 error:IncompleteInput");
+    }
+
+    SECTION("missing comma") {
+      JsonReader<const char*> reader("[1 2]");
+      REQUIRE(readAll(reader) == "[n:1 error:InvalidInput");
+    }
+
+    SECTION("missing colon") {
+      JsonReader<const char*> reader("{\"a\" 1}");
+      REQUIRE(readAll(reader) == "{error:InvalidInput");
+    }
+
+    SECTION("invalid number") {
+      JsonReader<const char*> reader("[1,-]");
+      REQUIRE(readAll(reader) == "[n:1 error:InvalidInput");
+    }
+
+    SECTION("characters after a number at the root") {
+      const char* inputs[] = {"1.5x", "1x", "1 ", "1,2"};
+      for (auto input : inputs) {
+        JsonReader<const char*> reader(input);
+        CAPTURE(input);
+        REQUIRE(readAll(reader) == "error:InvalidInput");
+      }
+
+      JsonReader<const char*> reader("-12");
+      REQUIRE(readAll(reader) == "n:-12 ");
+    }
+
+    SECTION("the error sticks") {
+      JsonReader<const char*> reader("[}");
+      REQUIRE(reader.next() == JsonEvent::StartArray);
+      REQUIRE(reader.next() == JsonEvent::Error);
+      REQUIRE(reader.next() == JsonEvent::Error);
+      REQUIRE(reader.error() == DeserializationError::InvalidInput);
+    }
+
+    SECTION("TooDeep") {
+      JsonReader<const char*> reader("[[[1]]]",
+                                     DeserializationOption::NestingLimit(2));
+      REQUIRE(readAll(reader) == "[[error:TooDeep");
+    }
+
+    SECTION("NoMemory") {
+      KillswitchAllocator allocator;
+      allocator.on();
+      JsonReader<const char*> reader("[\"hello\"]", {}, &allocator);
+      REQUIRE(readAll(reader) == "[error:NoMemory");
+    }
+  }
+
+  SECTION("uses the same memory for any number of values") {
+    std::string input = "[";
+    for (int i = 0; i < 10000; i++)
+      input += "{\"id\":12345,\"name\":\"a name\",\"tags\":[true,null]},";
+    input += "{}]";
+
+    SpyingAllocator allocator;
+    {
+      JsonReader<std::string> reader(input, {}, &allocator);
+      size_t events = 0;
+      while (reader.next() > JsonEvent::Error)
+        events++;
+      REQUIRE(reader.error() == DeserializationError::Ok);
+      REQUIRE(events == 10000 * 11 + 4);
+    }
+
+    REQUIRE(allocator.log() == AllocatorLog{
+                                   Allocate(sizeofStringBuffer()),
+                                   Deallocate(sizeofStringBuffer()),
+                               });
+  }
+}
@@ -0,0 +1,228 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+
+static const char* const inputs[] = {
+    "{\"hello\":\"world\",\"nested\":{\"array\":[\"one\",\"two\",\"three\"]}}",
+    "[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\",\"escaped\\tstring\"]",
+    "[\"\\u00e9\\u2665\\uD83D\\uDE00\",\"\\u0041BCD\"]",
+    "{\"a\":1,\"a\":\"second value\",\"b\":[1,2],\"b\":null}",
+    "{unquoted_key:'single quoted',other:\"double quoted\"}",
+    " [ 0 , -1 , 3.14 , 1e10 , -2.5e-3 , 18446744073709551615 ] ",
+    "[123456789012345678901234567890,0.1234567890123456789]",
+    "[true,false,null,[],{},[[]],[{}]]",
+    "{\"a\":{\"b\":{\"c\":{\"d\":[1,[2,[3]]]}}}}",
+    "\"root string\"",
+    "true",
+    "[\"unterminated",
+    "{\"a\":}",
+    "[1,]",
+    "[1 2]",
+    "{\"a\" 1}",
+    "[tru]",
+    "[nul",
+    "[\"\\x\"]",
+    "[\"\\u00G0\"]",
+    "",
+    "   ",
+    "[1,2",
+    "1,2,3]",
+    "59.]",
+    "2r]",
+    "42 ",
+    "42 x",
+};
+
+static std::string toJson(const JsonDocument& doc) {
+  std::string json;
+  serializeJson(doc, json);
+  return json;
+}
+
+// Feeds the input in chunks of the given size, then signals the end
+static DeserializationError feedInChunks(JsonDocument& doc, const char* input,
+                                         size_t chunkSize) {
+  JsonStreamParser parser(doc);
+  size_t length = strlen(input);
+  DeserializationError err = DeserializationError::IncompleteInput;
+  for (size_t i = 0; i < length && err == DeserializationError::IncompleteInput;
+       i += chunkSize) {
+    size_t n = length - i < chunkSize ? length - i : chunkSize;
+    err = parser.feed(input + i, n);
+  }
+  return parser.finish();
+}
+
+TEST_CASE("JsonStreamParser gives the same result as deserializeJson()") {
+  for (auto input : inputs) {
+    CAPTURE(input);
+
+    JsonDocument expectedDoc;
+    auto expectedError = deserializeJson(expectedDoc, input);
+
+    for (size_t chunkSize = 1; chunkSize <= strlen(input) + 1; chunkSize++) {
+      CAPTURE(chunkSize);
+      JsonDocument doc;
+      auto err = feedInChunks(doc, input, chunkSize);
+      REQUIRE(err == expectedError);
+      if (!err)
+        REQUIRE(toJson(doc) == toJson(expectedDoc));
+    }
+  }
+}
+
+TEST_CASE("JsonStreamParser") {
+  JsonDocument doc;
+
+  SECTION("split at every position") {
+    const char* input =
+        "{\"key\":\"a\\u00e9\\nb\",\"n\":[-12.5e3,42,true,null]}";
+    size_t length = strlen(input);
+    for (size_t i = 0; i <= length; i++) {
+      CAPTURE(i);
+      JsonStreamParser parser(doc);
+      REQUIRE(parser.feed(input, i) ==
+              (i == length ? DeserializationError::Ok
+                           : DeserializationError::IncompleteInput));
+      REQUIRE(parser.feed(input + i, length - i) == DeserializationError::Ok);
+      REQUIRE(toJson(doc) ==
+              "{\"key\":\"a\xC3\xA9\\nb\",\"n\":[-12500,42,true,null]}");
+    }
+  }
+
+  SECTION("returns Ok as soon as the document is complete") {
+    JsonStreamParser parser(doc);
+    REQUIRE(parser.feed("{\"a\":") == DeserializationError::IncompleteInput);
+    REQUIRE(parser.feed("1}  garbage") == DeserializationError::Ok);
+    REQUIRE(parser.feed("more garbage") == DeserializationError::Ok);
+    REQUIRE(parser.finish() == DeserializationError::Ok);
+    REQUIRE(doc["a"] == 1);
+  }
+
+  SECTION("a number at the root needs finish()") {
+    JsonStreamParser parser(doc);
+    REQUIRE(parser.feed("12") == DeserializationError::IncompleteInput);
+    REQUIRE(parser.feed("34") == DeserializationError::IncompleteInput);
+    REQUIRE(parser.finish() == DeserializationError::Ok);
+    REQUIRE(doc.as<int>() == 1234);
+  }
+
+  SECTION("a space can't follow a number at the root") {
+    JsonStreamParser parser(doc);
+    REQUIRE(parser.feed("42 ") == DeserializationError::InvalidInput);
+    REQUIRE(parser.finish() == DeserializationError::InvalidInput);
+  }
+
+  SECTION("nothing else can follow a number at the root") {
+    const char* invalidInputs[] = {"1,2,3]", "59.]", "2r]", "7}", "42 ", "42 x"};
+    for (auto input : invalidInputs) {
+      CAPTURE(input);
+      JsonStreamParser parser(doc);
+      DeserializationError err = DeserializationError::IncompleteInput;
+      for (auto p = input; *p && err == DeserializationError::IncompleteInput;
+           p++)
+        err = parser.feed(p, 1);  // one byte at a time
+      REQUIRE(err == DeserializationError::InvalidInput);
+      REQUIRE(parser.finish() == DeserializationError::InvalidInput);
+    }
+  }
+
+  SECTION("empty chunks") {
+    JsonStreamParser parser(doc);
+    REQUIRE(parser.feed("") == DeserializationError::IncompleteInput);
+    REQUIRE(parser.feed(nullptr, 0) == DeserializationError::IncompleteInput);
+    REQUIRE(parser.finish() == DeserializationError::EmptyInput);
+  }
+
+  SECTION("clears the document") {
+    doc["hello"] = "world";
+    JsonStreamParser parser(doc);
+    REQUIRE(parser.feed("[1]") == DeserializationError::Ok);
+    REQUIRE(toJson(doc) == "[1]");
+  }
+
+  SECTION("errors stick") {
+    JsonStreamParser parser(doc);
+    REQUIRE(parser.feed("[1,}") == DeserializationError::InvalidInput);
+    REQUIRE(parser.feed("2]") == DeserializationError::InvalidInput);
+    REQUIRE(parser.finish() == DeserializationError::InvalidInput);
+  }
+
+  SECTION("NUL in a string") {
+    JsonStreamParser parser(doc);
+    REQUIRE(parser.feed("[\"a\0b\"]", 7) == DeserializationError::InvalidInput);
+  }
+
+  SECTION("number too long") {
+    std::string input = "[" + std::string(100, '1') + "]";
+    JsonStreamParser parser(doc);
+    REQUIRE(parser.feed(input.c_str()) == DeserializationError::InvalidInput);
+  }
+
+  SECTION("TooDeep") {
+    JsonStreamParser parser(doc, DeserializationOption::NestingLimit(2));
+    REQUIRE(parser.feed("[[1]]") == DeserializationError::Ok);
+
+    JsonStreamParser parser2(doc, DeserializationOption::NestingLimit(2));
+    REQUIRE(parser2.feed("[[[1]]]") == DeserializationError::TooDeep);
+
+    JsonStreamParser parser3(doc, DeserializationOption::NestingLimit(0));
+    REQUIRE(parser3.feed("{}") == DeserializationError::TooDeep);
+  }
+
+  SECTION("deep nesting") {
+    std::string input = std::string(100, '[') + std::string(100, ']');
+    JsonStreamParser parser(doc, DeserializationOption::NestingLimit(100));
+    REQUIRE(parser.feed(input.c_str()) == DeserializationError::Ok);
+    REQUIRE(toJson(doc) == input);
+  }
+}
+
+TEST_CASE("JsonStreamParser memory usage") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("the document, the string buffer, and the nesting stack") {
+    const char* input = "{\"hello\":[\"world\",{\"a\":\"a long string value\"}]}";
+
+    {
+      JsonStreamParser parser(doc);
+      for (const char* p = input; *p; p++)
+        REQUIRE(parser.feed(p, 1) ==
+                (p[1] ? DeserializationError::IncompleteInput
+                      : DeserializationError::Ok));
+    }
+
+    REQUIRE(spy.log() ==
+            AllocatorLog{
+                Allocate(4 * sizeof(void*)),  // nesting stack
+                Allocate(sizeofStringBuffer()),
+                Allocate(sizeofPool()),
+                Reallocate(sizeofStringBuffer(), sizeofString("hello")),
+                Allocate(sizeofStringBuffer()),
+                Reallocate(sizeofStringBuffer(), sizeofString("world")),
+                Allocate(sizeofStringBuffer()),
+                Reallocate(sizeofStringBuffer(),
+                           sizeofString("a long string value")),
+                Deallocate(4 * sizeof(void*)),
+                Reallocate(sizeofPool(), sizeofPool(6)),
+            });
+  }
+
+  SECTION("NoMemory") {
+    KillswitchAllocator killswitch;
+    JsonDocument doc2(&killswitch);
+    JsonStreamParser parser(doc2);
+    REQUIRE(parser.feed("{\"a\":[\"") == DeserializationError::IncompleteInput);
+    killswitch.on();
+    REQUIRE(parser.feed("a long string that doesn't fit in the buffer\"]}") ==
+            DeserializationError::NoMemory);
+  }
+}
@@ -0,0 +1,192 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+#include <vector>
+
+#include "Allocators.hpp"
+
+using ArduinoJson::detail::SlotId;
+using ArduinoJson::detail::VariantAttorney;
+using ArduinoJson::detail::VariantData;
+
+// Appends the address of each value in depth-first order
+static void collectSlots(JsonVariantConst variant,
+                         std::vector<const VariantData*>& slots) {
+  if (variant.is<JsonArrayConst>()) {
+    for (JsonVariantConst element : variant.as<JsonArrayConst>()) {
+      slots.push_back(VariantAttorney::getData(element));
+      collectSlots(element, slots);
+    }
+  } else if (variant.is<JsonObjectConst>()) {
+    for (JsonPairConst pair : variant.as<JsonObjectConst>()) {
+      JsonVariantConst value = pair.value();
+      slots.push_back(VariantAttorney::getData(value));
+      collectSlots(value, slots);
+    }
+  }
+}
+
+static bool isInDepthFirstOrder(const JsonDocument& doc) {
+  std::vector<const VariantData*> slots;
+  collectSlots(doc.as<JsonVariantConst>(), slots);
+  for (size_t i = 1; i < slots.size(); i++)
+    if (slots[i] <= slots[i - 1])
+      return false;
+  return true;
+}
+
+TEST_CASE("JsonDocument::compact()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("null") {
+    REQUIRE(doc.compact() == true);
+
+    REQUIRE(doc.isNull());
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("releases the removed slots") {
+    for (int i = 0; i < 6; i++)
+      doc.add(i);
+    doc.remove(0);
+    doc.remove(0);
+    spy.clearLog();
+
+    REQUIRE(doc.compact() == true);
+
+    REQUIRE(doc.as<std::string>() == "[2,3,4,5]");
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(6 * sizeof(SlotId)),
+                             Deallocate(6 * sizeof(SlotId)),
+                             Reallocate(sizeofPool(), sizeofPool(4)),
+                         });
+  }
+
+  SECTION("releases the emptied pools") {
+    for (int i = 0; i < 3 * ARDUINOJSON_POOL_CAPACITY; i++)
+      doc.add(i);
+    for (int i = 0; i < 3 * ARDUINOJSON_POOL_CAPACITY - 10; i++)
+      doc.remove(0);
+    spy.clearLog();
+
+    REQUIRE(doc.compact() == true);
+
+    REQUIRE(doc.size() == 10);
+    REQUIRE(doc[0] == 3 * ARDUINOJSON_POOL_CAPACITY - 10);
+    REQUIRE(doc[9] == 3 * ARDUINOJSON_POOL_CAPACITY - 1);
+    REQUIRE(spy.log() ==
+            AllocatorLog{
+                Allocate(3 * ARDUINOJSON_POOL_CAPACITY * sizeof(SlotId)),
+                Deallocate(sizeofPool()),
+                Deallocate(sizeofPool()),
+                Deallocate(3 * ARDUINOJSON_POOL_CAPACITY * sizeof(SlotId)),
+                Reallocate(sizeofPool(), sizeofPool(10)),
+            });
+  }
+
+  SECTION("puts the slots in depth-first order") {
+    // in a single pool, because the addresses of two pools can't be compared
+    doc["a"].add(1);
+    doc["a"].add<JsonObject>()["b"] = 2;
+    doc["c"] = 3;
+    doc["a"].add(4);
+    doc["a"][1]["d"] = 5;
+    doc["e"] = 6;
+    doc["a"].remove(0);
+    doc["c"].set("three");
+    REQUIRE(isInDepthFirstOrder(doc) == false);
+
+    REQUIRE(doc.compact() == true);
+
+    REQUIRE(isInDepthFirstOrder(doc) == true);
+    REQUIRE(doc.as<std::string>() ==
+            "{\"a\":[{\"b\":2,\"d\":5},4],\"c\":\"three\",\"e\":6}");
+  }
+
+  SECTION("keeps the strings") {
+    doc["hello"] = std::string("world");
+    doc["removed"] = std::string("value");
+    doc["key"] = std::string("value");
+    doc.remove("removed");
+
+    REQUIRE(doc.compact() == true);
+
+    REQUIRE(doc.as<std::string>() ==
+            "{\"hello\":\"world\",\"key\":\"value\"}");
+  }
+
+  SECTION("keeps the 8-byte values") {
+    doc.add(1.5);
+    doc.add(3.141592653589793);
+    doc.add(-9223372036854775807LL);
+    doc.add(2.718281828459045);
+    doc.remove(1);
+
+    REQUIRE(doc.compact() == true);
+
+    REQUIRE(doc[0] == 1.5);
+    REQUIRE(doc[1] == -9223372036854775807LL);
+    REQUIRE(doc[2] == 2.718281828459045);
+  }
+
+  SECTION("slots allocated after a shrinkToFit()") {
+    doc.add(1);
+    doc.add(2);
+    doc.shrinkToFit();  // the next pool leaves a hole in the ids
+    for (int i = 3; i <= 10; i++)
+      doc.add(i);
+    doc.remove(0);
+
+    REQUIRE(doc.compact() == true);
+
+    REQUIRE(doc.as<std::string>() == "[2,3,4,5,6,7,8,9,10]");
+  }
+
+  SECTION("the document can grow again") {
+    deserializeJson(doc, "[[1,2],[3,4],[5,6]]");
+    doc.remove(1);
+    REQUIRE(doc.compact() == true);
+
+    doc[0].add(7);
+    doc.add(8);
+
+    REQUIRE(doc.as<std::string>() == "[[1,2,7],[5,6],8]");
+  }
+
+  SECTION("references must be fetched again") {
+    deserializeJson(doc, "[1,{\"a\":2,\"b\":3},[4,5]]");
+    doc.remove(0);
+    doc[0].remove("a");
+
+    REQUIRE(doc.compact() == true);
+
+    // the slots moved, so the references obtained before are invalid
+    JsonObject obj = doc[0];
+    JsonArray arr = doc[1];
+    JsonVariant b = obj["b"];
+    REQUIRE(b == 3);
+    b.set(6);
+    arr.add(7);
+    obj["c"] = 8;
+
+    REQUIRE(doc.as<std::string>() == "[{\"b\":6,\"c\":8},[4,5,7]]");
+  }
+
+  SECTION("can't allocate the table") {
+    KillswitchAllocator killswitch;
+    JsonDocument doc2(&killswitch);
+    deserializeJson(doc2, "[1,2,3]");
+    doc2.remove(0);
+    killswitch.on();
+
+    REQUIRE(doc2.compact() == false);
+
+    REQUIRE(doc2.as<std::string>() == "[2,3]");
+  }
+}
@@ -0,0 +1,182 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+
+static std::string toJson(JsonVariantConst variant) {
+  std::string json;
+  serializeJson(variant, json);
+  return json;
+}
+
+TEST_CASE("JsonFrozenDocument") {
+  SpyingAllocator spy;
+  JsonDocument doc;
+
+  SECTION("null") {
+    JsonFrozenDocument frozen(doc, &spy);
+
+    REQUIRE(frozen.isNull());
+    REQUIRE(frozen.size() == 0);
+    REQUIRE(frozen.overflowed() == false);
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("scalar") {
+    doc.set(std::string("hello"));
+
+    JsonFrozenDocument frozen(doc);
+
+    REQUIRE(frozen.as<std::string>() == "hello");
+    REQUIRE(frozen == "hello");
+  }
+
+  SECTION("sorts the members by key") {
+    deserializeJson(doc, "{\"b\":[3,{\"z\":1,\"y\":2}],\"c\":true,\"a\":1.5}");
+
+    JsonFrozenDocument frozen(doc);
+
+    REQUIRE(toJson(frozen) ==
+            "{\"a\":1.5,\"b\":[3,{\"y\":2,\"z\":1}],\"c\":true}");
+    REQUIRE(frozen.nesting() == 3);
+  }
+
+  SECTION("subscript") {
+    deserializeJson(doc,
+                    "{\"list\":[10,20,30,[40,50]],\"obj\":{\"k\":\"v\"},"
+                    "\"empty\":[]}");
+
+    JsonFrozenDocument frozen(doc);
+
+    REQUIRE(frozen.size() == 3);
+    REQUIRE(frozen["list"].size() == 4);
+    REQUIRE(frozen["list"][0] == 10);
+    REQUIRE(frozen["list"][2] == 30);
+    REQUIRE(frozen["list"][3][1] == 50);
+    REQUIRE(frozen["list"][4].isNull());
+    REQUIRE(frozen["list"][3][2].isNull());
+    REQUIRE(frozen["obj"]["k"] == "v");
+    REQUIRE(frozen["obj"]["K"].isNull());
+    REQUIRE(frozen["empty"].size() == 0);
+    REQUIRE(frozen["empty"][0].isNull());
+    REQUIRE(frozen["missing"].isNull());
+    REQUIRE(frozen[std::string("obj")].size() == 1);
+    REQUIRE(frozen[frozen["obj"]["k"]].isNull());
+    REQUIRE(frozen[0].isNull());
+  }
+
+  SECTION("root array") {
+    deserializeJson(doc, "[1,[2,3],{\"a\":4}]");
+
+    JsonFrozenDocument frozen(doc);
+
+    REQUIRE(frozen.size() == 3);
+    REQUIRE(frozen[0] == 1);
+    REQUIRE(frozen[1][1] == 3);
+    REQUIRE(frozen[2]["a"] == 4);
+    REQUIRE(frozen[3].isNull());
+    REQUIRE(frozen.as<JsonArrayConst>()[1].size() == 2);
+  }
+
+  SECTION("finds every key of a large object") {
+    JsonObject obj = doc.to<JsonObject>();
+    for (int i = 0; i < 300; i++)
+      obj[std::to_string(i * 7 % 300)] = i;
+
+    JsonFrozenDocument frozen(doc);
+
+    REQUIRE(frozen.size() == 300);
+    for (int i = 0; i < 300; i++)
+      REQUIRE(frozen[std::to_string(i * 7 % 300)] == i);
+    REQUIRE(frozen["300"].isNull());
+    REQUIRE(frozen[""].isNull());
+    REQUIRE(frozen["~"].isNull());
+  }
+
+  SECTION("a duplicated key finds the first value, like JsonDocument") {
+    deserializeJson(doc, "{\"b\":1,\"a\":2,\"b\":3,\"a\":4}",
+                    DeserializationOption::AssumeUniqueKeys());
+
+    JsonFrozenDocument frozen(doc);
+
+    REQUIRE(frozen.size() == 4);
+    REQUIRE(frozen["a"] == doc["a"]);
+    REQUIRE(frozen["b"] == doc["b"]);
+    REQUIRE(toJson(frozen) == "{\"a\":2,\"a\":4,\"b\":1,\"b\":3}");
+  }
+
+  SECTION("reading doesn't allocate") {
+    JsonObject obj = doc.to<JsonObject>();
+    for (int i = 0; i < 100; i++)
+      obj[std::to_string(i)] = i;
+    JsonFrozenDocument frozen(doc, &spy);
+    spy.clearLog();
+
+    for (int i = 0; i < 100; i++)
+      REQUIRE(frozen[std::to_string(i)] == i);
+    REQUIRE(frozen.size() == 100);
+
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("keeps the strings") {
+    doc["hello"] = std::string("world");
+    doc["linked"] = "static";
+
+    JsonFrozenDocument frozen(doc);
+    doc.clear();
+
+    REQUIRE(toJson(frozen) == "{\"hello\":\"world\",\"linked\":\"static\"}");
+  }
+
+  SECTION("copy and move") {
+    deserializeJson(doc, "{\"b\":[1,2],\"a\":{\"c\":3}}");
+    JsonFrozenDocument frozen(doc);
+
+    JsonFrozenDocument copy(frozen);
+    JsonFrozenDocument moved(std::move(frozen));
+
+    REQUIRE(copy["b"][1] == 2);
+    REQUIRE(moved["a"]["c"] == 3);
+    REQUIRE(frozen.isNull());
+    REQUIRE(frozen["a"].isNull());
+  }
+
+  SECTION("copy into a JsonDocument") {
+    deserializeJson(doc, "{\"b\":[1,2],\"a\":3}");
+    JsonFrozenDocument frozen(doc);
+
+    JsonDocument doc2;
+    doc2.set(frozen);
+    doc2["c"] = 4;
+
+    REQUIRE(toJson(doc2) == "{\"a\":3,\"b\":[1,2],\"c\":4}");
+  }
+
+  SECTION("MessagePack") {
+    deserializeJson(doc, "{\"b\":[1,2],\"a\":3}");
+    JsonFrozenDocument frozen(doc);
+
+    std::string output;
+    serializeMsgPack(frozen, output);
+
+    REQUIRE(output == "\x82\xA1" "a\x03\xA1" "b\x92\x01\x02");
+  }
+
+  SECTION("overflowed") {
+    KillswitchAllocator killswitch;
+    deserializeJson(doc, "{\"a\":[1,2,3],\"b\":{\"c\":4}}");
+    killswitch.on();
+
+    JsonFrozenDocument frozen(doc, &killswitch);
+
+    REQUIRE(frozen.overflowed() == true);
+    REQUIRE(frozen.isNull());
+  }
+}
@@ -0,0 +1,180 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+#include "Allocators.hpp"
+#include "Literals.hpp"
+
+using ArduinoJson::detail::sizeofString;
+
+TEST_CASE("StringInternTable") {
+  SpyingAllocator tableSpy;
+  SpyingAllocator spy;
+  StringInternTable table(3, &tableSpy);
+
+  SECTION("the keys are allocated once for all the documents") {
+    {
+      JsonDocument doc(&table, &spy);
+      doc["role"_s] = "model"_s;
+      REQUIRE(doc.as<std::string>() == "{\"role\":\"model\"}");
+    }
+    {
+      JsonDocument doc(&table, &spy);
+      doc["role"_s] = "user"_s;
+      REQUIRE(doc.as<std::string>() == "{\"role\":\"user\"}");
+    }
+
+    REQUIRE(table.size() == 1);
+    REQUIRE(tableSpy.log() == AllocatorLog{
+                                  Allocate(sizeofString(4)),
+                              });
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofString(5)),
+                             Deallocate(sizeofString(5)),
+                             Deallocate(sizeofPool()),
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofString(4)),
+                             Deallocate(sizeofString(4)),
+                             Deallocate(sizeofPool()),
+                         });
+  }
+
+  SECTION("the values and the tiny keys stay in the document") {
+    JsonDocument doc(&table, &spy);
+    doc["id"_s] = "role"_s;
+
+    REQUIRE(table.size() == 0);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofString(4)),
+                         });
+  }
+
+  SECTION("the table doesn't grow past maxStrings") {
+    JsonDocument doc(&table, &spy);
+    doc["key1"_s] = 1;
+    doc["key2"_s] = 2;
+    doc["key3"_s] = 3;
+    doc["key4"_s] = 4;
+
+    REQUIRE(doc.as<std::string>() ==
+            "{\"key1\":1,\"key2\":2,\"key3\":3,\"key4\":4}");
+    REQUIRE(table.size() == 3);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofString(4)),
+                         });
+  }
+
+  SECTION("removing a member keeps the key in the table") {
+    JsonDocument doc(&table, &spy);
+    doc["role"_s] = 1;
+    doc["role"_s] = 2;
+    doc.remove("role"_s);
+    doc["role"_s] = 3;
+
+    REQUIRE(doc.as<std::string>() == "{\"role\":3}");
+    REQUIRE(table.size() == 1);
+    REQUIRE(tableSpy.log() == AllocatorLog{
+                                  Allocate(sizeofString(4)),
+                              });
+  }
+
+  SECTION("deserializeJson()") {
+    const char* json = "{\"role\":\"user\",\"parts\":[{\"text\":\"hi\"}]}";
+    JsonDocument doc1(&table, &spy);
+    JsonDocument doc2(&table, &spy);
+
+    REQUIRE(deserializeJson(doc1, json) == DeserializationError::Ok);
+    REQUIRE(deserializeJson(doc2, json) == DeserializationError::Ok);
+
+    REQUIRE(doc1.as<std::string>() == json);
+    REQUIRE(doc2.as<std::string>() == json);
+    REQUIRE(tableSpy.log() == AllocatorLog{
+                                  Allocate(sizeofString(4)),
+                                  Allocate(sizeofString(5)),
+                                  Allocate(sizeofString(4)),
+                              });
+  }
+
+  SECTION("deserializeJson() with a stream") {
+    JsonDocument doc(&table, &spy);
+    std::istringstream json("{\"role\":\"user\"}");
+
+    REQUIRE(deserializeJson(doc, json) == DeserializationError::Ok);
+
+    REQUIRE(doc["role"] == "user");
+    REQUIRE(table.size() == 1);
+  }
+
+  SECTION("deserializeJsonInPlace() leaves the keys in the input") {
+    JsonDocument doc(&table, &spy);
+    char json[] = "{\"role\":\"user\"}";
+
+    REQUIRE(deserializeJsonInPlace(doc, json) == DeserializationError::Ok);
+
+    REQUIRE(doc["role"] == "user");
+    REQUIRE(table.size() == 0);
+  }
+
+  SECTION("deserializeMsgPack()") {
+    JsonDocument doc(&table, &spy);
+    doc["role"_s] = 1;
+
+    REQUIRE(deserializeMsgPack(doc, "\x81\xA4role\xA4user") ==
+            DeserializationError::Ok);
+
+    REQUIRE(doc["role"] == "user");
+    REQUIRE(table.size() == 1);
+  }
+
+  SECTION("counts the documents attached to it") {
+    REQUIRE(table.users() == 0);
+    {
+      JsonDocument doc1(&table, &spy);
+      doc1["role"_s] = 1;
+      REQUIRE(table.users() == 1);
+
+      JsonDocument doc2(doc1);
+      REQUIRE(table.users() == 2);
+      REQUIRE(doc2.as<std::string>() == "{\"role\":1}");
+
+      JsonDocument doc3(std::move(doc2));  // doc2 is detached
+      REQUIRE(table.users() == 2);
+
+      REQUIRE(table.clear() == false);
+      REQUIRE(table.size() == 1);
+    }
+    REQUIRE(table.users() == 0);
+
+    REQUIRE(table.clear() == true);
+    REQUIRE(table.size() == 0);
+    REQUIRE(tableSpy.log() == AllocatorLog{
+                                  Allocate(sizeofString(4)),
+                                  Deallocate(sizeofString(4)),
+                              });
+  }
+
+  SECTION("the document keeps the key if the table can't allocate it") {
+    KillswitchAllocator killswitch;
+    StringInternTable failingTable(3, &killswitch);
+    killswitch.on();
+    JsonDocument doc(&failingTable, &spy);
+
+    doc["role"_s] = 1;
+
+    REQUIRE(doc.as<std::string>() == "{\"role\":1}");
+    REQUIRE(failingTable.size() == 0);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofString(4)),
+                         });
+  }
+}
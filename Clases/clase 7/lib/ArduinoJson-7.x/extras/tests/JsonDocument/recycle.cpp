@@ -0,0 +1,195 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <stdio.h>  // sprintf
+#include <string>
+
+#include "Allocators.hpp"
+#include "Literals.hpp"
+
+// A message with enough members and strings to use the indexes; the values
+// change with n, but not their length
+static std::string makeMessage(int n) {
+  std::string json = "{\"id\":" + std::to_string(n) + ",\"readings\":[";
+  for (int i = 0; i < 40; i++) {
+    char buffer[64];
+    sprintf(buffer, "%s{\"sensor\":\"sensor-%03d\",\"value\":%d.5}",
+            i ? "," : "", (i + n) % 1000, i * n);
+    json += buffer;
+  }
+  json += "],\"labels\":{";
+  for (int i = 0; i < 40; i++) {
+    char buffer[64];
+    sprintf(buffer, "%s\"label-%02d\":\"%s-%04d\"", i ? "," : "", i,
+            "a-long-string-that-makes-the-builder-grow", (i + n) % 10000);
+    json += buffer;
+  }
+  json += "}}";
+  return json;
+}
+
+TEST_CASE("JsonDocument::recycle()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+
+  SECTION("null") {
+    doc.recycle();
+
+    REQUIRE(doc.isNull());
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("keeps the memory") {
+    doc["hello"_s] = "world"_s;
+    spy.clearLog();
+
+    doc.recycle();
+    REQUIRE(doc.isNull());
+
+    doc["hello"_s] = "world"_s;
+    REQUIRE(doc.as<std::string>() == "{\"hello\":\"world\"}");
+
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("clear() releases the memory and stops recycling") {
+    doc["hello"_s] = "world"_s;
+    doc.recycle();
+    spy.clearLog();
+
+    doc.clear();
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofPool()),
+                             Deallocate(sizeofString("hello")),
+                             Deallocate(sizeofString("world")),
+                         });
+
+    deserializeJson(doc, "{\"hello\":\"world\"}");
+    spy.clearLog();
+    deserializeJson(doc, "{\"hello\":\"world\"}");
+    REQUIRE_FALSE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("releases the spare strings that the last content didn't use") {
+    doc["hello"_s] = "world"_s;
+    doc.recycle();
+    doc["abcd"_s] = 1;
+    spy.clearLog();
+
+    doc.recycle();
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofString("hello")),
+                             Deallocate(sizeofString("world")),
+                         });
+
+    spy.clearLog();
+    doc.recycle();  // nothing to reuse the spares yet, so keep them
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("many strings of different lengths") {
+    char s[16];
+    for (int cycle = 0; cycle < 4; cycle++) {
+      doc.recycle();
+      JsonArray array = doc.to<JsonArray>();
+      for (int i = 0; i < 2000; i++) {
+        snprintf(s, sizeof(s), cycle % 2 ? "%05d" : "%06d", cycle * 2000 + i);
+        array.add(std::string(s));
+      }
+    }
+
+    REQUIRE(doc[1999] == "07999");
+    REQUIRE(doc.size() == 2000);
+  }
+
+  SECTION("reuses the strings that are replaced") {
+    doc["hello"_s] = "world"_s;
+    doc.recycle();
+    doc["hello"_s] = "world"_s;
+    spy.clearLog();
+
+    doc["hello"_s] = "WORLD"_s;
+    doc["hello"_s] = "world"_s;
+
+    REQUIRE(doc["hello"] == "world");
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("deserializeJson() stops calling the allocator") {
+    for (int i = 0; i < 3; i++) {  // warm up
+      doc.recycle();
+      deserializeJson(doc, makeMessage(i));
+    }
+    spy.clearLog();
+
+    for (int i = 3; i < 10; i++) {
+      std::string input = makeMessage(i);
+      REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+      std::string output;
+      output.reserve(input.size());
+      serializeJson(doc, output);
+      REQUIRE(output == input);
+    }
+
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("deserializeMsgPack() stops calling the allocator") {
+    std::string inputs[5];
+    for (int i = 0; i < 5; i++) {
+      JsonDocument src;
+      deserializeJson(src, makeMessage(i));
+      serializeMsgPack(src, inputs[i]);
+    }
+
+    doc.recycle();
+    deserializeMsgPack(doc, inputs[0]);
+    deserializeMsgPack(doc, inputs[1]);
+    spy.clearLog();
+
+    for (int i = 2; i < 5; i++) {
+      REQUIRE(deserializeMsgPack(doc, inputs[i]) == DeserializationError::Ok);
+      std::string output;
+      output.reserve(inputs[i].size());
+      serializeMsgPack(doc, output);
+      REQUIRE(output == inputs[i]);
+    }
+
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("a larger message takes more memory") {
+    doc.recycle();
+    deserializeJson(doc, "[\"hello\"]");
+    spy.clearLog();
+
+    deserializeJson(doc, makeMessage(0));
+
+    REQUIRE_FALSE(spy.log() == AllocatorLog{});
+    REQUIRE(doc["readings"][39]["sensor"] == "sensor-039");
+  }
+
+  SECTION("shrinkToFit() releases the spare memory and stops recycling") {
+    deserializeJson(doc, "[\"hello\",\"world\"]");
+    doc.recycle();
+    doc.add("hello"_s);
+    spy.clearLog();
+
+    doc.shrinkToFit();
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofString("world")),
+                             Reallocate(sizeofPool(2), sizeofPool(1)),
+                         });
+
+    spy.clearLog();
+    doc.clear();
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofPool(1)),
+                             Deallocate(sizeofString("hello")),
+                         });
+  }
+}
@@ -0,0 +1,186 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Allocators.hpp"
+#include "Literals.hpp"
+
+using ArduinoJson::detail::sizeofString;
+
+static size_t sizeofBlockString(size_t n) {
+  return ArduinoJson::detail::StringBlock::sizeForLength(n);
+}
+
+static std::string makeMessage(int n, int count) {
+  std::string json = "{\"id\":" + std::to_string(n) + ",\"items\":[";
+  for (int i = 0; i < count; i++) {
+    json += i ? "," : "";
+    json += "{\"name\":\"item-" + std::to_string(i + n) + "\",\"value\":" +
+            std::to_string(i * n) + ",\"tags\":[\"t\",\"long-tag-" +
+            std::string(size_t(i % 40), 'x') + "\"]}";
+  }
+  json += "]}";
+  return json;
+}
+
+TEST_CASE("JsonDocument::reserve()") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+  const size_t C = ARDUINOJSON_POOL_CAPACITY;
+
+  SECTION("allocates one pool and one block") {
+    REQUIRE(doc.reserve(C + 100, 200) == true);
+
+    REQUIRE(doc.isNull());
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool(C + 100)),
+                             Allocate(200),
+                         });
+  }
+
+  SECTION("empties the document") {
+    doc["hello"_s] = "world"_s;
+    spy.clearLog();
+
+    doc.reserve(C + 100, 0);
+
+    REQUIRE(doc.isNull());
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofPool()),
+                             Deallocate(sizeofString(5)),
+                             Deallocate(sizeofString(5)),
+                             Allocate(sizeofPool(C + 100)),
+                         });
+  }
+
+  SECTION("deserializeJson() doesn't allocate anything else") {
+    std::string json = makeMessage(1, 5);  // fewer strings than the threshold
+    JsonDocumentSize size;
+    REQUIRE(measureDeserializeJson(size, json) == DeserializationError::Ok);
+    REQUIRE(doc.reserve(size.variantSlots, size.stringBytes) == true);
+    spy.clearLog();
+
+    REQUIRE(deserializeJson(doc, json) == DeserializationError::Ok);
+
+    REQUIRE(doc["items"][4]["tags"][1] == "long-tag-" + std::string(4, 'x'));
+    REQUIRE(spy.log() == AllocatorLog{});
+
+    SECTION("nor for the next messages of the same size") {
+      REQUIRE(deserializeJson(doc, makeMessage(2, 5)) ==
+              DeserializationError::Ok);
+
+      REQUIRE(doc["items"][0]["name"] == "item-2");
+      REQUIRE(spy.log() == AllocatorLog{});
+    }
+  }
+
+  SECTION("only the string index is allocated by the first message") {
+    std::string json = makeMessage(1, 50);
+    JsonDocumentSize size;
+    REQUIRE(measureDeserializeJson(size, json) == DeserializationError::Ok);
+    REQUIRE(doc.reserve(size.variantSlots, size.stringBytes) == true);
+    spy.clearLog();
+
+    REQUIRE(deserializeJson(doc, json) == DeserializationError::Ok);
+
+    const size_t entry = sizeof(void*);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(64 * entry),
+                             Allocate(128 * entry),
+                             Deallocate(64 * entry),
+                             Allocate(256 * entry),
+                             Deallocate(128 * entry),
+                         });
+    spy.clearLog();
+
+    REQUIRE(deserializeJson(doc, makeMessage(2, 50)) ==
+            DeserializationError::Ok);
+
+    REQUIRE(doc["items"][49]["name"] == "item-51");
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("more slots come from new pools") {
+    doc.reserve(C + 10, 0);
+    JsonArray array = doc.to<JsonArray>();
+    spy.clearLog();
+
+    for (size_t i = 0; i < 2 * C; i++)
+      array.add(i);
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                         });
+    for (size_t i = 0; i < 2 * C; i++)
+      REQUIRE(array[i] == i);
+  }
+
+  SECTION("more strings come from the allocator") {
+    doc.reserve(0, sizeofBlockString(5));
+    spy.clearLog();
+
+    doc.add("hello"_s);
+    doc.add("world"_s);
+
+    REQUIRE(doc.as<std::string>() == "[\"hello\",\"world\"]");
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofString(5)),
+                         });
+  }
+
+  SECTION("the strings of the block are released with it") {
+    doc.reserve(0, 100);
+    doc.add("hello"_s);
+    doc.add("world"_s);
+    doc.remove(0);
+    spy.clearLog();
+
+    doc.clear();
+    REQUIRE(spy.log() == AllocatorLog{
+                             Deallocate(sizeofPool()),
+                             Deallocate(100),
+                         });
+  }
+
+  SECTION("the last string of the block grows in place") {
+    doc.reserve(0, sizeofBlockString(40));
+    spy.clearLog();
+
+    REQUIRE(deserializeJson(doc, "[\"" + std::string(40, 'a') + "\"]") ==
+            DeserializationError::Ok);
+
+    REQUIRE(doc[0] == std::string(40, 'a'));
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                         });
+  }
+
+  SECTION("a string that outgrows the block moves to the allocator") {
+    doc.reserve(0, sizeofBlockString(40));
+    spy.clearLog();
+
+    REQUIRE(deserializeJson(doc, "[\"" + std::string(60, 'a') + "\"]") ==
+            DeserializationError::Ok);
+
+    REQUIRE(doc[0] == std::string(60, 'a'));
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool()),
+                             Allocate(sizeofString(60)),
+                         });
+  }
+
+  SECTION("allocation fails") {
+    KillswitchAllocator killswitch;
+    JsonDocument doc2(&killswitch);
+    killswitch.on();
+
+    REQUIRE(doc2.reserve(C + 100, 100) == false);
+    REQUIRE(doc2.reserve(0, 0) == true);
+  }
+}
@@ -0,0 +1,139 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+#include "Allocators.hpp"
+
+static std::string keyName(int i) {
+  return "key" + std::to_string(i);
+}
+
+static void fill(JsonObject obj, int n) {
+  for (int i = 0; i < n; i++)
+    obj[keyName(i)] = i;
+}
+
+// These tests use objects larger than ARDUINOJSON_OBJECT_INDEX_THRESHOLD so
+// that the lookups go through the index in JsonObjectIndexTests
+TEST_CASE("Large JsonObject") {
+  const int n = 200;
+  JsonDocument doc;
+  JsonObject obj = doc.to<JsonObject>();
+  fill(obj, n);
+
+  SECTION("finds every member") {
+    REQUIRE(obj.size() == n);
+    for (int i = 0; i < n; i++)
+      REQUIRE(obj[keyName(i)] == i);
+  }
+
+  SECTION("doesn't find missing member") {
+    REQUIRE(obj["missing"].isNull());
+  }
+
+  SECTION("overwrites existing members") {
+    for (int i = 0; i < n; i++)
+      obj[keyName(i)] = -i;
+    REQUIRE(obj.size() == n);
+    for (int i = 0; i < n; i++)
+      REQUIRE(obj[keyName(i)] == -i);
+  }
+
+  SECTION("remove first, middle, and last") {
+    obj.remove(keyName(0));
+    obj.remove(keyName(n / 2));
+    obj.remove(keyName(n - 1));
+
+    REQUIRE(obj.size() == n - 3);
+    REQUIRE(obj[keyName(0)].isNull());
+    REQUIRE(obj[keyName(n / 2)].isNull());
+    REQUIRE(obj[keyName(n - 1)].isNull());
+    for (int i = 1; i < n - 1; i++) {
+      if (i != n / 2)
+        REQUIRE(obj[keyName(i)] == i);
+    }
+  }
+
+  SECTION("remove all from the end, then add again") {
+    for (int i = n - 1; i >= 0; i--) {
+      obj.remove(keyName(i));
+      REQUIRE(obj[keyName(i)].isNull());
+      if (i > 0)
+        REQUIRE(obj[keyName(i - 1)] == i - 1);
+    }
+    REQUIRE(obj.size() == 0);
+
+    fill(obj, n);
+    REQUIRE(obj.size() == n);
+    for (int i = 0; i < n; i++)
+      REQUIRE(obj[keyName(i)] == i);
+  }
+
+  SECTION("remove with an iterator") {
+    for (auto it = obj.begin(); it != obj.end(); ++it) {
+      if (keyName(42) == it->key().c_str()) {
+        obj.remove(it);
+        break;
+      }
+    }
+    REQUIRE(obj.size() == n - 1);
+    REQUIRE(obj[keyName(42)].isNull());
+    REQUIRE(obj[keyName(43)] == 43);
+  }
+
+  SECTION("clear() then fill again") {
+    obj.clear();
+    REQUIRE(obj[keyName(0)].isNull());
+
+    fill(obj, n);
+    for (int i = 0; i < n; i++)
+      REQUIRE(obj[keyName(i)] == i);
+  }
+
+  SECTION("many large objects") {
+    const int objectCount = ARDUINOJSON_MAX_OBJECT_INDEXES * 2;
+    JsonArray arr = doc.to<JsonArray>();
+    for (int i = 0; i < objectCount; i++)
+      fill(arr.add<JsonObject>(), n);
+
+    for (int j = 0; j < n; j++) {
+      for (int i = 0; i < objectCount; i++)
+        REQUIRE(arr[i][keyName(j)] == j);
+    }
+  }
+}
+
+TEST_CASE("deserializeJson() with a large object") {
+  const int n = 200;
+  std::string json = "{";
+  for (int i = 0; i < n; i++)
+    json += "\"" + keyName(i) + "\":" + std::to_string(i) + ",";
+  json += "\"" + keyName(n / 2) + "\":-1}";  // duplicate key
+
+  SECTION("keeps the last value of the duplicate key") {
+    JsonDocument doc;
+    deserializeJson(doc, json);
+
+    REQUIRE(doc.size() == n);
+    REQUIRE(doc[keyName(n / 2)] == -1);
+    REQUIRE(doc[keyName(n - 1)] == n - 1);
+  }
+
+  SECTION("lookups still work if the index can't be allocated") {
+    KillswitchAllocator allocator;
+    JsonDocument doc(&allocator);
+    deserializeJson(doc, json);  // shrinkToFit() destroys the index
+
+    allocator.on();
+
+    for (int i = 0; i < n; i++) {
+      if (i != n / 2)
+        REQUIRE(doc[keyName(i)] == i);
+    }
+    REQUIRE(doc["missing"].isNull());
+  }
+}
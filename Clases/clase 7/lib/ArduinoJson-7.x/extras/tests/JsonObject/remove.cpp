@@ -59,6 +59,24 @@ TEST_CASE("JsonObject::remove()") {
     }
   }
 
+  SECTION("consecutive members in a loop") {
+    obj["d"] = 3;
+    for (JsonObject::iterator it = obj.begin(); it != obj.end(); ++it) {
+      if (it->value() == 1 || it->value() == 2)
+        obj.remove(it);
+    }
+    serializeJson(obj, result);
+    REQUIRE("{\"a\":0,\"d\":3}" == result);
+  }
+
+  SECTION("all members in a loop") {
+    for (JsonObject::iterator it = obj.begin(); it != obj.end(); ++it)
+      obj.remove(it);
+    obj["e"] = 4;
+    serializeJson(obj, result);
+    REQUIRE("{\"e\":4}" == result);
+  }
+
 #ifdef HAS_VARIABLE_LENGTH_ARRAY
   SECTION("key is a vla") {
     size_t i = 16;
@@ -0,0 +1,68 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+TEST_CASE("JsonObject::removeIf()") {
+  JsonDocument doc;
+  JsonObject obj = doc.to<JsonObject>();
+  obj["a"] = 1;
+  obj["b"] = 2;
+  obj["c"] = 3;
+  obj["d"] = 4;
+
+  SECTION("removes the matching members") {
+    size_t n =
+        obj.removeIf([](JsonPair p) { return p.value().as<int>() % 2 == 0; });
+
+    REQUIRE(n == 2);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1,\"c\":3}");
+    REQUIRE(obj.size() == 2);
+  }
+
+  SECTION("by key") {
+    obj.removeIf([](JsonPair p) { return p.key() == "a" || p.key() == "b"; });
+
+    REQUIRE(doc.as<std::string>() == "{\"c\":3,\"d\":4}");
+    REQUIRE(obj["a"].isNull());
+    REQUIRE(obj["c"] == 3);
+  }
+
+  SECTION("all members") {
+    REQUIRE(obj.removeIf([](JsonPair) { return true; }) == 4);
+
+    obj["e"] = 5;
+    REQUIRE(doc.as<std::string>() == "{\"e\":5}");
+  }
+
+  SECTION("the last member") {
+    obj.removeIf([](JsonPair p) { return p.key() == "d"; });
+    obj["e"] = 5;
+
+    REQUIRE(doc.as<std::string>() == "{\"a\":1,\"b\":2,\"c\":3,\"e\":5}");
+  }
+
+  SECTION("a large object, which has an index") {
+    for (int i = 0; i < 100; i++)
+      obj[std::to_string(i)] = i;
+    REQUIRE(obj["50"] == 50);
+
+    obj.removeIf([](JsonPair p) {
+      return p.value().is<int>() && p.value().as<int>() >= 10;
+    });
+
+    REQUIRE(obj.size() == 14);
+    REQUIRE(obj["50"].isNull());
+    REQUIRE(obj["9"] == 9);
+    REQUIRE(obj["d"] == 4);
+  }
+
+  SECTION("unbound") {
+    JsonObject unbound;
+    REQUIRE(unbound.removeIf([](JsonPair) { return true; }) == 0);
+  }
+}
@@ -0,0 +1,286 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#define ARDUINOJSON_ENABLE_ARDUINO_STRING 1
+#define ARDUINOJSON_ENABLE_PROGMEM 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+using ArduinoJson::detail::WriterValidator;
+
+TEST_CASE("JsonWriter") {
+  std::string output;
+
+  SECTION("empty array") {
+    JsonWriter<std::string> writer(output);
+    writer.beginArray();
+    writer.endArray();
+    REQUIRE(output == "[]");
+  }
+
+  SECTION("empty object") {
+    JsonWriter<std::string> writer(output);
+    writer.beginObject();
+    writer.endObject();
+    REQUIRE(output == "{}");
+  }
+
+  SECTION("scalar root") {
+    JsonWriter<std::string> writer(output);
+    writer.value("hello");
+    REQUIRE(output == "\"hello\"");
+  }
+
+  SECTION("scalars") {
+    JsonWriter<std::string> writer(output);
+    writer.beginArray();
+    writer.value(true);
+    writer.value(false);
+    writer.value(nullptr);
+    writer.value(static_cast<const char*>(0));
+    writer.value(-42);
+    writer.value(uint8_t(255));
+    writer.value(int64_t(-9223372036854775807LL - 1));
+    writer.value(uint64_t(18446744073709551615ULL));
+    writer.value(3.14);
+    writer.value(0.1f);
+    writer.endArray();
+    REQUIRE(output ==
+            "[true,false,null,null,-42,255,-9223372036854775808,"
+            "18446744073709551615,3.14,0.1]");
+  }
+
+  SECTION("strings are escaped") {
+    JsonWriter<std::string> writer(output);
+    writer.beginObject();
+    writer.key("a\"b");
+    writer.value("line1\nline2\t\\");
+    writer.key(std::string("std::string"));
+    writer.value(std::string("x\0y", 3));
+    writer.key(JsonString("JsonString"));
+    writer.value(JsonString("z"));
+    writer.endObject();
+    REQUIRE(output ==
+            "{\"a\\\"b\":\"line1\\nline2\\t\\\\\","
+            "\"std::string\":\"x\\u0000y\","
+            "\"JsonString\":\"z\"}");
+  }
+
+  SECTION("null key") {
+    JsonWriter<std::string> writer(output);
+    writer.beginObject();
+    writer.key(static_cast<const char*>(0));
+    writer.value(1);
+    writer.endObject();
+    REQUIRE(output == "{\"\":1}");
+  }
+
+  SECTION("nested collections") {
+    JsonWriter<std::string> writer(output);
+    writer.beginObject();
+    writer.key("a");
+    writer.beginArray();
+    writer.beginArray();
+    writer.endArray();
+    writer.beginObject();
+    writer.key("b");
+    writer.beginObject();
+    writer.endObject();
+    writer.endObject();
+    writer.value(1);
+    writer.endArray();
+    writer.key("c");
+    writer.value(2);
+    writer.endObject();
+    REQUIRE(output == "{\"a\":[[],{\"b\":{}},1],\"c\":2}");
+  }
+
+  SECTION("JsonVariantConst") {
+    JsonDocument doc;
+    doc["x"][0] = 1;
+    doc["x"][1] = "two";
+
+    JsonWriter<std::string> writer(output);
+    writer.beginArray();
+    writer.value(doc);
+    writer.value(doc["x"]);
+    writer.value(doc["missing"]);
+    writer.endArray();
+    REQUIRE(output == "[{\"x\":[1,\"two\"]},[1,\"two\"],null]");
+  }
+
+  SECTION("same output as serializeJson()") {
+    JsonDocument doc;
+    doc["contents"][0]["parts"][0]["text"] = "Hello, \"world\"!\n";
+    doc["contents"][0]["role"] = "user";
+    doc["generationConfig"]["temperature"] = 0.7;
+    doc["generationConfig"]["maxOutputTokens"] = 256;
+    std::string expected;
+    serializeJson(doc, expected);
+
+    JsonWriter<std::string> writer(output);
+    writer.beginObject();
+    writer.key("contents");
+    writer.beginArray();
+    writer.beginObject();
+    writer.key("parts");
+    writer.beginArray();
+    writer.beginObject();
+    writer.key("text");
+    writer.value("Hello, \"world\"!\n");
+    writer.endObject();
+    writer.endArray();
+    writer.key("role");
+    writer.value("user");
+    writer.endObject();
+    writer.endArray();
+    writer.key("generationConfig");
+    writer.beginObject();
+    writer.key("temperature");
+    writer.value(0.7);
+    writer.key("maxOutputTokens");
+    writer.value(256);
+    writer.endObject();
+    writer.endObject();
+
+    REQUIRE(output == expected);
+  }
+
+  SECTION("the output is sent at the end of the root value") {
+    std::ostringstream stream;
+    JsonWriter<std::ostream> writer(stream);
+    writer.beginArray();
+    writer.value(1);
+    writer.beginArray();
+    writer.endArray();
+#if ARDUINOJSON_WRITE_BUFFER_SIZE
+    REQUIRE(stream.str() == "");
+#endif
+    writer.endArray();
+    REQUIRE(stream.str() == "[1,[]]");
+    REQUIRE(writer.flush() == 6);
+  }
+
+  SECTION("an end without a beginning") {
+    std::ostringstream stream;
+    JsonWriter<std::ostream> writer(stream);
+    writer.endArray();
+    REQUIRE(stream.str() == "]");
+
+    // the depth stays at 0, so the next root value is sent too
+    writer.beginArray();
+    writer.endArray();
+    REQUIRE(stream.str() == "],[]");
+  }
+
+  SECTION("::String") {
+    // Writer<::String> has its own buffer, which must be flushed too
+    ::String str;
+    JsonWriter<::String> writer(str);
+    writer.beginArray();
+    writer.value("a long string that doesn't fit in the buffer of the writer");
+    writer.endArray();
+    REQUIRE(str ==
+            "[\"a long string that doesn't fit in the buffer of the writer\"]");
+  }
+
+  SECTION("flush() sends an incomplete document") {
+    std::ostringstream stream;
+    JsonWriter<std::ostream> writer(stream);
+    writer.beginArray();
+    writer.value("a");
+    REQUIRE(writer.flush() == 4);
+    REQUIRE(stream.str() == "[\"a\"");
+  }
+
+  SECTION("long output") {
+    std::string expected = "[";
+    JsonWriter<std::string> writer(output);
+    writer.beginArray();
+    for (int i = 0; i < 1000; i++) {
+      writer.value(i);
+      expected += std::to_string(i) + ",";
+    }
+    writer.endArray();
+    expected.back() = ']';
+    REQUIRE(output == expected);
+    REQUIRE(writer.flush() == expected.size());
+  }
+}
+
+TEST_CASE("WriterValidator") {
+  WriterValidator validator;
+
+  SECTION("a single root value") {
+    REQUIRE(validator.isComplete() == false);
+    REQUIRE(validator.value() == true);
+    REQUIRE(validator.isComplete() == true);
+    REQUIRE(validator.value() == false);
+  }
+
+  SECTION("nested collections") {
+    REQUIRE(validator.beginCollection(true, WriterValidator::unknownSize));
+    REQUIRE(validator.key());
+    REQUIRE(validator.beginCollection(false, WriterValidator::unknownSize));
+    REQUIRE(validator.value());
+    REQUIRE(validator.value());
+    REQUIRE(validator.endCollection(false));
+    REQUIRE(validator.key());
+    REQUIRE(validator.value());
+    REQUIRE(validator.isComplete() == false);
+    REQUIRE(validator.endCollection(true));
+    REQUIRE(validator.isComplete() == true);
+  }
+
+  SECTION("key outside of an object") {
+    REQUIRE(validator.key() == false);
+    REQUIRE(validator.beginCollection(false, WriterValidator::unknownSize));
+    REQUIRE(validator.key() == false);
+  }
+
+  SECTION("value without a key") {
+    REQUIRE(validator.beginCollection(true, WriterValidator::unknownSize));
+    REQUIRE(validator.value() == false);
+  }
+
+  SECTION("two keys in a row") {
+    REQUIRE(validator.beginCollection(true, WriterValidator::unknownSize));
+    REQUIRE(validator.key());
+    REQUIRE(validator.key() == false);
+  }
+
+  SECTION("end of object after a key") {
+    REQUIRE(validator.beginCollection(true, WriterValidator::unknownSize));
+    REQUIRE(validator.key());
+    REQUIRE(validator.endCollection(true) == false);
+  }
+
+  SECTION("mismatched end") {
+    REQUIRE(validator.beginCollection(true, WriterValidator::unknownSize));
+    REQUIRE(validator.endCollection(false) == false);
+  }
+
+  SECTION("end without a beginning") {
+    REQUIRE(validator.endCollection(false) == false);
+  }
+
+  SECTION("announced size") {
+    REQUIRE(validator.beginCollection(false, 2));
+    REQUIRE(validator.value());
+    REQUIRE(validator.endCollection(false) == false);  // too few
+    REQUIRE(validator.value());
+    REQUIRE(validator.value() == false);  // too many
+    REQUIRE(validator.endCollection(false));
+  }
+
+  SECTION("too deep") {
+    for (int i = 0; i < 32; i++)
+      REQUIRE(validator.beginCollection(false, WriterValidator::unknownSize));
+    REQUIRE(validator.beginCollection(false, WriterValidator::unknownSize) ==
+            false);
+  }
+}
@@ -0,0 +1,202 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string.h>
+#include <string>
+
+#include "Allocators.hpp"
+
+// A chunk starts with a pointer and a size
+static size_t sizeofChunk(size_t capacity) {
+  return sizeof(void*) + sizeof(size_t) + capacity;
+}
+
+// A block starts with its size
+static size_t sizeofBlock(size_t n) {
+  return sizeof(size_t) + ArduinoJson::detail::addPadding(n);
+}
+
+TEST_CASE("ArenaAllocator") {
+  SpyingAllocator spy;
+  ArenaAllocator arena(256, &spy);
+
+  SECTION("allocates nothing upfront") {
+    REQUIRE(spy.log() == AllocatorLog{});
+    REQUIRE(arena.capacity() == 0);
+  }
+
+  SECTION("serves the blocks from one chunk") {
+    char* a = static_cast<char*>(arena.allocate(10));
+    char* b = static_cast<char*>(arena.allocate(20));
+    char* c = static_cast<char*>(arena.allocate(1));
+
+    REQUIRE(b == a + sizeofBlock(10));
+    REQUIRE(c == b + sizeofBlock(20));
+    REQUIRE(ArduinoJson::detail::isAligned(c));
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofChunk(256)),
+                         });
+  }
+
+  SECTION("allocates another chunk when full") {
+    arena.allocate(200);
+    arena.allocate(100);
+
+    REQUIRE(arena.capacity() == 512);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofChunk(256)),
+                             Allocate(sizeofChunk(256)),
+                         });
+  }
+
+  SECTION("allocates a larger chunk for a large block") {
+    arena.allocate(1000);
+
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofChunk(sizeofBlock(1000))),
+                         });
+  }
+
+  SECTION("deallocate() does nothing") {
+    void* a = arena.allocate(10);
+    arena.deallocate(a);
+    void* b = arena.allocate(10);
+
+    REQUIRE(b != a);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofChunk(256)),
+                         });
+  }
+
+  SECTION("reallocate()") {
+    SECTION("null") {
+      REQUIRE(arena.reallocate(nullptr, 10) != nullptr);
+    }
+
+    SECTION("the last block grows in place") {
+      arena.allocate(10);
+      char* p = static_cast<char*>(arena.allocate(10));
+      strcpy(p, "hello");
+
+      REQUIRE(arena.reallocate(p, 100) == p);
+      REQUIRE(arena.reallocate(p, 5) == p);
+      REQUIRE(strncmp(p, "hello", 5) == 0);
+
+      char* q = static_cast<char*>(arena.allocate(1));
+      REQUIRE(q == p + sizeofBlock(5));
+    }
+
+    SECTION("the last block moves when the chunk is full") {
+      char* p = static_cast<char*>(arena.allocate(10));
+      strcpy(p, "hello");
+
+      char* q = static_cast<char*>(arena.reallocate(p, 300));
+
+      REQUIRE(q != p);
+      REQUIRE(strcmp(q, "hello") == 0);
+    }
+
+    SECTION("another block is copied") {
+      char* p = static_cast<char*>(arena.allocate(10));
+      strcpy(p, "hello");
+      arena.allocate(10);
+
+      char* q = static_cast<char*>(arena.reallocate(p, 20));
+
+      REQUIRE(q != p);
+      REQUIRE(strcmp(q, "hello") == 0);
+    }
+
+    SECTION("another block shrinks in place") {
+      char* p = static_cast<char*>(arena.allocate(10));
+      arena.allocate(10);
+
+      REQUIRE(arena.reallocate(p, 5) == p);
+    }
+  }
+
+  SECTION("reset() reuses the chunks") {
+    arena.allocate(200);
+    void* a = arena.allocate(200);
+    arena.reset();
+    spy.clearLog();
+
+    arena.allocate(200);
+    void* b = arena.allocate(200);
+
+    REQUIRE(b == a);
+    REQUIRE(spy.log() == AllocatorLog{});
+  }
+
+  SECTION("reset() keeps the chunks too small for a large block") {
+    arena.allocate(10);
+    arena.reset();
+
+    arena.allocate(1000);
+    arena.allocate(10);
+
+    REQUIRE(arena.capacity() == 256 + sizeofBlock(1000) + 256);
+  }
+
+  SECTION("release()") {
+    arena.allocate(200);
+    arena.allocate(200);
+
+    arena.release();
+
+    REQUIRE(arena.capacity() == 0);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofChunk(256)),
+                             Allocate(sizeofChunk(256)),
+                             Deallocate(sizeofChunk(256)),
+                             Deallocate(sizeofChunk(256)),
+                         });
+  }
+
+  SECTION("out of memory") {
+    KillswitchAllocator killswitch;
+    ArenaAllocator arena2(256, &killswitch);
+    void* p = arena2.allocate(200);
+    killswitch.on();
+
+    REQUIRE(arena2.allocate(100) == nullptr);
+    REQUIRE(arena2.reallocate(p, 300) == nullptr);
+    REQUIRE(arena2.allocate(10) != nullptr);  // still room in the chunk
+  }
+}
+
+static std::string roundTrip(Allocator* allocator) {
+  JsonDocument request(allocator);
+  deserializeJson(request,
+                  "{\"model\":\"gemini\",\"contents\":[{\"role\":\"user\","
+                  "\"parts\":[{\"text\":\"Hello, how are you?\"}]}]}");
+  JsonDocument response(allocator);
+  response["text"] = request["contents"][0]["parts"][0]["text"];
+  response["role"] = std::string("model");
+  std::string output;
+  serializeJson(response, output);
+  return output;
+}
+
+TEST_CASE("ArenaAllocator with JsonDocument") {
+  SpyingAllocator spy;
+  ArenaAllocator arena(4096, &spy);
+
+  roundTrip(&arena);
+  arena.reset();
+  size_t capacity = arena.capacity();
+  spy.clearLog();
+
+  for (int i = 0; i < 3; i++) {
+    REQUIRE(roundTrip(&arena) ==
+            "{\"text\":\"Hello, how are you?\",\"role\":\"model\"}");
+    arena.reset();
+  }
+
+  REQUIRE(arena.capacity() == capacity);
+  REQUIRE(spy.log() == AllocatorLog{});
+}
@@ -0,0 +1,128 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace ArduinoJson::detail;
+
+// Records the size of each write and accepts at most `capacity` bytes
+class SpyingWriter {
+ public:
+  SpyingWriter(size_t capacity = 1000) : capacity_(capacity) {}
+
+  size_t write(uint8_t c) {
+    return write(&c, 1);
+  }
+
+  size_t write(const uint8_t* s, size_t n) {
+    writes.push_back(n);
+    if (n > capacity_ - str.size())
+      n = capacity_ - str.size();
+    str.append(reinterpret_cast<const char*>(s), n);
+    return n;
+  }
+
+  std::string str;
+  std::vector<size_t> writes;
+
+ private:
+  size_t capacity_;
+};
+
+static size_t print(BufferingDecorator<SpyingWriter, 4>& writer,
+                    const char* s) {
+  return writer.write(reinterpret_cast<const uint8_t*>(s), strlen(s));
+}
+
+TEST_CASE("BufferingDecorator") {
+  SpyingWriter spy;
+  BufferingDecorator<SpyingWriter, 4> writer(spy);
+
+  SECTION("keeps small writes until flush()") {
+    writer.write('a');
+    print(writer, "bc");
+
+    REQUIRE(spy.writes.empty());
+    REQUIRE(writer.flush() == 3);
+    REQUIRE(spy.str == "abc");
+    REQUIRE(spy.writes == std::vector<size_t>{3});
+  }
+
+  SECTION("forwards the buffer when it's full") {
+    print(writer, "abc");
+    print(writer, "de");
+    writer.write('f');
+    writer.write('g');
+    writer.write('h');
+
+    REQUIRE(spy.writes == std::vector<size_t>({3, 4}));
+    REQUIRE(writer.flush() == 8);
+    REQUIRE(spy.str == "abcdefgh");
+    REQUIRE(spy.writes == std::vector<size_t>({3, 4, 1}));
+  }
+
+  SECTION("forwards large writes directly") {
+    writer.write('a');
+    print(writer, "0123456789");
+
+    REQUIRE(spy.writes == std::vector<size_t>({1, 10}));
+    REQUIRE(writer.flush() == 11);
+    REQUIRE(spy.str == "a0123456789");
+  }
+
+  SECTION("flush() does nothing when the buffer is empty") {
+    REQUIRE(writer.flush() == 0);
+    REQUIRE(spy.writes.empty());
+  }
+
+  SECTION("flush() returns the number of bytes accepted by the writer") {
+    SpyingWriter smallSpy(5);
+    BufferingDecorator<SpyingWriter, 4> smallWriter(smallSpy);
+
+    print(smallWriter, "abc");
+    print(smallWriter, "def");
+
+    REQUIRE(smallWriter.flush() == 5);
+    REQUIRE(smallSpy.str == "abcde");
+  }
+}
+
+TEST_CASE("serializeJson() buffers the writes") {
+  JsonDocument doc;
+  doc["hello"] = "world";
+  doc["list"].add(1);
+  doc["list"].add(true);
+
+  SECTION("serializeJson()") {
+    SpyingWriter spy;
+
+    size_t n = serializeJson(doc, spy);
+
+    REQUIRE(spy.str == "{\"hello\":\"world\",\"list\":[1,true]}");
+    REQUIRE(n == spy.str.size());
+    REQUIRE(spy.writes == std::vector<size_t>{n});
+  }
+
+  SECTION("serializeMsgPack()") {
+    SpyingWriter spy;
+
+    size_t n = serializeMsgPack(doc, spy);
+
+    REQUIRE(n == measureMsgPack(doc));
+    REQUIRE(spy.writes == std::vector<size_t>{n});
+  }
+
+  SECTION("returns the number of bytes accepted by the destination") {
+    SpyingWriter spy(10);
+
+    size_t n = serializeJson(doc, spy);
+
+    REQUIRE(n == 10);
+    REQUIRE(spy.str == "{\"hello\":\"");
+  }
+}
@@ -0,0 +1,105 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "Allocators.hpp"
+
+using namespace ArduinoJson::detail;
+
+using PoolList = MemoryPoolList<VariantData>;
+
+TEST_CASE("MemoryPoolList") {
+  const size_t C = ARDUINOJSON_POOL_CAPACITY;
+  const size_t maxCapacity = ARDUINOJSON_MAX_POOL_CAPACITY;
+  PoolList pools;
+
+  SECTION("the capacity doubles until it reaches the maximum") {
+    for (size_t i = 0; i <= POOL_GROWTH_STEPS; i++)
+      REQUIRE(pools.poolCapacity(i) == C << i);
+    REQUIRE(pools.poolCapacity(POOL_GROWTH_STEPS) == maxCapacity);
+    REQUIRE(pools.poolCapacity(POOL_GROWTH_STEPS + 1) == maxCapacity);
+    REQUIRE(pools.poolCapacity(POOL_GROWTH_STEPS + 2) == maxCapacity);
+  }
+
+  SECTION("the pools are contiguous") {
+    REQUIRE(pools.poolStart(0) == 0);
+    for (size_t i = 0; i < POOL_GROWTH_STEPS + 4; i++)
+      REQUIRE(pools.poolStart(i + 1) ==
+              pools.poolStart(i) + pools.poolCapacity(i));
+  }
+
+  SECTION("poolIndexOf() finds the pool of the first and last ids") {
+    for (size_t i = 0; i < POOL_GROWTH_STEPS + 4; i++) {
+      auto start = pools.poolStart(i);
+      auto end = start + pools.poolCapacity(i);
+      REQUIRE(pools.poolIndexOf(start) == i);
+      REQUIRE(pools.poolIndexOf(start + 1) == i);
+      REQUIRE(pools.poolIndexOf(end - 1) == i);
+    }
+  }
+
+  SECTION("the last pool stops before NULL_SLOT") {
+    auto last = size_t(pools.maxPools() - 1);
+    REQUIRE(pools.poolStart(last) + pools.poolCapacity(last) == NULL_SLOT);
+    REQUIRE(pools.poolCapacity(last) <= maxCapacity);
+  }
+
+  SECTION("reserve() makes the first pool larger and shifts the others") {
+    SpyingAllocator spy;
+    const size_t first = 3 * C + 5;
+
+    REQUIRE(pools.reserve(first, &spy) == true);
+
+    REQUIRE(pools.poolCapacity(0) == first);
+    REQUIRE(pools.poolStart(1) == first);
+    REQUIRE(pools.poolIndexOf(first - 1) == 0);
+    for (size_t i = 1; i < POOL_GROWTH_STEPS + 4; i++) {
+      auto start = pools.poolStart(i);
+      auto end = start + pools.poolCapacity(i);
+      REQUIRE(pools.poolStart(i + 1) == end);
+      REQUIRE(pools.poolIndexOf(start) == i);
+      REQUIRE(pools.poolIndexOf(end - 1) == i);
+    }
+
+    pools.clear(&spy);
+
+    REQUIRE(pools.poolCapacity(0) == C);
+    REQUIRE(spy.log() == AllocatorLog{
+                             Allocate(sizeofPool(first)),
+                             Deallocate(sizeofPool(first)),
+                         });
+  }
+}
+
+TEST_CASE("MemoryPoolList in a JsonDocument") {
+  SpyingAllocator spy;
+  JsonDocument doc(&spy);
+  JsonArray array = doc.to<JsonArray>();
+
+  SECTION("allocates the pools in order") {
+    PoolList pools;
+    AllocatorLog expected;
+    size_t count = 0;
+    for (size_t i = 0; i < 4; i++) {
+      count += pools.poolCapacity(i);
+      expected.append(Allocate(sizeofPool(pools.poolCapacity(i))));
+    }
+
+    for (size_t i = 0; i < count; i++)
+      array.add(i);
+
+    REQUIRE(spy.log() == expected);
+  }
+
+  SECTION("reads the values back") {
+    for (int i = 0; i < 20000; i++)
+      array.add(i);
+
+    for (int i = 0; i < 20000; i += 7)
+      REQUIRE(array[size_t(i)] == i);
+    REQUIRE(array[19999] == 19999);
+  }
+}
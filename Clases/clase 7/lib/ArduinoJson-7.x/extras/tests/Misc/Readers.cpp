@@ -168,6 +168,39 @@ TEST_CASE("IteratorReader") {
   }
 }
 
+TEST_CASE("Reader<std::string>") {
+  SECTION("read()") {
+    std::string src("\x01\xFF");
+    Reader<std::string> reader(src);
+
+    REQUIRE(reader.read() == 0x01);
+    REQUIRE(reader.read() == 0xFF);
+    REQUIRE(reader.read() == -1);
+  }
+
+  SECTION("readBytes() in two parts") {
+    std::string src("ABCDEF");
+    Reader<std::string> reader(src);
+
+    char buffer[12] = "abcdefg";
+    REQUIRE(reader.readBytes(buffer, 4) == 4);
+    REQUIRE(reader.readBytes(buffer + 4, 4) == 2);
+
+    REQUIRE(buffer[0] == 'A');
+    REQUIRE(buffer[3] == 'D');
+    REQUIRE(buffer[5] == 'F');
+    REQUIRE(buffer[6] == 'g');
+  }
+
+  SECTION("exposes the buffer") {
+    std::string src("ABC");
+    Reader<std::string> reader(src);
+
+    REQUIRE(reader.ptr() == src.data());
+    REQUIRE(reader.end() == src.data() + 3);
+  }
+}
+
 class StreamStub : public Stream {
  public:
   StreamStub(const char* s) : stream_(s) {}
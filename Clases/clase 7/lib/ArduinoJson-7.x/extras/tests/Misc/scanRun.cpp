@@ -0,0 +1,171 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+using namespace ArduinoJson::detail;
+
+// Reference implementation: one character at a time
+static size_t expectedRunLength(const std::string& s, char stopChar) {
+  size_t i = 0;
+  while (i < s.size() && s[i] != stopChar && s[i] != '\\' && s[i] != '\0')
+    i++;
+  return i;
+}
+
+// Runs a block scanner, then finishes the job one character at a time
+template <typename TScanner>
+static size_t runLength(TScanner scanBlocks, const std::string& s,
+                        char stopChar) {
+  const char* begin = s.data();
+  const char* end = begin + s.size();
+  const char* p = scanBlocks(begin, end, stopChar);
+  REQUIRE(p >= begin);
+  REQUIRE(p <= end);
+  PlainStringChar predicate(stopChar);
+  for (const char* q = begin; q < p; q++)
+    REQUIRE(predicate(*q));  // must not skip a special character
+  while (p != end && predicate(*p))
+    p++;
+  return size_t(p - begin);
+}
+
+static const char* scanBlocksDefault(const char* p, const char* end,
+                                     char stopChar) {
+  return scanRun(p, end, PlainStringChar(stopChar));
+}
+
+template <typename TScanner>
+static void testScanner(TScanner scanBlocks) {
+  const char specials[] = {'"', '\'', '\\', '\0'};
+  const char stopChars[] = {'"', '\''};
+
+  for (char stopChar : stopChars) {
+    for (size_t length = 0; length <= 70; length++) {
+      // filler includes non-ASCII bytes
+      std::string plain;
+      for (size_t i = 0; i < length; i++)
+        plain += "a\xC3\xA9 z~\x7F\x80\xFF"[i % 9];
+
+      CAPTURE(stopChar, length);
+      REQUIRE(runLength(scanBlocks, plain, stopChar) ==
+              expectedRunLength(plain, stopChar));
+
+      for (size_t pos = 0; pos < length; pos++) {
+        for (char special : specials) {
+          std::string s = plain;
+          s[pos] = special;
+          CAPTURE(pos, int(special));
+          REQUIRE(runLength(scanBlocks, s, stopChar) ==
+                  expectedRunLength(s, stopChar));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("scanRun()") {
+  SECTION("PlainStringChar") {
+    testScanner(scanBlocksDefault);
+  }
+
+#if ARDUINOJSON_ENABLE_SIMD
+  SECTION("SWAR") {
+    testScanner(scanBlocksSwar);
+  }
+#endif
+
+#if ARDUINOJSON_SCAN_SSE2
+  SECTION("SSE2") {
+    testScanner(scanBlocksSse2);
+  }
+#endif
+
+#if ARDUINOJSON_SCAN_NEON
+  SECTION("NEON") {
+    testScanner(scanBlocksNeon);
+  }
+#endif
+}
+
+// Runs a verbatim block scanner, then finishes one character at a time
+template <typename TScanner>
+static size_t verbatimRunLength(TScanner scanBlocks, const std::string& s) {
+  const char* begin = s.data();
+  const char* end = begin + s.size();
+  const char* p = scanBlocks(begin, end);
+  REQUIRE(p >= begin);
+  REQUIRE(p <= end);
+  VerbatimChar predicate;
+  for (const char* q = begin; q < p; q++)
+    REQUIRE(predicate(*q));  // must not skip a special character
+  while (p != end && predicate(*p))
+    p++;
+  return size_t(p - begin);
+}
+
+static size_t expectedVerbatimRunLength(const std::string& s) {
+  size_t i = 0;
+  while (i < s.size() && static_cast<unsigned char>(s[i]) >= 0x20 &&
+         s[i] != '"' && s[i] != '\\')
+    i++;
+  return i;
+}
+
+static const char* scanVerbatimBlocksDefault(const char* p, const char* end) {
+  return scanRun(p, end, VerbatimChar());
+}
+
+template <typename TScanner>
+static void testVerbatimScanner(TScanner scanBlocks) {
+  const char specials[] = {'"', '\\', '\0', '\x01', '\n', '\x1F'};
+
+  for (size_t length = 0; length <= 70; length++) {
+    // filler includes non-ASCII bytes and the boundaries of the ranges
+    std::string plain;
+    for (size_t i = 0; i < length; i++)
+      plain += "a\xC3\xA9 z~\x7F\x80\xFF!#[]"[i % 13];
+
+    CAPTURE(length);
+    REQUIRE(verbatimRunLength(scanBlocks, plain) ==
+            expectedVerbatimRunLength(plain));
+
+    for (size_t pos = 0; pos < length; pos++) {
+      for (char special : specials) {
+        std::string s = plain;
+        s[pos] = special;
+        CAPTURE(pos, int(special));
+        REQUIRE(verbatimRunLength(scanBlocks, s) ==
+                expectedVerbatimRunLength(s));
+      }
+    }
+  }
+}
+
+TEST_CASE("scanRun(VerbatimChar)") {
+  SECTION("VerbatimChar") {
+    testVerbatimScanner(scanVerbatimBlocksDefault);
+  }
+
+#if ARDUINOJSON_ENABLE_SIMD
+  SECTION("SWAR") {
+    testVerbatimScanner(scanVerbatimBlocksSwar);
+  }
+#endif
+
+#if ARDUINOJSON_SCAN_SSE2
+  SECTION("SSE2") {
+    testVerbatimScanner(scanVerbatimBlocksSse2);
+  }
+#endif
+
+#if ARDUINOJSON_SCAN_NEON
+  SECTION("NEON") {
+    testVerbatimScanner(scanVerbatimBlocksNeon);
+  }
+#endif
+}
@@ -10,3 +10,11 @@ TEST_CASE("ARDUINOJSON_DECODE_UNICODE == 0") {
   REQUIRE(err == DeserializationError::Ok);
   REQUIRE(doc.as<std::string>() == "\\uD834\\uDD1E");
 }
+
+TEST_CASE("ARDUINOJSON_DECODE_UNICODE == 0 in JsonStreamParser") {
+  JsonDocument doc;
+  JsonStreamParser parser(doc);
+  REQUIRE(parser.feed("\"\\u") == DeserializationError::IncompleteInput);
+  REQUIRE(parser.feed("D834\\uDD1E\"") == DeserializationError::Ok);
+  REQUIRE(doc.as<std::string>() == "\\uD834\\uDD1E");
+}
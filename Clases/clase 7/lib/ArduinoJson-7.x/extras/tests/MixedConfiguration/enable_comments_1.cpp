@@ -409,3 +409,42 @@ TEST_CASE("Comments alone") {
     REQUIRE(err == DeserializationError::IncompleteInput);
   }
 }
+
+TEST_CASE("Comments in JsonStreamParser") {
+  JsonDocument doc;
+
+  SECTION("split at every position") {
+    const char* input =
+        "/* a */ {// b\n\"x\" /**/ : /*c*/ [ 1 // d\n, 2 /* e ** f */ ] } ";
+    size_t length = strlen(input);
+    for (size_t i = 0; i <= length; i++) {
+      CAPTURE(i);
+      JsonStreamParser parser(doc);
+      parser.feed(input, i);
+      REQUIRE(parser.feed(input + i, length - i) == DeserializationError::Ok);
+      REQUIRE(doc["x"][1] == 2);
+    }
+  }
+
+  SECTION("ends in a comment") {
+    const char* inputs[] = {"/", "// comment", "/* comment", "/* comment *"};
+    DeserializationError errors[] = {
+        DeserializationError::InvalidInput,
+        DeserializationError::IncompleteInput,
+        DeserializationError::IncompleteInput,
+        DeserializationError::IncompleteInput,
+    };
+    for (int i = 0; i < 4; i++) {
+      JsonStreamParser parser(doc);
+      parser.feed(inputs[i]);
+      REQUIRE(parser.finish() == errors[i]);
+      REQUIRE(deserializeJson(doc, inputs[i]) == errors[i]);
+    }
+  }
+
+  SECTION("just a comment") {
+    JsonStreamParser parser(doc);
+    REQUIRE(parser.feed("/*comment*/") == DeserializationError::IncompleteInput);
+    REQUIRE(parser.finish() == DeserializationError::EmptyInput);
+  }
+}
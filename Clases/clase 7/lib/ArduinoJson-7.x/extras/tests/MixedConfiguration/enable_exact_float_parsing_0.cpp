@@ -0,0 +1,38 @@
+#define ARDUINOJSON_VERSION_NAMESPACE ApproximateFloatParsing
+#define ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING == 0") {
+  JsonDocument doc;
+
+  SECTION("float") {
+    deserializeJson(doc, "[3.14,-0.5,1e-38]");
+
+    REQUIRE(doc[0].as<float>() == Approx(3.14f));
+    REQUIRE(doc[1].as<float>() == -0.5f);
+    REQUIRE(doc[2].as<float>() == Approx(1e-38f));
+  }
+
+  SECTION("double") {
+    deserializeJson(doc, "[3.14159265358979,1.7976931348623157e308]");
+
+    REQUIRE(doc[0].as<double>() == Approx(3.14159265358979));
+    REQUIRE(doc[1].as<double>() == Approx(1.7976931348623157e308));
+  }
+
+  SECTION("many digits") {
+    deserializeJson(doc, "3.14159265358979323846264338327950288");
+
+    REQUIRE(doc.as<double>() == Approx(3.14159265358979));
+  }
+
+  SECTION("exponent out of range") {
+    deserializeJson(doc, "[1e-400,0.0000000001e-320,1e400]");
+
+    REQUIRE(doc[0].as<double>() == 0.0);
+    REQUIRE(doc[1].as<double>() == 0.0);
+    REQUIRE(doc[2].as<double>() > 1.7976931348623157e308);
+  }
+}
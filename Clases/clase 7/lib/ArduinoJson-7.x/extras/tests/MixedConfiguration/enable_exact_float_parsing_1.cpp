@@ -0,0 +1,42 @@
+#define ARDUINOJSON_VERSION_NAMESPACE ExactFloatParsing
+#define ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+#include <sstream>
+
+TEST_CASE("ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING == 1") {
+  JsonDocument doc;
+
+  SECTION("nearest double") {
+    DeserializationError err =
+        deserializeJson(doc, "[5.317802434545401e-255,0.30000000000000004,"
+                             "9007199254740993.0]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0].as<double>() == 5.317802434545401e-255);
+    REQUIRE(doc[1].as<double>() == 0.30000000000000004);
+    REQUIRE(doc[2].as<double>() == 9007199254740992.0);
+  }
+
+  SECTION("same value from a stream") {
+    const char* input = "[3.14159265358979323846,-2.2250738585072011e-308]";
+    JsonDocument doc2;
+    std::istringstream stream(input);
+
+    REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+    REQUIRE(deserializeJson(doc2, stream) == DeserializationError::Ok);
+    REQUIRE(doc[0].as<double>() == 3.14159265358979323846);
+    REQUIRE(doc[1].as<double>() == -2.2250738585072011e-308);
+    REQUIRE(doc2[0].as<double>() == doc[0].as<double>());
+    REQUIRE(doc2[1].as<double>() == doc[1].as<double>());
+  }
+
+  SECTION("the truncated mantissa is UINT64_MAX") {
+    DeserializationError err = deserializeJson(doc, "184467440737095516151");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<double>() == 1.8446744073709552e20);
+  }
+}
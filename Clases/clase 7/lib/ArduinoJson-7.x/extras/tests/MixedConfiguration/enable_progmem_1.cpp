@@ -50,6 +50,28 @@ TEST_CASE("Flash strings") {
   }
 }
 
+TEST_CASE("JsonWriter and MsgPackWriter with Flash strings") {
+  std::string output;
+
+  SECTION("JsonWriter") {
+    JsonWriter<std::string> writer(output);
+    writer.beginObject();
+    writer.key(F("hello"));
+    writer.value(F("wor\"ld"));
+    writer.endObject();
+    REQUIRE(output == "{\"hello\":\"wor\\\"ld\"}");
+  }
+
+  SECTION("MsgPackWriter") {
+    MsgPackWriter<std::string> writer(output);
+    writer.beginObject(1);
+    writer.key(F("hello"));
+    writer.value(F("world"));
+    writer.endObject();
+    REQUIRE(output == "\x81\xA5hello\xA5world");
+  }
+}
+
 TEST_CASE("parseNumber()") {  // tables are in Flash
   using ArduinoJson::detail::parseNumber;
 
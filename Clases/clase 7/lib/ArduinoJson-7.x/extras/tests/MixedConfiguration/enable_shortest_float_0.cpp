@@ -0,0 +1,16 @@
+#define ARDUINOJSON_ENABLE_SHORTEST_FLOAT 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_SHORTEST_FLOAT == 0") {
+  JsonDocument doc;
+
+  doc["pi"] = 3.14159265358979;
+  doc["tenth"] = 0.1f;
+
+  std::string json;
+  serializeJson(doc, json);
+
+  REQUIRE(json == "{\"pi\":3.141592654,\"tenth\":0.1}");
+}
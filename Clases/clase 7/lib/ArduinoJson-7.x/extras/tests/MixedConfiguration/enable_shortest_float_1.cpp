@@ -0,0 +1,98 @@
+#define ARDUINOJSON_VERSION_NAMESPACE ShortestFloat
+#define ARDUINOJSON_ENABLE_SHORTEST_FLOAT 1
+#define ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING 1  // for the round trip
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+#include <string.h>
+#include <string>
+
+using namespace ArduinoJson::detail;
+
+template <typename T>
+static std::string serialize(T value) {
+  JsonDocument doc;
+  doc.set(value);
+  std::string json;
+  serializeJson(doc, json);
+  return json;
+}
+
+static std::string formatFloat(float value) {
+  char output[32];
+  StaticStringWriter writer(output, sizeof(output) - 1);
+  TextFormatter<StaticStringWriter> formatter(writer);
+  formatter.writeFloat(value);
+  output[formatter.bytesWritten()] = 0;
+  return output;
+}
+
+// Checks the floats whose bits are first, first + step, first + 2 * step...
+static void checkFloatRoundTrip(uint32_t first, uint32_t step) {
+  const uint32_t infinityBits = 0x7F800000;
+  for (uint64_t bits = first; bits < infinityBits; bits += step) {
+    float value;
+    uint32_t bits32 = uint32_t(bits);
+    memcpy(&value, &bits32, sizeof(value));
+
+    std::string output = formatFloat(value);
+    float result = parseNumber<float>(output.c_str());
+    if (result != value) {
+      CAPTURE(bits32);
+      CAPTURE(output);
+      REQUIRE(result == value);
+    }
+  }
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_SHORTEST_FLOAT == 1") {
+  SECTION("double") {
+    CHECK(serialize(0.0) == "0");
+    CHECK(serialize(-0.0) == "0");
+    CHECK(serialize(1.0) == "1");
+    CHECK(serialize(0.1) == "0.1");
+    CHECK(serialize(-0.3) == "-0.3");
+    CHECK(serialize(3.14159265358979) == "3.14159265358979");
+    CHECK(serialize(1.0000000000000002) == "1.0000000000000002");
+    CHECK(serialize(123.456) == "123.456");
+    CHECK(serialize(1500.0) == "1500");
+    CHECK(serialize(9999999.0) == "9999999");
+    CHECK(serialize(0.000123) == "0.000123");
+  }
+
+  SECTION("double in exponent notation") {
+    CHECK(serialize(1e7) == "1e7");
+    CHECK(serialize(1e23) == "1e23");
+    CHECK(serialize(123456789.0) == "1.23456789e8");
+    CHECK(serialize(1e-5) == "1e-5");
+    CHECK(serialize(-2.5e-10) == "-2.5e-10");
+    CHECK(serialize(1.7976931348623157e308) == "1.7976931348623157e308");
+    CHECK(serialize(2.2250738585072014e-308) == "2.2250738585072014e-308");
+    CHECK(serialize(5e-324) == "5e-324");
+  }
+
+  SECTION("float") {
+    CHECK(serialize(0.1f) == "0.1");
+    CHECK(serialize(3.14f) == "3.14");
+    CHECK(serialize(-1.5f) == "-1.5");
+    CHECK(serialize(16777216.0f) == "1.6777216e7");
+    CHECK(serialize(3.4028235e38f) == "3.4028235e38");
+    CHECK(serialize(1.17549435e-38f) == "1.1754944e-38");
+    CHECK(serialize(1e-45f) == "1e-45");
+  }
+
+  SECTION("integers are not affected") {
+    CHECK(serialize(1234567890) == "1234567890");
+  }
+
+  SECTION("float round trip (sample)") {
+    checkFloatRoundTrip(1, 9973);
+  }
+}
+
+// Takes several minutes, run with: MixedConfigurationTests "[exhaustive]"
+TEST_CASE("ARDUINOJSON_ENABLE_SHORTEST_FLOAT round trips every float",
+          "[.][exhaustive]") {
+  checkFloatRoundTrip(1, 1);
+}
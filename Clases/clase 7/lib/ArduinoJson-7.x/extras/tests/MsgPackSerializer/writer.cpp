@@ -0,0 +1,111 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+#include "Literals.hpp"
+
+TEST_CASE("MsgPackWriter") {
+  std::string output;
+
+  SECTION("empty array") {
+    MsgPackWriter<std::string> writer(output);
+    writer.beginArray(0);
+    writer.endArray();
+    REQUIRE(output == "\x90");
+  }
+
+  SECTION("empty object") {
+    MsgPackWriter<std::string> writer(output);
+    writer.beginObject(0);
+    writer.endObject();
+    REQUIRE(output == "\x80");
+  }
+
+  SECTION("scalars") {
+    MsgPackWriter<std::string> writer(output);
+    writer.beginArray(9);
+    writer.value(true);
+    writer.value(false);
+    writer.value(nullptr);
+    writer.value(-1);
+    writer.value(uint16_t(0x1234));
+    writer.value(-0x1234);
+    writer.value(1.5f);
+    writer.value(3.0);
+    writer.value("hi");
+    writer.endArray();
+    REQUIRE(output ==
+            "\x99\xC3\xC2\xC0\xFF\xCD\x12\x34\xD1\xED\xCC"
+            "\xCA\x3F\xC0\x00\x00\x03\xA2hi"_s);
+  }
+
+  SECTION("large headers") {
+    MsgPackWriter<std::string> writer(output);
+    writer.beginObject(16);
+    for (int i = 0; i < 16; i++) {
+      writer.key(std::string(1, char('a' + i)));
+      writer.value(std::string(32, 'x'));
+    }
+    writer.endObject();
+    REQUIRE(output.substr(0, 3) == "\xDE\x00\x10"_s);
+    REQUIRE(output.substr(3, 4) == "\xA1"
+                                   "a\xD9\x20"_s);
+    REQUIRE(output.size() == 3 + 16 * (2 + 2 + 32));
+  }
+
+  SECTION("same output as serializeMsgPack()") {
+    JsonDocument doc;
+    doc["contents"][0]["parts"][0]["text"] = "Hello, world!";
+    doc["contents"][0]["role"] = "user";
+    doc["generationConfig"]["temperature"] = 0.7;
+    doc["generationConfig"]["maxOutputTokens"] = 256;
+    std::string expected;
+    serializeMsgPack(doc, expected);
+
+    MsgPackWriter<std::string> writer(output);
+    writer.beginObject(2);
+    writer.key("contents");
+    writer.beginArray(1);
+    writer.beginObject(2);
+    writer.key("parts");
+    writer.beginArray(1);
+    writer.beginObject(1);
+    writer.key("text");
+    writer.value("Hello, world!");
+    writer.endObject();
+    writer.endArray();
+    writer.key("role");
+    writer.value("user");
+    writer.endObject();
+    writer.endArray();
+    writer.key("generationConfig");
+    writer.beginObject(2);
+    writer.key("temperature");
+    writer.value(0.7);
+    writer.key("maxOutputTokens");
+    writer.value(256);
+    writer.endObject();
+    writer.endObject();
+
+    REQUIRE(output == expected);
+    REQUIRE(writer.flush() == expected.size());
+  }
+
+  SECTION("JsonVariantConst") {
+    JsonDocument doc;
+    doc["x"] = 1;
+
+    MsgPackWriter<std::string> writer(output);
+    writer.beginArray(2);
+    writer.value(doc);
+    writer.value(doc["missing"]);
+    writer.endArray();
+    REQUIRE(output == "\x92\x81\xA1x\x01\xC0"_s);
+    REQUIRE(writer.flush() == 6);
+  }
+}
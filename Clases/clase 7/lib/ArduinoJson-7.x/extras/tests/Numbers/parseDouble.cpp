@@ -9,6 +9,10 @@
 #include <ArduinoJson.hpp>
 #include <catch.hpp>
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 using namespace ArduinoJson::detail;
 
 void checkDouble(const char* input, double expected) {
@@ -16,6 +20,11 @@ void checkDouble(const char* input, double expected) {
   REQUIRE(parseNumber<double>(input) == Approx(expected));
 }
 
+void checkExactDouble(const char* input, double expected) {
+  CAPTURE(input);
+  REQUIRE(parseNumber<double>(input) == expected);
+}
+
 void checkDoubleNaN(const char* input) {
   CAPTURE(input);
   double result = parseNumber<double>(input);
@@ -89,8 +98,101 @@ TEST_CASE("parseNumber<double>()") {
     checkDouble("1e-65535", 0.0);
   }
 
+  SECTION("Nearest") {
+    checkExactDouble("5.317802434545401e-255", 5.317802434545401e-255);
+    checkExactDouble("0.30000000000000004", 0.30000000000000004);
+    checkExactDouble("1e300", 1e300);
+    checkExactDouble("8.98846567431158e307", 8.98846567431158e307);
+    checkExactDouble("1.7976931348623157e308", 1.7976931348623157e308);
+    checkExactDouble("2.2250738585072014e-308", 2.2250738585072014e-308);
+  }
+
+  SECTION("Halfway") {
+    // 2^53 + 1 is halfway between 2^53 and 2^53 + 2, round to even
+    checkExactDouble("9007199254740993", 9007199254740992.0);
+    checkExactDouble("9007199254740993.0", 9007199254740992.0);
+    checkExactDouble("9007199254740995", 9007199254740996.0);
+    // a digit far away decides
+    checkExactDouble("9007199254740993.00000000000000000000000000001",
+                     9007199254740994.0);
+    // halfway between 1 and the next double
+    checkExactDouble("1.00000000000000011102230246251565404236316680908203125",
+                     1.0);
+    checkExactDouble("1.00000000000000011102230246251565404236316680908203126",
+                     1.0000000000000002);
+  }
+
+  SECTION("Subnormal") {
+    checkExactDouble("2.2250738585072011e-308", 2.2250738585072009e-308);
+    checkExactDouble("4.9406564584124654e-324", 4.9406564584124654e-324);
+    checkExactDouble("2.4703282292062327e-324", 0.0);
+    checkExactDouble("2.4703282292062328e-324", 4.9406564584124654e-324);
+  }
+
+  SECTION("MoreThan19Digits") {
+    checkExactDouble("3.14159265358979323846264338327950288",
+                     3.14159265358979323846264338327950288);
+    checkExactDouble("123456789012345678901234567890", 1.2345678901234568e29);
+    checkExactDouble("0.000000000000000000000000000000000000001e39", 1.0);
+  }
+
+  SECTION("MantissaIsUint64Max") {
+    checkExactDouble("184467440737095516151", 1.8446744073709552e20);
+    checkExactDouble("18446744073709551615.9", 1.8446744073709552e19);
+    checkExactDouble("18446744073709551615e288", 1.8446744073709552e307);
+  }
+
+  SECTION("EightDigitsAtATime") {
+    checkExactDouble("1234567.8", 1234567.8);
+    checkExactDouble("12345678.9", 12345678.9);
+    checkExactDouble("0.12345678", 0.12345678);
+    checkExactDouble("0.123456789", 0.123456789);
+    checkExactDouble("1234567890123456.7", 1234567890123456.7);
+    checkExactDouble("12345678e-8", 0.12345678);
+    checkExactDouble("00000000.000000001234567891", 1.234567891e-9);
+  }
+
   SECTION("NaN") {
     checkDoubleNaN("NaN");
     checkDoubleNaN("nan");
   }
 }
+
+// A xorshift generator, to get the same numbers on every platform
+static uint64_t nextRandom(uint64_t& state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+// Short mantissas are parsed as float, so they are compared with strtof()
+TEST_CASE("parseNumber() returns the same values as strtod() and strtof()") {
+  uint64_t state = 0x9E3779B97F4A7C15;
+  char input[64];
+
+  for (int i = 0; i < 100000; i++) {
+    uint64_t bits = nextRandom(state);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    if (value != value || value - value != 0)  // NaN or infinity
+      continue;
+
+    int precision = 1 + int(bits % 17);
+    snprintf(input, sizeof(input), "%.*g", precision, value);
+    CAPTURE(input);
+
+    auto result = parseNumber(input);
+    if (result.type() == NumberType::Float) {
+      float expected = strtof(input, NULL);
+      float actual = result.asFloat();
+      if (memcmp(&actual, &expected, sizeof(float)) != 0)
+        REQUIRE(actual == expected);
+    } else if (result.type() == NumberType::Double) {
+      double expected = strtod(input, NULL);
+      double actual = result.asDouble();
+      if (memcmp(&actual, &expected, sizeof(double)) != 0)
+        REQUIRE(actual == expected);
+    }
+  }
+}
@@ -17,6 +17,13 @@ void checkFloat(const char* input, float expected) {
   REQUIRE(result.asFloat() == Approx(expected));
 }
 
+void checkExactFloat(const char* input, float expected) {
+  CAPTURE(input);
+  auto result = parseNumber(input);
+  REQUIRE(result.type() == NumberType::Float);
+  REQUIRE(result.asFloat() == expected);
+}
+
 void checkFloatNaN(const char* input) {
   CAPTURE(input);
   float result = parseNumber<float>(input);
@@ -58,6 +65,18 @@ TEST_CASE("parseNumber<float>()") {
     checkFloat("0.003402823e+41", 3.402823e+38f);
   }
 
+  SECTION("Nearest") {
+    checkExactFloat("0.6387707", 0.6387707f);
+    checkExactFloat("0.500472", 0.500472f);
+    checkExactFloat("0.1", 0.1f);
+    checkExactFloat("3.402823e+38", 3.402823e+38f);
+    checkExactFloat("3.14159e-30", 3.14159e-30f);
+  }
+
+  SECTION("MantissaIsUint64Max") {
+    REQUIRE(parseNumber<float>("184467440737095516151") == 1.8446744e20f);
+  }
+
   SECTION("VeryLong") {
     checkFloat("0.00000000000000000000000000000001", 1e-32f);
 
@@ -66,3 +66,17 @@ TEST_CASE("parseNumber<uint16_t>()") {
   checkInteger<uint16_t>("-1", 0);
   checkInteger<uint16_t>("65536", 0);
 }
+
+TEST_CASE("parseNumber<uint64_t>()") {
+  checkInteger<uint64_t>("12345678", 12345678);
+  checkInteger<uint64_t>("123456789", 123456789);
+  checkInteger<uint64_t>("1234567890123456", 1234567890123456);
+  checkInteger<uint64_t>("12345678901234567", 12345678901234567);
+  checkInteger<uint64_t>("1234567890123456789", 1234567890123456789);
+  checkInteger<uint64_t>("12345678901234567890", 12345678901234567890U);
+  checkInteger<uint64_t>("18446744073709551615", 18446744073709551615U);
+  checkInteger<uint64_t>("00000000000000000042", 42);
+  checkInteger<uint64_t>("1234567x", 0);
+  checkInteger<uint64_t>("12345678x", 0);
+  checkInteger<uint64_t>("18446744073709551616", 0);  // overflow
+}
@@ -6,6 +6,8 @@
 #include <ArduinoJson/Strings/StringAdapters.hpp>
 #include <catch.hpp>
 
+#include <string>
+
 #include "Allocators.hpp"
 
 using namespace ArduinoJson::detail;
@@ -67,4 +69,79 @@ TEST_CASE("ResourceManager::saveString()") {
     ResourceManager pool2(FailingAllocator::instance());
     REQUIRE(saveString(pool2, "a") == nullptr);
   }
+
+  SECTION("Deduplicates many strings") {
+    char s[16];
+    StringNode* nodes[200];
+    for (int i = 0; i < 200; i++) {
+      snprintf(s, sizeof(s), "string%d", i);
+      nodes[i] = saveString(resources, s);
+    }
+    for (int i = 0; i < 200; i++) {
+      snprintf(s, sizeof(s), "string%d", i);
+      REQUIRE(saveString(resources, s) == nodes[i]);
+      REQUIRE(nodes[i]->references == 2);
+    }
+  }
+
+  SECTION("Distinguishes long strings that differ in the middle") {
+    std::string a(200, 'x'), b(200, 'x');
+    b[100] = 'y';
+    REQUIRE(stringHash(adaptString(a)) != stringHash(adaptString(b)));
+
+    auto na = saveString(resources, a.c_str());
+    auto nb = saveString(resources, b.c_str());
+    REQUIRE(na != nb);
+    REQUIRE(saveString(resources, b.c_str()) == nb);
+    REQUIRE(nb->references == 2);
+  }
+
+  SECTION("Deduplicates many long strings that differ in the middle") {
+    std::string s(200, 'x');
+    StringNode* nodes[40];
+    for (int i = 0; i < 40; i++) {
+      s[100] = char('0' + i);
+      nodes[i] = saveString(resources, s.c_str());
+    }
+    for (int i = 0; i < 40; i++) {
+      s[100] = char('0' + i);
+      REQUIRE(saveString(resources, s.c_str()) == nodes[i]);
+      REQUIRE(nodes[i]->references == 2);
+    }
+  }
+}
+
+TEST_CASE("ResourceManager::dereferenceString()") {
+  SpyingAllocator spy;
+  ResourceManager resources(&spy);
+  char s[16];
+  StringNode* nodes[200];
+  for (int i = 0; i < 200; i++) {
+    snprintf(s, sizeof(s), "string%d", i);
+    nodes[i] = saveString(resources, s);
+  }
+
+  SECTION("Keeps strings that are still referenced") {
+    auto node = saveString(resources, "string42");
+    resources.dereferenceString(node);
+    REQUIRE(node->references == 1);
+    REQUIRE(resources.getString(adaptString("string42")) == node);
+  }
+
+  SECTION("Releases all strings") {
+    for (int i = 0; i < 200; i += 2)
+      resources.dereferenceString(nodes[i]);
+    for (int i = 1; i < 200; i += 2) {
+      snprintf(s, sizeof(s), "string%d", i);
+      REQUIRE(resources.getString(adaptString(s)) == nodes[i]);
+      snprintf(s, sizeof(s), "string%d", i - 1);
+      REQUIRE(resources.getString(adaptString(s)) == nullptr);
+    }
+    for (int i = 1; i < 200; i += 2)
+      resources.dereferenceString(nodes[i]);
+
+    REQUIRE(resources.size() == 0);
+    resources.clear();
+    REQUIRE(spy.allocatedBytes() == 0);
+  }
 }
@@ -53,3 +53,27 @@ TEST_CASE("uint32_t") {
   checkWriteInteger<uint32_t>(0, "0");
   checkWriteInteger<uint32_t>(4294967295U, "4294967295");
 }
+
+TEST_CASE("int64_t") {
+  checkWriteInteger<int64_t>(0, "0");
+  checkWriteInteger<int64_t>(-9223372036854775807LL - 1,
+                             "-9223372036854775808");
+  checkWriteInteger<int64_t>(9223372036854775807LL, "9223372036854775807");
+}
+
+TEST_CASE("uint64_t") {
+  checkWriteInteger<uint64_t>(0, "0");
+  checkWriteInteger<uint64_t>(18446744073709551615ULL,
+                              "18446744073709551615");
+}
+
+TEST_CASE("writeInteger() writes two digits at a time") {
+  checkWriteInteger<uint32_t>(7, "7");
+  checkWriteInteger<uint32_t>(10, "10");
+  checkWriteInteger<uint32_t>(99, "99");
+  checkWriteInteger<uint32_t>(100, "100");
+  checkWriteInteger<uint32_t>(1005, "1005");
+  checkWriteInteger<uint32_t>(12345, "12345");
+  checkWriteInteger<uint32_t>(100000, "100000");
+  checkWriteInteger<uint32_t>(9080706, "9080706");
+}
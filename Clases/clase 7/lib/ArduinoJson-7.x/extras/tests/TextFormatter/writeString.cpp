@@ -4,6 +4,8 @@
 
 #include <catch.hpp>
 
+#include <string>
+
 #include <ArduinoJson/Json/TextFormatter.hpp>
 #include <ArduinoJson/Serialization/Writers/StaticStringWriter.hpp>
 
@@ -54,4 +56,88 @@ TEST_CASE("TextFormatter::writeString()") {
   SECTION("HorizontalTab") {
     check("\t", "\"\\t\"");
   }
+
+  SECTION("Other control characters are not escaped") {
+    check("\x01\x1F", "\"\x01\x1F\"");
+  }
+
+  SECTION("Non-ASCII characters are not escaped") {
+    check("\xC3\xA9\x7F\xFF", "\"\xC3\xA9\x7F\xFF\"");
+  }
+}
+
+static std::string writeString(const std::string& input) {
+  char output[512] = {0};
+  StaticStringWriter sb(output, sizeof(output));
+  TextFormatter<StaticStringWriter> writer(sb);
+  writer.writeString(input.data(), input.size());
+  REQUIRE(writer.bytesWritten() == strlen(output));
+  return output;
+}
+
+// Reference implementation: one character at a time
+static std::string expectedString(const std::string& input) {
+  std::string result = "\"";
+  for (char c : input) {
+    switch (c) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\b':
+        result += "\\b";
+        break;
+      case '\f':
+        result += "\\f";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\r':
+        result += "\\r";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      case '\0':
+        result += "\\u0000";
+        break;
+      default:
+        result += c;
+    }
+  }
+  return result + "\"";
+}
+
+static void checkSpecialCharAt(size_t pos, size_t length) {
+  const char specials[] = {'"', '\\', '\n', '\0', '\x01', '\x1F'};
+  std::string plain;
+  for (size_t i = 0; i < length; i++)
+    plain += "a\xC3\xA9 z~\x7F\x80\xFF"[i % 9];
+
+  for (char special : specials) {
+    std::string input = plain;
+    input[pos] = special;
+    CAPTURE(pos, length, int(special));
+    REQUIRE(writeString(input) == expectedString(input));
+  }
+}
+
+TEST_CASE("TextFormatter::writeString(const char*, size_t)") {
+  SECTION("NUL") {
+    REQUIRE(writeString(std::string("a\0b", 3)) == "\"a\\u0000b\"");
+  }
+
+  SECTION("Special characters at every position of a long string") {
+    for (size_t pos = 0; pos < 70; pos++)
+      checkSpecialCharAt(pos, 70);
+  }
+
+  SECTION("Consecutive special characters") {
+    std::string input =
+        std::string(40, 'x') + "\"\\\n\t" + std::string(40, 'y');
+    REQUIRE(writeString(input) == expectedString(input));
+  }
 }
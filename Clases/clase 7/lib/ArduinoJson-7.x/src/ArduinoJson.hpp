@@ -40,6 +40,9 @@
 #include "ArduinoJson/Variant/JsonVariantConst.hpp"
 
 #include "ArduinoJson/Document/JsonDocument.hpp"
+#include "ArduinoJson/Document/JsonFrozenDocument.hpp"
+#include "ArduinoJson/Memory/ArenaAllocator.hpp"
+#include "ArduinoJson/Memory/StringInternTable.hpp"
 
 #include "ArduinoJson/Array/ArrayImpl.hpp"
 #include "ArduinoJson/Array/ElementProxy.hpp"
@@ -53,11 +56,17 @@
 #include "ArduinoJson/Variant/VariantRefBaseImpl.hpp"
 
 #include "ArduinoJson/Json/JsonDeserializer.hpp"
+#include "ArduinoJson/Json/JsonDocumentMeasurer.hpp"
+#include "ArduinoJson/Json/JsonPointerExtractor.hpp"
+#include "ArduinoJson/Json/JsonReader.hpp"
 #include "ArduinoJson/Json/JsonSerializer.hpp"
+#include "ArduinoJson/Json/JsonStreamParser.hpp"
+#include "ArduinoJson/Json/JsonWriter.hpp"
 #include "ArduinoJson/Json/PrettyJsonSerializer.hpp"
 #include "ArduinoJson/MsgPack/MsgPackBinary.hpp"
 #include "ArduinoJson/MsgPack/MsgPackDeserializer.hpp"
 #include "ArduinoJson/MsgPack/MsgPackExtension.hpp"
 #include "ArduinoJson/MsgPack/MsgPackSerializer.hpp"
+#include "ArduinoJson/MsgPack/MsgPackWriter.hpp"
 
 #include "ArduinoJson/compatibility.hpp"
@@ -13,12 +13,49 @@ inline VariantImpl::iterator VariantImpl::at(size_t index) const {
   if (!isArray())
     return iterator();
 
+  if (resources_->frozen()) {
+    if (index >= countFrozenSlots(data_))
+      return iterator();
+    auto id = SlotId(data_->content.asCollection.head + index);
+    return iterator(resources_->getVariant(id), id);
+  }
+
+#if ARDUINOJSON_COLLECTION_CACHE_SIZE
+  auto cache = resources_->cacheCollection(data_);
+  if (index >= cache->slotCount)
+    return iterator();
+
+  // start from the last accessed element if possible
+  iterator it;
+  size_t i;
+  if (cache->slot != NULL_SLOT && cache->index <= index) {
+    it = iterator(resources_->getVariant(cache->slot), cache->slot);
+    i = cache->index;
+  } else {
+    it = createIterator();
+    i = 0;
+  }
+
+  while (!it.done() && i < index) {
+    it.move(resources_);
+    i++;
+  }
+
+  if (it.done()) {
+    cache->slotCount = i;  // we know the size now
+  } else {
+    cache->index = i;
+    cache->slot = it.currentId_;
+  }
+  return it;
+#else
   auto it = createIterator();
   while (!it.done() && index) {
     it.move(resources_);
     --index;
   }
   return it;
+#endif
 }
 
 inline VariantData* VariantImpl::addNewElement(VariantData* data,
@@ -35,6 +72,17 @@ inline VariantData* VariantImpl::addNewElement(VariantData* data,
 }
 
 inline VariantData* VariantImpl::getOrAddElement(size_t index) {
+#if ARDUINOJSON_COLLECTION_CACHE_SIZE
+  auto element = getElement(index);
+  if (element)
+    return element;
+  for (auto n = size(); n <= index; n++) {
+    element = addNewElement();
+    if (!element)
+      return nullptr;
+  }
+  return element;
+#else
   auto it = createIterator();
   while (!it.done() && index > 0) {
     it.move(resources_);
@@ -50,6 +98,7 @@ inline VariantData* VariantImpl::getOrAddElement(size_t index) {
     index--;
   }
   return element;
+#endif
 }
 
 inline VariantData* VariantImpl::getElement(size_t index) const {
@@ -7,6 +7,26 @@
 #include <ArduinoJson/Array/ElementProxy.hpp>
 #include <ArduinoJson/Array/JsonArrayConst.hpp>
 
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Calls the predicate of JsonArray::removeIf() with a JsonVariant
+template <typename TPredicate>
+class ElementPredicate {
+ public:
+  ElementPredicate(TPredicate& predicate, ResourceManager* resources)
+      : predicate_(predicate), resources_(resources) {}
+
+  bool operator()(CollectionIterator it) {
+    return predicate_(JsonVariant(it.data(), resources_));
+  }
+
+ private:
+  TPredicate& predicate_;
+  ResourceManager* resources_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
 ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
 
 class JsonObject;
@@ -108,6 +128,15 @@ class JsonArray : public detail::VariantOperators<JsonArray> {
     impl_.removeElement(it.iterator_);
   }
 
+  // Removes the elements for which predicate(JsonVariant) returns true, in a
+  // single pass. The predicate must not modify the array.
+  // Returns the number of elements removed.
+  template <typename TPredicate>
+  size_t removeIf(TPredicate predicate) const {
+    detail::ElementPredicate<TPredicate> pred(predicate, impl_.resources());
+    return impl_.removeIf(pred);
+  }
+
   // Removes the element at the specified index.
   // https://arduinojson.org/v7/api/jsonarray/remove/
   void remove(size_t index) const {
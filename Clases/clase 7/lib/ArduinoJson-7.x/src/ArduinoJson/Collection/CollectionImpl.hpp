@@ -11,6 +11,8 @@ ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 inline void CollectionIterator::move(const ResourceManager* resources) {
   ARDUINOJSON_ASSERT(slot_);
   auto nextId = slot_->next;
+  if (slot_->type != VariantType::Free)  // skip the removed slots
+    previousId_ = currentId_;
   slot_ = resources->getVariant(nextId);
   currentId_ = nextId;
 }
@@ -30,6 +32,12 @@ inline void VariantImpl::addElement(Slot<VariantData> slot, VariantData* data,
   ARDUINOJSON_ASSERT(data->isCollection());
   ARDUINOJSON_ASSERT(resources != nullptr);
 
+#if ARDUINOJSON_COLLECTION_CACHE_SIZE
+  auto cache = resources->findCachedCollection(data);
+  if (cache && cache->slotCount != CollectionCache::unknownSize)
+    cache->slotCount++;
+#endif
+
   auto coll = &data->content.asCollection;
 
   if (coll->tail != NULL_SLOT) {
@@ -50,6 +58,12 @@ inline void VariantImpl::appendPair(Slot<VariantData> key,
 
   key->next = value.id();
 
+#if ARDUINOJSON_COLLECTION_CACHE_SIZE
+  auto cache = resources->findCachedCollection(data);
+  if (cache && cache->slotCount != CollectionCache::unknownSize)
+    cache->slotCount += 2;
+#endif
+
   auto coll = &data->content.asCollection;
 
   if (coll->tail != NULL_SLOT) {
@@ -67,6 +81,14 @@ inline void VariantImpl::empty(VariantData* data, ResourceManager* resources) {
   ARDUINOJSON_ASSERT(data->isCollection());
   ARDUINOJSON_ASSERT(resources != nullptr);
 
+#if ARDUINOJSON_COLLECTION_CACHE_SIZE
+  resources->uncacheCollection(data);
+#endif
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  if (data->isObject())
+    resources->destroyObjectIndex(data);
+#endif
+
   auto coll = &data->content.asCollection;
 
   auto next = coll->head;
@@ -81,6 +103,15 @@ inline void VariantImpl::empty(VariantData* data, ResourceManager* resources) {
   coll->tail = NULL_SLOT;
 }
 
+inline size_t VariantImpl::countSlots(VariantData* data,
+                                      ResourceManager* resources) {
+  size_t n = 0;
+  for (auto it = createIterator(data, resources); !it.done();
+       it.move(resources))
+    n++;
+  return n;
+}
+
 inline Slot<VariantData> VariantImpl::getPreviousSlot(
     VariantData* target) const {
   ARDUINOJSON_ASSERT(data_ != nullptr);
@@ -99,12 +130,33 @@ inline Slot<VariantData> VariantImpl::getPreviousSlot(
   return prev;
 }
 
-inline void VariantImpl::removeOne(iterator it) {
-  if (it.done())
-    return;
-  auto curr = it.slot_;
-  auto prev = getPreviousSlot(curr);
-  auto next = curr->next;
+// Returns the slot before the iterator, without scanning the collection when
+// the iterator saw it. That slot is ignored if it was removed or if it no
+// longer points to the current one, as another copy of the iterator might
+// have been passed to remove().
+inline Slot<VariantData> VariantImpl::getPreviousSlot(iterator it) const {
+  if (it.previousId_ != NULL_SLOT) {
+    auto prev = resources_->getVariant(it.previousId_);
+    if (prev->type != VariantType::Free && prev->next == it.currentId_)
+      return Slot<VariantData>(prev, it.previousId_);
+  } else if (data_->content.asCollection.head == it.currentId_) {
+    return Slot<VariantData>();
+  }
+  return getPreviousSlot(it.slot_);
+}
+
+inline void VariantImpl::unlinkSlots(Slot<VariantData> prev, SlotId next,
+                                     size_t count) {
+#if ARDUINOJSON_COLLECTION_CACHE_SIZE
+  auto cache = resources_->findCachedCollection(data_);
+  if (cache) {
+    if (cache->slotCount != CollectionCache::unknownSize)
+      cache->slotCount -= count;
+    cache->slot = NULL_SLOT;  // the cursor might be a removed slot
+  }
+#else
+  (void)count;
+#endif
   auto coll = &data_->content.asCollection;
   if (prev)
     prev->next = next;
@@ -112,6 +164,12 @@ inline void VariantImpl::removeOne(iterator it) {
     coll->head = next;
   if (next == NULL_SLOT)
     coll->tail = prev.id();
+}
+
+inline void VariantImpl::removeOne(iterator it) {
+  if (it.done())
+    return;
+  unlinkSlots(getPreviousSlot(it), it.slot_->next, 1);
   freeVariant({it.slot_, it.currentId_}, resources_);
 }
 
@@ -120,16 +178,68 @@ inline void VariantImpl::removePair(iterator it) {
     return;
 
   auto keySlot = it.slot_;
-
   auto valueId = keySlot->next;
   auto valueSlot = resources_->getVariant(valueId);
+  auto prev = getPreviousSlot(it);
 
-  // remove value slot
-  keySlot->next = valueSlot->next;
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  auto index = resources_->getObjectIndex(data_);
+  if (index && removeFromIndex(it.currentId_, index, resources_) &&
+      index->lastValue == valueId)
+    index->lastValue = prev.id();
+#endif
+
+  // the key still points to the value, so an iterator on the removed member
+  // can move to the next one
+  unlinkSlots(prev, valueSlot->next, 2);
   freeVariant({valueSlot, valueId}, resources_);
+  freeVariant({keySlot, it.currentId_}, resources_);
+}
+
+template <typename TPredicate>
+inline size_t VariantImpl::removeIf(TPredicate& pred) {
+  if (!isCollection())
+    return 0;
+
+  bool isObject = data_->isObject();
+  auto coll = &data_->content.asCollection;
+  SlotId lastKept = NULL_SLOT;
+  size_t count = 0;
+
+  auto id = coll->head;
+  while (id != NULL_SLOT) {
+    auto slot = resources_->getVariant(id);
+    // the value of a member comes right after the key
+    auto lastId = isObject ? slot->next : id;
+    auto lastSlot = resources_->getVariant(lastId);
+    auto nextId = lastSlot->next;
 
-  // remove key slot
-  removeOne(it);
+    if (pred(iterator(slot, id))) {
+      if (lastKept != NULL_SLOT)
+        resources_->getVariant(lastKept)->next = nextId;
+      else
+        coll->head = nextId;
+      if (isObject)
+        freeVariant({lastSlot, lastId}, resources_);
+      freeVariant({slot, id}, resources_);
+      count++;
+    } else {
+      lastKept = lastId;
+    }
+    id = nextId;
+  }
+  coll->tail = lastKept;
+
+  if (count) {
+#if ARDUINOJSON_COLLECTION_CACHE_SIZE
+    resources_->uncacheCollection(data_);
+#endif
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    if (isObject)
+      resources_->destroyObjectIndex(data_);
+#endif
+  }
+  return count;
 }
 
 inline size_t VariantImpl::nesting() const {
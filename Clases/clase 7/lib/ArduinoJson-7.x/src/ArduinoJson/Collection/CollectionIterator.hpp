@@ -18,7 +18,8 @@ class CollectionIterator {
   friend class VariantImpl;
 
  public:
-  CollectionIterator() : slot_(nullptr), currentId_(NULL_SLOT) {}
+  CollectionIterator()
+      : slot_(nullptr), currentId_(NULL_SLOT), previousId_(NULL_SLOT) {}
 
   void move(const ResourceManager* resources);
 
@@ -59,10 +60,11 @@ class CollectionIterator {
 
  private:
   CollectionIterator(VariantData* slot, SlotId slotId)
-      : slot_(slot), currentId_(slotId) {}
+      : slot_(slot), currentId_(slotId), previousId_(NULL_SLOT) {}
 
   VariantData* slot_;
   SlotId currentId_;
+  SlotId previousId_;  // NULL_SLOT if unknown, see getPreviousSlot()
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
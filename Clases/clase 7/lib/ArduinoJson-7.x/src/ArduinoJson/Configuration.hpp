@@ -119,11 +119,79 @@
 #  endif
 #endif
 
+// Capacity of the largest variant pool (in slots)
+// When larger than ARDUINOJSON_POOL_CAPACITY, each new pool is twice as large
+// as the previous one, up to this value, so that large documents need few
+// allocations. Finding the pool of a slot then costs a bit scan instead of a
+// division, which slows down parsing and iteration, so the pools have a fixed
+// size by default. Must be ARDUINOJSON_POOL_CAPACITY times a power of two.
+#ifndef ARDUINOJSON_MAX_POOL_CAPACITY
+#  define ARDUINOJSON_MAX_POOL_CAPACITY ARDUINOJSON_POOL_CAPACITY
+#endif
+
 // Initial capacity of the pool list
 #ifndef ARDUINOJSON_INITIAL_POOL_COUNT
 #  define ARDUINOJSON_INITIAL_POOL_COUNT 4
 #endif
 
+// Number of strings above which the string pool builds a hash index
+// Set to 0 to disable the index and save a few bytes per string
+#ifndef ARDUINOJSON_STRING_INDEX_THRESHOLD
+#  if ARDUINOJSON_SIZEOF_POINTER <= 2
+#    define ARDUINOJSON_STRING_INDEX_THRESHOLD 0  // disabled
+#  else
+#    define ARDUINOJSON_STRING_INDEX_THRESHOLD 16
+#  endif
+#endif
+
+// Number of members above which an object builds a hash index of its keys
+// Disabled by default because lookups update the index, even through a
+// JsonObjectConst, so the document can't be read from several threads at once
+#ifndef ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+#  define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 0  // disabled
+#endif
+
+// Number of collections whose size and last accessed element are cached
+// This makes size() and sequential indexing, as in arr[i], O(1)
+// Disabled by default because reading updates the cache, even through a
+// JsonArrayConst, so the document can't be read from several threads at once
+#ifndef ARDUINOJSON_COLLECTION_CACHE_SIZE
+#  define ARDUINOJSON_COLLECTION_CACHE_SIZE 0  // disabled
+#endif
+
+// Scan strings with SIMD instructions (SSE2, AVX2, or NEON) when available,
+// or several bytes at a time with regular integer operations otherwise.
+// Also parse the digits of numbers eight at a time.
+// Set to 0 to scan one character at a time
+#ifndef ARDUINOJSON_ENABLE_SIMD
+#  if ARDUINOJSON_SIZEOF_POINTER <= 2
+#    define ARDUINOJSON_ENABLE_SIMD 0  // disabled
+#  else
+#    define ARDUINOJSON_ENABLE_SIMD 1
+#  endif
+#endif
+
+// Size of the buffer that collects the output of serializeJson() and
+// serializeMsgPack() before sending it to a stream, a string, or a Print
+// Set to 0 to send each token directly
+// The buffer is on the stack, so it's smaller on 32-bit platforms, like the
+// ESP8266 and its 4 KB stack
+#ifndef ARDUINOJSON_WRITE_BUFFER_SIZE
+#  if ARDUINOJSON_SIZEOF_POINTER <= 2
+#    define ARDUINOJSON_WRITE_BUFFER_SIZE 0  // disabled
+#  elif ARDUINOJSON_SIZEOF_POINTER == 4
+#    define ARDUINOJSON_WRITE_BUFFER_SIZE 64
+#  else
+#    define ARDUINOJSON_WRITE_BUFFER_SIZE 256
+#  endif
+#endif
+
+// Maximum number of object indexes kept at the same time
+// When the limit is reached, the least recently used index is destroyed
+#ifndef ARDUINOJSON_MAX_OBJECT_INDEXES
+#  define ARDUINOJSON_MAX_OBJECT_INDEXES 8
+#endif
+
 // Automatically call shrinkToFit() from deserializeXxx()
 // Disabled by default on 8-bit platforms because it's not worth the increase in
 // code size
@@ -238,6 +306,21 @@
 #  define ARDUINOJSON_NEGATIVE_EXPONENTIATION_THRESHOLD 1e-5
 #endif
 
+// Write floats and doubles with the fewest digits that parse back to the same
+// value, instead of rounding them to 9 or 6 decimal places
+// CAUTION: requires a table of 10 KB
+#ifndef ARDUINOJSON_ENABLE_SHORTEST_FLOAT
+#  define ARDUINOJSON_ENABLE_SHORTEST_FLOAT 0
+#endif
+
+// Parse floats and doubles to the nearest value, instead of multiplying the
+// digits by powers of ten, which can be off by a few units in the last place
+// CAUTION: requires a table of 10 KB, shared with ENABLE_SHORTEST_FLOAT, and
+// is slower for short fractions
+#ifndef ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+#  define ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING 0
+#endif
+
 #ifndef ARDUINOJSON_LITTLE_ENDIAN
 #  if defined(_MSC_VER) ||                           \
       (defined(__BYTE_ORDER__) &&                    \
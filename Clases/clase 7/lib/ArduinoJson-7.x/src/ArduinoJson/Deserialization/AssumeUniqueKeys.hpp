@@ -0,0 +1,19 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace DeserializationOption {
+// Tells deserializeJson() that the input contains no duplicate keys, so it can
+// append each member without looking for an existing one.
+// If the input contains duplicate keys anyway, the object keeps all of them,
+// and lookups return the first one.
+class AssumeUniqueKeys {};
+}  // namespace DeserializationOption
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,348 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Array/JsonArrayConst.hpp>
+#include <ArduinoJson/Deserialization/Filter.hpp>
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Object/JsonObjectConst.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+
+#include <string.h>  // memcmp, memcpy, strlen
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+struct CompiledFilterMember;
+
+// A node of a compiled filter, which stores the answers of a Filter for one
+// level of the filter document
+struct CompiledFilterNode {
+  enum : uint8_t {
+    Allow = 1,
+    AllowArray = 2,
+    AllowObject = 4,
+    AllowValue = 8,
+  };
+
+  uint8_t flags;
+  const CompiledFilterNode* element;   // for the elements of an array
+  const CompiledFilterNode* wildcard;  // for the keys that aren't in members
+  const CompiledFilterMember* members;  // sorted by size, then by content
+  size_t memberCount;
+};
+
+struct CompiledFilterMember {
+  const char* key;
+  size_t size;
+  const CompiledFilterNode* node;
+
+  // Orders the members by size first, so that most comparisons don't need to
+  // look at the characters
+  int compare(const char* s, size_t n) const {
+    if (size != n)
+      return size < n ? -1 : 1;
+    return memcmp(key, s, n);
+  }
+};
+
+// Fills the tables of a compiled filter.
+// With null tables, only counts what the tables need.
+class CompiledFilterBuilder {
+ public:
+  CompiledFilterBuilder(CompiledFilterNode* nodes,
+                        CompiledFilterMember* members, char* keys)
+      : nodes_(nodes), members_(members), keys_(keys) {}
+
+  size_t nodeCount() const {
+    return nodeCount_;
+  }
+
+  size_t memberCount() const {
+    return memberCount_;
+  }
+
+  size_t keysSize() const {
+    return keysSize_;
+  }
+
+  // The first two nodes are shared by all the values that are rejected or
+  // accepted recursively
+  void addConstantNodes() {
+    CompiledFilterNode* deny = newNode(0);
+    CompiledFilterNode* allowAll =
+        newNode(CompiledFilterNode::Allow | CompiledFilterNode::AllowArray |
+                CompiledFilterNode::AllowObject |
+                CompiledFilterNode::AllowValue);
+    if (!nodes_)
+      return;
+    deny->element = deny->wildcard = deny;
+    allowAll->element = allowAll->wildcard = allowAll;
+  }
+
+  const CompiledFilterNode* build(JsonVariantConst variant) {
+    DeserializationOption::Filter filter(variant);
+    if (filter.allowValue())  // "true" means "allow recursively"
+      return allowAll();
+
+    uint8_t flags = 0;
+    if (filter.allow())
+      flags |= CompiledFilterNode::Allow;
+    if (filter.allowArray())
+      flags |= CompiledFilterNode::AllowArray;
+    if (filter.allowObject())
+      flags |= CompiledFilterNode::AllowObject;
+    if (!flags)
+      return deny();
+
+    CompiledFilterNode* node = newNode(flags);
+    const CompiledFilterNode* element = deny();
+    const CompiledFilterNode* wildcard = deny();
+    CompiledFilterMember* members = nullptr;
+    size_t memberCount = 0;
+
+    // Mimic Filter::operator[], which falls back to "*" when the key is
+    // missing or its value is null
+    if (filter.allowArray()) {
+      element = build(variant[0]);
+    } else if (filter.allowObject()) {
+      element = wildcard = build(variant["*"]);
+
+      // The members of an object must be contiguous, so they are reserved
+      // before build() adds the members of the nested objects
+      JsonObjectConst object = variant.as<JsonObjectConst>();
+      for (JsonPairConst pair : object)
+        if (!member(variant, pair).isNull())
+          memberCount++;
+      if (members_)
+        members = members_ + memberCount_;
+      memberCount_ += memberCount;
+
+      size_t i = 0;
+      for (JsonPairConst pair : object) {
+        JsonVariantConst value = member(variant, pair);
+        if (value.isNull())
+          continue;
+        const CompiledFilterNode* child = build(value);
+        JsonString key = pair.key();
+        if (members) {
+          members[i].key = keys_ + keysSize_;
+          members[i].size = key.size();
+          members[i].node = child;
+          memcpy(keys_ + keysSize_, key.c_str(), key.size());
+        }
+        keysSize_ += key.size();
+        i++;
+      }
+      if (members)
+        sortMembers(members, memberCount);
+    }
+
+    if (node) {
+      node->element = element;
+      node->wildcard = wildcard;
+      node->members = members;
+      node->memberCount = memberCount;
+    }
+    return node;
+  }
+
+ private:
+  const CompiledFilterNode* deny() const {
+    return nodes_;
+  }
+
+  const CompiledFilterNode* allowAll() const {
+    return nodes_ ? nodes_ + 1 : nullptr;
+  }
+
+  CompiledFilterNode* newNode(uint8_t flags) {
+    CompiledFilterNode* node = nullptr;
+    if (nodes_) {
+      node = &nodes_[nodeCount_];
+      node->flags = flags;
+      node->element = node->wildcard = nullptr;
+      node->members = nullptr;
+      node->memberCount = 0;
+    }
+    nodeCount_++;
+    return node;
+  }
+
+  // Returns the value that Filter::operator[] finds for the key of the pair,
+  // which is the first one if the key is duplicated
+  static JsonVariantConst member(JsonVariantConst object, JsonPairConst pair) {
+    return object[pair.key()];
+  }
+
+  static void sortMembers(CompiledFilterMember* members, size_t count) {
+    // insertion sort, as objects of filters are small
+    for (size_t i = 1; i < count; i++) {
+      CompiledFilterMember tmp = members[i];
+      size_t j = i;
+      while (j > 0 && members[j - 1].compare(tmp.key, tmp.size) > 0) {
+        members[j] = members[j - 1];
+        j--;
+      }
+      members[j] = tmp;
+    }
+  }
+
+  CompiledFilterNode* nodes_;
+  CompiledFilterMember* members_;
+  char* keys_;
+  size_t nodeCount_ = 0;
+  size_t memberCount_ = 0;
+  size_t keysSize_ = 0;
+};
+
+// The filter that the deserializers receive when a CompiledFilter is passed.
+// It has the same interface as Filter, but points to a node of the tables.
+class CompiledFilterCursor {
+ public:
+  explicit CompiledFilterCursor(const CompiledFilterNode* node) : node_(node) {}
+
+  bool allow() const {
+    return node_->flags & CompiledFilterNode::Allow;
+  }
+
+  bool allowArray() const {
+    return node_->flags & CompiledFilterNode::AllowArray;
+  }
+
+  bool allowObject() const {
+    return node_->flags & CompiledFilterNode::AllowObject;
+  }
+
+  bool allowValue() const {
+    return node_->flags & CompiledFilterNode::AllowValue;
+  }
+
+  // Like Filter, only the first element of an array filter is used
+  template <typename TIndex>
+  enable_if_t<is_integral<TIndex>::value, CompiledFilterCursor> operator[](
+      TIndex) const {
+    return CompiledFilterCursor(node_->element);
+  }
+
+  CompiledFilterCursor operator[](JsonString key) const {
+    return find(key.c_str(), key.size());
+  }
+
+  CompiledFilterCursor operator[](const char* key) const {
+    return find(key, key ? strlen(key) : 0);
+  }
+
+ private:
+  CompiledFilterCursor find(const char* key, size_t size) const {
+    const CompiledFilterMember* members = node_->members;
+    size_t lo = 0, hi = node_->memberCount;
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      int cmp = members[mid].compare(key, size);
+      if (cmp == 0)
+        return CompiledFilterCursor(members[mid].node);
+      if (cmp < 0)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return CompiledFilterCursor(node_->wildcard);
+  }
+
+  const CompiledFilterNode* node_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+namespace detail {
+class CompiledFilterAttorney;
+}
+
+namespace DeserializationOption {
+// A Filter converted once into lookup tables, so it can be reused by many
+// calls to deserializeJson() or deserializeMsgPack().
+// Unlike a Filter, it finds each key with a binary search instead of a search
+// in the filter document (plus a second one for "*"), and it doesn't need the
+// filter document once it's built.
+// If the allocation fails, overflowed() returns true and nothing passes the
+// filter.
+class CompiledFilter {
+ public:
+  explicit CompiledFilter(
+      JsonVariantConst filter,
+      Allocator* allocator = detail::DefaultAllocator::instance())
+      : allocator_(allocator) {
+    detail::CompiledFilterBuilder counter(nullptr, nullptr, nullptr);
+    counter.addConstantNodes();
+    counter.build(filter);
+
+    size_t nodesSize = counter.nodeCount() * sizeof(detail::CompiledFilterNode);
+    size_t membersSize =
+        counter.memberCount() * sizeof(detail::CompiledFilterMember);
+    buffer_ =
+        allocator_->allocate(nodesSize + membersSize + counter.keysSize());
+    if (!buffer_)
+      return;
+
+    auto nodes = reinterpret_cast<detail::CompiledFilterNode*>(buffer_);
+    auto members = reinterpret_cast<detail::CompiledFilterMember*>(
+        reinterpret_cast<char*>(buffer_) + nodesSize);
+    char* keys = reinterpret_cast<char*>(buffer_) + nodesSize + membersSize;
+    detail::CompiledFilterBuilder builder(nodes, members, keys);
+    builder.addConstantNodes();
+    root_ = builder.build(filter);
+  }
+
+  CompiledFilter(CompiledFilter&& src)
+      : allocator_(src.allocator_), buffer_(src.buffer_), root_(src.root_) {
+    src.buffer_ = nullptr;
+    src.root_ = nullptr;
+  }
+
+  CompiledFilter(const CompiledFilter&) = delete;
+  CompiledFilter& operator=(const CompiledFilter&) = delete;
+
+  ~CompiledFilter() {
+    if (buffer_)
+      allocator_->deallocate(buffer_);
+  }
+
+  // Returns true if the tables couldn't be allocated
+  bool overflowed() const {
+    return root_ == nullptr;
+  }
+
+ private:
+  friend class detail::CompiledFilterAttorney;
+
+  detail::CompiledFilterCursor root() const {
+    return detail::CompiledFilterCursor(root_ ? root_ : &denyAll());
+  }
+
+  static const detail::CompiledFilterNode& denyAll() {
+    static const detail::CompiledFilterNode node = {0, &node, &node, nullptr,
+                                                    0};
+    return node;
+  }
+
+  Allocator* allocator_;
+  void* buffer_ = nullptr;
+  const detail::CompiledFilterNode* root_ = nullptr;
+};
+}  // namespace DeserializationOption
+
+namespace detail {
+class CompiledFilterAttorney {
+ public:
+  static CompiledFilterCursor getRoot(
+      const DeserializationOption::CompiledFilter& filter) {
+    return filter.root();
+  }
+};
+}  // namespace detail
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
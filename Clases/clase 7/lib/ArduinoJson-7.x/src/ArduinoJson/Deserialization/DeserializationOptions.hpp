@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <ArduinoJson/Deserialization/AssumeUniqueKeys.hpp>
+#include <ArduinoJson/Deserialization/CompiledFilter.hpp>
 #include <ArduinoJson/Deserialization/Filter.hpp>
 #include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
@@ -13,23 +16,92 @@ template <typename TFilter>
 struct DeserializationOptions {
   TFilter filter;
   DeserializationOption::NestingLimit nestingLimit;
+  bool assumeUniqueKeys;
 };
 
-template <typename TFilter>
-inline DeserializationOptions<TFilter> makeDeserializationOptions(
-    TFilter filter, DeserializationOption::NestingLimit nestingLimit = {}) {
-  return {filter, nestingLimit};
+// A meta-function that returns the type of the filter in the options, or
+// AllowAllFilter if there is none
+template <typename... TOptions>
+struct filter_type {
+  using type = AllowAllFilter;
+};
+template <typename... TRest>
+struct filter_type<DeserializationOption::NestingLimit, TRest...>
+    : filter_type<TRest...> {};
+template <typename... TRest>
+struct filter_type<DeserializationOption::AssumeUniqueKeys, TRest...>
+    : filter_type<TRest...> {};
+template <typename... TRest>
+struct filter_type<DeserializationOption::CompiledFilter, TRest...> {
+  using type = CompiledFilterCursor;
+};
+template <typename TFilter, typename... TRest>
+struct filter_type<TFilter, TRest...> {
+  using type = TFilter;
+};
+
+template <typename... TOptions>
+using deserialization_options_t =
+    DeserializationOptions<typename filter_type<TOptions...>::type>;
+
+// The options can be passed in any order.
+// They are passed by reference because a CompiledFilter can't be copied.
+
+inline DeserializationOptions<AllowAllFilter> makeDeserializationOptions() {
+  return {{}, {}, false};
 }
 
-template <typename TFilter>
-inline DeserializationOptions<TFilter> makeDeserializationOptions(
-    DeserializationOption::NestingLimit nestingLimit, TFilter filter) {
-  return {filter, nestingLimit};
+template <typename... TRest>
+deserialization_options_t<TRest...> makeDeserializationOptions(
+    DeserializationOption::NestingLimit nestingLimit, const TRest&... rest);
+
+template <typename... TRest>
+deserialization_options_t<TRest...> makeDeserializationOptions(
+    DeserializationOption::AssumeUniqueKeys, const TRest&... rest);
+
+template <typename... TRest>
+DeserializationOptions<CompiledFilterCursor> makeDeserializationOptions(
+    const DeserializationOption::CompiledFilter& filter, const TRest&... rest);
+
+template <typename TFilter, typename... TRest>
+DeserializationOptions<TFilter> makeDeserializationOptions(
+    const TFilter& filter, const TRest&... rest);
+
+template <typename... TRest>
+inline deserialization_options_t<TRest...> makeDeserializationOptions(
+    DeserializationOption::NestingLimit nestingLimit, const TRest&... rest) {
+  auto options = makeDeserializationOptions(rest...);
+  options.nestingLimit = nestingLimit;
+  return options;
 }
 
-inline DeserializationOptions<AllowAllFilter> makeDeserializationOptions(
-    DeserializationOption::NestingLimit nestingLimit = {}) {
-  return {{}, nestingLimit};
+template <typename... TRest>
+inline deserialization_options_t<TRest...> makeDeserializationOptions(
+    DeserializationOption::AssumeUniqueKeys, const TRest&... rest) {
+  auto options = makeDeserializationOptions(rest...);
+  options.assumeUniqueKeys = true;
+  return options;
+}
+
+template <typename... TRest>
+inline DeserializationOptions<CompiledFilterCursor> makeDeserializationOptions(
+    const DeserializationOption::CompiledFilter& filter, const TRest&... rest) {
+  static_assert(
+      is_same<typename filter_type<TRest...>::type, AllowAllFilter>::value,
+      "only one filter can be passed to deserialize()");
+  auto options = makeDeserializationOptions(rest...);
+  return {CompiledFilterAttorney::getRoot(filter), options.nestingLimit,
+          options.assumeUniqueKeys};
+}
+
+template <typename TFilter, typename... TRest>
+inline DeserializationOptions<TFilter> makeDeserializationOptions(
+    const TFilter& filter, const TRest&... rest) {
+  static_assert(
+      is_same<typename filter_type<TRest...>::type, AllowAllFilter>::value,
+      "only one filter can be passed to deserialize()");
+  auto options = makeDeserializationOptions(rest...);
+  return {filter, options.nestingLimit, options.assumeUniqueKeys};
 }
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
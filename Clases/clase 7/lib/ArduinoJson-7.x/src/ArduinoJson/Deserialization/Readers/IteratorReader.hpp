@@ -31,8 +31,16 @@ class IteratorReader {
   }
 };
 
+template <typename TSource, typename = void>
+struct HasConstIterator : false_type {};
+
+template <typename TSource>
+struct HasConstIterator<TSource, void_t<typename TSource::const_iterator>>
+    : true_type {};
+
 template <typename TSource>
-struct Reader<TSource, void_t<typename TSource::const_iterator>>
+struct Reader<TSource, enable_if_t<HasConstIterator<TSource>::value &&
+                                   !IsContiguousSource<TSource>::value>>
     : IteratorReader<typename TSource::const_iterator> {
   explicit Reader(const TSource& source)
       : IteratorReader<typename TSource::const_iterator>(source.begin(),
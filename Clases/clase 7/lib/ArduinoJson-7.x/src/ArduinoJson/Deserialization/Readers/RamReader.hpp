@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Strings/StringTraits.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
@@ -18,32 +19,98 @@ struct IsCharOrVoid {
 template <typename T>
 struct IsCharOrVoid<const T> : IsCharOrVoid<T> {};
 
-template <typename TSource>
-struct Reader<TSource*, enable_if_t<IsCharOrVoid<TSource>::value>> {
-  const char* ptr_;
+template <typename T>
+struct IsContiguousSource {
+  static const bool value = string_traits_impl::has_data<T>::value &&
+                            string_traits_impl::has_size<T>::value;
+};
 
+// A reader whose input is a contiguous range of chars in RAM.
+// The deserializers can access ptr() and end() directly to consume the input in
+// runs instead of calling read() for each character.
+// When bounded() is false, the input is only delimited by a NUL terminator and
+// end() must be ignored.
+class ContiguousReader {
  public:
-  explicit Reader(const void* ptr)
-      : ptr_(ptr ? reinterpret_cast<const char*>(ptr) : "") {}
+  // Reads until the NUL terminator
+  explicit ContiguousReader(const char* ptr)
+      : ptr_(ptr), end_(ptr), bounded_(false) {}
+
+  // Reads the length chars that start at ptr
+  ContiguousReader(const char* ptr, size_t length)
+      : ptr_(ptr), end_(ptr + length), bounded_(true) {}
 
   int read() {
-    return static_cast<unsigned char>(*ptr_++);
+    if (!bounded_ || ptr_ != end_)
+      return static_cast<unsigned char>(*ptr_++);
+    else
+      return -1;
   }
 
   size_t readBytes(char* buffer, size_t length) {
-    for (size_t i = 0; i < length; i++)
-      buffer[i] = *ptr_++;
-    return length;
+    size_t i = 0;
+    while (i < length && (!bounded_ || ptr_ != end_))
+      buffer[i++] = *ptr_++;
+    return i;
+  }
+
+  const char* ptr() const {
+    return ptr_;
   }
+
+  const char* end() const {
+    return end_;
+  }
+
+  bool bounded() const {
+    return bounded_;
+  }
+
+ private:
+  const char* ptr_;
+  const char* end_;
+  bool bounded_;
+};
+
+// The input of deserializeJsonInPlace(): a writable buffer that the
+// deserializer reuses to store the strings.
+class InPlaceReader : public ContiguousReader {
+ public:
+  explicit InPlaceReader(char* ptr)
+      : ContiguousReader(ptr ? ptr : ""), buffer_(ptr) {}
+
+  InPlaceReader(char* ptr, size_t length)
+      : ContiguousReader(ptr ? ptr : "", ptr ? length : 0), buffer_(ptr) {}
+
+  char* buffer() const {
+    return buffer_;
+  }
+
+ private:
+  char* buffer_;
+};
+
+template <typename TSource>
+struct Reader<TSource*, enable_if_t<IsCharOrVoid<TSource>::value>>
+    : ContiguousReader {
+  explicit Reader(const void* ptr)
+      : ContiguousReader(ptr ? reinterpret_cast<const char*>(ptr) : "") {}
 };
 
 template <typename TSource>
 struct BoundedReader<TSource*, enable_if_t<IsCharOrVoid<TSource>::value>>
-    : public IteratorReader<const char*> {
- public:
+    : ContiguousReader {
   explicit BoundedReader(const void* ptr, size_t len)
-      : IteratorReader<const char*>(reinterpret_cast<const char*>(ptr),
-                                    reinterpret_cast<const char*>(ptr) + len) {}
+      : ContiguousReader(ptr ? reinterpret_cast<const char*>(ptr) : "",
+                         ptr ? len : 0) {}
+};
+
+// std::string, std::string_view, std::vector<char>...
+template <typename TSource>
+struct Reader<TSource, enable_if_t<IsContiguousSource<TSource>::value>>
+    : BoundedReader<const char*> {
+  explicit Reader(const TSource& source)
+      : BoundedReader<const char*>(source.data(), source.size()) {}
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -29,6 +29,19 @@ using is_deserialize_destination =
     bool_constant<is_base_of<JsonDocument, remove_cv_t<T>>::value ||
                   IsVariant<T>::value>;
 
+template <typename TDestination>
+inline void clearDestination(TDestination& dst) {
+  dst.clear();
+}
+
+// After JsonDocument::recycle(), the memory is kept for the new content
+inline void clearDestination(JsonDocument& doc) {
+  if (VariantAttorney::getResourceManager(doc)->recycling())
+    doc.recycle();
+  else
+    doc.clear();
+}
+
 template <typename TDestination>
 inline void shrinkJsonDocument(TDestination&) {
   // no-op by default
@@ -36,7 +49,8 @@ inline void shrinkJsonDocument(TDestination&) {
 
 #if ARDUINOJSON_AUTO_SHRINK
 inline void shrinkJsonDocument(JsonDocument& doc) {
-  doc.shrinkToFit();
+  if (!VariantAttorney::getResourceManager(doc)->recycling())
+    doc.shrinkToFit();
 }
 #endif
 
@@ -48,9 +62,8 @@ DeserializationError doDeserialize(TDestination&& dst, TReader reader,
   if (!data)
     return DeserializationError::NoMemory;
   auto resources = VariantAttorney::getResourceManager(dst);
-  dst.clear();
-  auto err = TDeserializer<TReader>(resources, reader)
-                 .parse(data, options.filter, options.nestingLimit);
+  clearDestination(dst);
+  auto err = TDeserializer<TReader>(resources, reader).parse(data, options);
   shrinkJsonDocument(dst);
   return err;
 }
@@ -61,7 +74,7 @@ template <
     enable_if_t<  // issue #1897
         !is_integral<typename first_or_void<Args...>::type>::value, int> = 0>
 DeserializationError deserialize(TDestination&& dst, TStream&& input,
-                                 Args... args) {
+                                 const Args&... args) {
   return doDeserialize<TDeserializer>(
       dst, makeReader(detail::forward<TStream>(input)),
       makeDeserializationOptions(args...));
@@ -71,7 +84,7 @@ template <template <typename> class TDeserializer, typename TDestination,
           typename TChar, typename Size, typename... Args,
           enable_if_t<is_integral<Size>::value, int> = 0>
 DeserializationError deserialize(TDestination&& dst, TChar* input,
-                                 Size inputSize, Args... args) {
+                                 Size inputSize, const Args&... args) {
   return doDeserialize<TDeserializer>(dst, makeReader(input, size_t(inputSize)),
                                       makeDeserializationOptions(args...));
 }
@@ -23,8 +23,16 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
   explicit JsonDocument(Allocator* alloc = detail::DefaultAllocator::instance())
       : resources_(alloc) {}
 
+  // Stores the keys in a table shared with other documents.
+  // The table must outlive the document, and the documents that share a table
+  // must be used from the same thread (the table isn't synchronized).
+  explicit JsonDocument(StringInternTable* internTable,
+                        Allocator* alloc = detail::DefaultAllocator::instance())
+      : resources_(alloc, internTable) {}
+
   // Copy-constructor
-  JsonDocument(const JsonDocument& src) : JsonDocument(src.allocator()) {
+  JsonDocument(const JsonDocument& src)
+      : JsonDocument(src.resources_.internTable(), src.allocator()) {
     set(src);
   }
 
@@ -69,6 +77,15 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
     resources_.shrinkToFit();
   }
 
+  // Moves the values next to each other, in the order of a depth-first
+  // traversal, and releases the memory of the removed ones.
+  // Invalidates the JsonArray, JsonObject, and JsonVariant that point inside
+  // the document; get them again from the document after calling compact().
+  // Returns false if the temporary table couldn't be allocated.
+  bool compact() {
+    return resources_.compact(&data_);
+  }
+
   // Casts the root to the specified type.
   // https://arduinojson.org/v7/api/jsondocument/as/
   template <typename T>
@@ -90,6 +107,26 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
     data_.type = detail::VariantType::Null;
   }
 
+  // Empties the document, but keeps its memory for the next content.
+  // From then on, deserializeJson() keeps the memory too, so a loop that
+  // parses similar messages stops calling the allocator.
+  // clear() releases the memory and ends this mode; shrinkToFit() releases
+  // the memory that isn't used and ends this mode.
+  void recycle() {
+    resources_.recycle();
+    data_.type = detail::VariantType::Null;
+  }
+
+  // Empties the document and allocates room for the given number of variant
+  // slots and bytes of strings, each in a single block.
+  // measureDeserializeJson() tells how much a JSON input needs.
+  // The document keeps this memory like after recycle().
+  // Returns false if an allocation failed.
+  bool reserve(size_t variantSlots, size_t stringBytes) {
+    data_.type = detail::VariantType::Null;
+    return resources_.reserve(variantSlots, stringBytes);
+  }
+
   // Returns true if the root is of the specified type.
   // https://arduinojson.org/v7/api/jsondocument/is/
   template <typename T>
@@ -155,7 +192,7 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
   template <typename T,
             detail::enable_if_t<detail::is_same<T, JsonArray>::value, int> = 0>
   JsonArray to() {
-    clear();
+    replaceContent();
     data_.toArray();
     return JsonArray(&data_, &resources_);
   }
@@ -165,7 +202,7 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
   template <typename T,
             detail::enable_if_t<detail::is_same<T, JsonObject>::value, int> = 0>
   JsonObject to() {
-    clear();
+    replaceContent();
     data_.toObject();
     return JsonObject(&data_, &resources_);
   }
@@ -175,7 +212,7 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
   template <typename T, detail::enable_if_t<
                             detail::is_same<T, JsonVariant>::value, int> = 0>
   JsonVariant to() {
-    clear();
+    replaceContent();
     return JsonVariant(&data_, &resources_);
   }
 
@@ -400,6 +437,14 @@ class JsonDocument : public detail::VariantOperators<const JsonDocument&> {
   }
 
  private:
+  // Empties the document for a new content; keeps the memory after recycle()
+  void replaceContent() {
+    if (resources_.recycling())
+      recycle();
+    else
+      clear();
+  }
+
   detail::VariantImpl getVariantImpl() const {
     return detail::VariantImpl(&data_, &resources_);
   }
@@ -0,0 +1,313 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/ResourceManager.hpp>
+#include <ArduinoJson/Variant/JsonVariant.hpp>
+#include <ArduinoJson/Variant/JsonVariantConst.hpp>
+#include <ArduinoJson/Variant/VariantImpl.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Copies a variant into the slots of a frozen document.
+// The children of each collection are allocated together, so they get
+// consecutive ids, and the members of each object are sorted by key.
+class FrozenDocumentBuilder {
+ public:
+  FrozenDocumentBuilder(ResourceManager* resources) : resources_(resources) {}
+
+  bool build(VariantData* src, ResourceManager* srcResources,
+             VariantData* dst) {
+    if (!src)
+      return true;
+    if (src->isCollection())
+      return copyCollection(src, srcResources, dst);
+    return copyValue(src, srcResources, dst);
+  }
+
+ private:
+  bool copyValue(VariantData* src, ResourceManager* srcResources,
+                 VariantData* dst) {
+    return JsonVariant(dst, resources_)
+        .set(JsonVariantConst(src, srcResources));
+  }
+
+  bool copyCollection(VariantData* src, ResourceManager* srcResources,
+                      VariantData* dst) {
+    if (src->isArray()) {
+      dst->toArray();
+      return copyElements(src, srcResources, dst);
+    } else {
+      dst->toObject();
+      return copyMembers(src, srcResources, dst);
+    }
+  }
+
+  // Copies the elements, then the content of the nested collections, so the
+  // elements aren't interleaved with the slots of their children
+  bool copyElements(VariantData* src, ResourceManager* srcResources,
+                    VariantData* dst) {
+    if (!allocChildren(dst, VariantImpl::countSlots(src, srcResources)))
+      return false;
+
+    auto id = dst->content.asCollection.head;
+    for (auto it = VariantImpl::createIterator(src, srcResources); !it.done();
+         it.move(srcResources), id++) {
+      if (!it->isCollection() &&
+          !copyValue(it.data(), srcResources, resources_->getVariant(id)))
+        return false;
+    }
+
+    id = dst->content.asCollection.head;
+    for (auto it = VariantImpl::createIterator(src, srcResources); !it.done();
+         it.move(srcResources), id++) {
+      if (it->isCollection() &&
+          !copyCollection(it.data(), srcResources, resources_->getVariant(id)))
+        return false;
+    }
+    return true;
+  }
+
+  bool copyMembers(VariantData* src, ResourceManager* srcResources,
+                   VariantData* dst) {
+    size_t count = VariantImpl::countSlots(src, srcResources) / 2;
+    if (!count)
+      return true;
+
+    // the key slots, followed by the buffer of the merge sort
+    auto keys = static_cast<VariantData**>(
+        resources_->allocator()->allocate(2 * count * sizeof(VariantData*)));
+    if (!keys)
+      return false;
+
+    size_t i = 0;
+    for (auto it = VariantImpl::createIterator(src, srcResources); !it.done();
+         it.move(srcResources), it.move(srcResources))
+      keys[i++] = it.data();
+    sortKeys(keys, keys + count, count);
+
+    bool ok = allocChildren(dst, 2 * count);
+    auto head = dst->content.asCollection.head;
+    for (i = 0; ok && i < count; i++) {
+      auto value = srcResources->getVariant(keys[i]->next);
+      ok = copyValue(keys[i], srcResources,
+                     resources_->getVariant(SlotId(head + 2 * i)));
+      if (ok && !value->isCollection())
+        ok = copyValue(value, srcResources,
+                       resources_->getVariant(SlotId(head + 2 * i + 1)));
+    }
+    for (i = 0; ok && i < count; i++) {
+      auto value = srcResources->getVariant(keys[i]->next);
+      if (value->isCollection())
+        ok = copyCollection(value, srcResources,
+                            resources_->getVariant(SlotId(head + 2 * i + 1)));
+    }
+
+    resources_->allocator()->deallocate(keys);
+    return ok;
+  }
+
+  bool allocChildren(VariantData* collection, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      auto slot = resources_->allocVariant();
+      if (!slot)
+        return false;
+      VariantImpl::addElement(slot, collection, resources_);
+      ARDUINOJSON_ASSERT(size_t(slot.id()) ==
+                         collection->content.asCollection.head + i);
+    }
+    return true;
+  }
+
+  static bool keyLessOrEqual(const VariantData* a, const VariantData* b) {
+    return stringCompare(adaptString(a->asString()),
+                         adaptString(b->asString())) <= 0;
+  }
+
+  // Bottom-up merge sort, which is stable so that a duplicated key still
+  // finds the first value
+  static void sortKeys(VariantData** keys, VariantData** buffer,
+                       size_t count) {
+    VariantData** from = keys;
+    VariantData** to = buffer;
+    for (size_t width = 1; width < count; width *= 2) {
+      for (size_t lo = 0; lo < count; lo += 2 * width) {
+        size_t mid = lo + width < count ? lo + width : count;
+        size_t hi = mid + width < count ? mid + width : count;
+        size_t i = lo, j = mid, k = lo;
+        while (i < mid && j < hi)
+          to[k++] = keyLessOrEqual(from[i], from[j]) ? from[i++] : from[j++];
+        while (i < mid)
+          to[k++] = from[i++];
+        while (j < hi)
+          to[k++] = from[j++];
+      }
+      swap_(from, to);
+    }
+    if (from != keys)
+      for (size_t i = 0; i < count; i++)
+        keys[i] = from[i];
+  }
+
+  ResourceManager* resources_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A read-only copy of a document, for the configurations and the lookup tables
+// that are read many times.
+// size() and operator[](size_t) run in constant time, and operator[](key)
+// does a binary search, because the members of the objects are sorted by key.
+// Reading doesn't modify anything, not even a cache, so several threads can
+// read the same document.
+class JsonFrozenDocument
+    : public detail::VariantOperators<const JsonFrozenDocument&> {
+  friend class detail::VariantAttorney;
+
+ public:
+  explicit JsonFrozenDocument(
+      JsonVariantConst src,
+      Allocator* alloc = detail::DefaultAllocator::instance())
+      : resources_(alloc) {
+    detail::FrozenDocumentBuilder builder(&resources_);
+    if (builder.build(detail::VariantAttorney::getData(src),
+                      detail::VariantAttorney::getResourceManager(src),
+                      &data_)) {
+      resources_.shrinkToFit();
+    } else {
+      resources_.clear();
+      data_.type = detail::VariantType::Null;
+      overflowed_ = true;
+    }
+    resources_.freeze();
+  }
+
+  // Copy-constructor
+  JsonFrozenDocument(const JsonFrozenDocument& src)
+      : JsonFrozenDocument(src.as<JsonVariantConst>(), src.allocator()) {}
+
+  // Move-constructor
+  JsonFrozenDocument(JsonFrozenDocument&& src)
+      : resources_(detail::DefaultAllocator::instance()) {
+    resources_.freeze();
+    swap(*this, src);
+  }
+
+  JsonFrozenDocument& operator=(JsonFrozenDocument src) {
+    swap(*this, src);
+    return *this;
+  }
+
+  Allocator* allocator() const {
+    return resources_.allocator();
+  }
+
+  // Casts the root to the specified type.
+  template <typename T>
+  T as() const {
+    return getVariant().template as<T>();
+  }
+
+  // Returns true if the root is of the specified type.
+  template <typename T>
+  bool is() const {
+    return getVariant().template is<T>();
+  }
+
+  // Returns true if the root is null.
+  bool isNull() const {
+    return getVariant().isNull();
+  }
+
+  // Returns true if the copy failed because of an allocation failure.
+  // In that case, the document is null.
+  bool overflowed() const {
+    return overflowed_;
+  }
+
+  // Returns the depth (nesting level) of the document.
+  size_t nesting() const {
+    return getVariantImpl().nesting();
+  }
+
+  // Returns the number of elements in the root array or object.
+  size_t size() const {
+    return getVariantImpl().size();
+  }
+
+  // Gets a root object's member.
+  template <typename TString,
+            detail::enable_if_t<detail::IsString<TString>::value, int> = 0>
+  JsonVariantConst operator[](const TString& key) const {
+    return JsonVariantConst(
+        getVariantImpl().getMember(detail::adaptString(key)), &resources_);
+  }
+
+  // Gets a root object's member.
+  template <typename TChar,
+            detail::enable_if_t<detail::IsString<TChar*>::value, int> = 0>
+  JsonVariantConst operator[](TChar* key) const {
+    return JsonVariantConst(
+        getVariantImpl().getMember(detail::adaptString(key)), &resources_);
+  }
+
+  // Gets a root array's element.
+  template <typename T,
+            detail::enable_if_t<detail::is_integral<T>::value, int> = 0>
+  JsonVariantConst operator[](T index) const {
+    return JsonVariantConst(getVariantImpl().getElement(size_t(index)),
+                            &resources_);
+  }
+
+  // Gets a root object's member or a root array's element.
+  template <typename TVariant,
+            detail::enable_if_t<detail::IsVariant<TVariant>::value, int> = 0>
+  JsonVariantConst operator[](const TVariant& key) const {
+    if (key.template is<JsonString>())
+      return operator[](key.template as<JsonString>());
+    if (key.template is<size_t>())
+      return operator[](key.template as<size_t>());
+    return {};
+  }
+
+  operator JsonVariantConst() const {
+    return getVariant();
+  }
+
+  friend void swap(JsonFrozenDocument& a, JsonFrozenDocument& b) {
+    swap(a.resources_, b.resources_);
+    swap_(a.data_, b.data_);
+    detail::swap_(a.overflowed_, b.overflowed_);
+  }
+
+ private:
+  detail::VariantImpl getVariantImpl() const {
+    return detail::VariantImpl(&data_, &resources_);
+  }
+
+  JsonVariantConst getVariant() const {
+    return JsonVariantConst(&data_, &resources_);
+  }
+
+  detail::ResourceManager* getResourceManager() const {
+    return &resources_;
+  }
+
+  const detail::VariantData* getData() const {
+    return &data_;
+  }
+
+  mutable detail::ResourceManager resources_;
+  mutable detail::VariantData data_;
+  bool overflowed_ = false;
+};
+
+inline bool convertToJson(const JsonFrozenDocument& src, JsonVariant dst) {
+  return dst.set(src.as<JsonVariantConst>());
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
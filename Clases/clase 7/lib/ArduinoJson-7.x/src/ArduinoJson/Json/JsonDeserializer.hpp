@@ -10,6 +10,8 @@
 #include <ArduinoJson/Json/Utf16.hpp>
 #include <ArduinoJson/Json/Utf8.hpp>
 #include <ArduinoJson/Memory/ResourceManager.hpp>
+#include <ArduinoJson/Memory/StringBuilder.hpp>
+#include <ArduinoJson/Memory/StringMover.hpp>
 #include <ArduinoJson/Numbers/parseNumber.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
@@ -18,21 +20,58 @@
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
+template <typename TReader>
+class JsonPullParser;
+
+class JsonPushParser;
+
+template <typename TReader>
+class JsonPointerExtractor;
+
+template <typename TReader>
+class JsonDocumentMeasurer;
+
+// Where the deserializer stores the strings: in the ResourceManager or, with
+// deserializeJsonInPlace(), in the input buffer
+template <typename TReader, typename Enable = void>
+struct JsonStringStorage : StringBuilder {
+  JsonStringStorage(ResourceManager* resources, const TReader&)
+      : StringBuilder(resources) {}
+};
+
+template <typename TReader>
+struct JsonStringStorage<
+    TReader, enable_if_t<is_base_of<InPlaceReader, TReader>::value>>
+    : StringMover {
+  JsonStringStorage(ResourceManager* resources, const TReader& reader)
+      : StringMover(resources, reader.buffer()) {}
+};
+
 template <typename TReader>
 class JsonDeserializer {
+  template <typename>
+  friend class JsonPullParser;
+  friend class JsonPushParser;
+  template <typename>
+  friend class JsonPointerExtractor;
+  template <typename>
+  friend class JsonDocumentMeasurer;
+
  public:
   JsonDeserializer(ResourceManager* resources, TReader reader)
-      : stringBuilder_(resources),
+      : stringBuilder_(resources, reader),
         foundSomething_(false),
+        assumeUniqueKeys_(false),
         latch_(reader),
         resources_(resources) {}
 
   template <typename TFilter>
-  DeserializationError parse(VariantData* variant, TFilter filter,
-                             DeserializationOption::NestingLimit nestingLimit) {
+  DeserializationError parse(VariantData* variant,
+                             const DeserializationOptions<TFilter>& options) {
     DeserializationError::Code err;
 
-    err = parseVariant(variant, filter, nestingLimit);
+    assumeUniqueKeys_ = options.assumeUniqueKeys;
+    err = parseVariant(variant, options.filter, options.nestingLimit);
 
     if (!err && latch_.last() != 0 && variant->isFloat()) {
       // We don't detect trailing characters earlier, so we need to check now
@@ -43,6 +82,9 @@ class JsonDeserializer {
   }
 
  private:
+  // The longest number that can be parsed
+  static const size_t maxNumberLength = 63;
+
   char current() {
     return latch_.current();
   }
@@ -277,14 +319,15 @@ class JsonDeserializer {
       TFilter memberFilter = filter[key];
 
       if (memberFilter.allow()) {
-        auto member =
-            VariantImpl::getMember(adaptString(key), object, resources_);
+        VariantData* member = nullptr;
+        if (!assumeUniqueKeys_)
+          member = VariantImpl::getMember(adaptString(key), object, resources_);
         if (!member) {
           auto keyVariant = VariantImpl::addPair(&member, object, resources_);
           if (!keyVariant)
             return DeserializationError::NoMemory;
 
-          stringBuilder_.save(keyVariant);
+          stringBuilder_.saveKey(keyVariant);
         } else {
           VariantImpl::clear(member, resources_);
         }
@@ -399,6 +442,19 @@ class JsonDeserializer {
   }
 
   DeserializationError::Code parseQuotedString() {
+    auto err = readQuotedString(stringBuilder_);
+    if (err)
+      return err;
+
+    if (!stringBuilder_.isValid())
+      return DeserializationError::NoMemory;
+
+    return DeserializationError::Ok;
+  }
+
+  // Unescapes a quoted string and passes its characters to the sink
+  template <typename TSink>
+  DeserializationError::Code readQuotedString(TSink& sink) {
 #if ARDUINOJSON_DECODE_UNICODE
     Utf16::Codepoint codepoint;
     DeserializationError::Code err;
@@ -407,6 +463,8 @@ class JsonDeserializer {
 
     move();
     for (;;) {
+      latch_.appendRun(PlainStringChar(stopChar), sink);
+
       char c = current();
       move();
       if (c == stopChar)
@@ -429,9 +487,9 @@ class JsonDeserializer {
           if (err)
             return err;
           if (codepoint.append(codeunit))
-            Utf8::encodeCodepoint(codepoint.value(), stringBuilder_);
+            Utf8::encodeCodepoint(codepoint.value(), sink);
 #else
-          stringBuilder_.append('\\');
+          sink.append('\\');
 #endif
           continue;
         }
@@ -443,31 +501,31 @@ class JsonDeserializer {
         move();
       }
 
-      stringBuilder_.append(c);
+      sink.append(c);
     }
 
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code parseNonQuotedString() {
+    auto err = readNonQuotedString(stringBuilder_);
+    if (err)
+      return err;
+
     if (!stringBuilder_.isValid())
       return DeserializationError::NoMemory;
 
     return DeserializationError::Ok;
   }
 
-  DeserializationError::Code parseNonQuotedString() {
-    char c = current();
-    ARDUINOJSON_ASSERT(c);
+  template <typename TSink>
+  DeserializationError::Code readNonQuotedString(TSink& sink) {
+    ARDUINOJSON_ASSERT(current());
 
-    if (canBeInNonQuotedString(c)) {  // no quotes
-      do {
-        move();
-        stringBuilder_.append(c);
-        c = current();
-      } while (canBeInNonQuotedString(c));
-    } else {
+    if (!canBeInNonQuotedString(current()))
       return DeserializationError::InvalidInput;
-    }
 
-    if (!stringBuilder_.isValid())
-      return DeserializationError::NoMemory;
+    latch_.appendRun(IsNonQuotedStringChar(), sink);
 
     return DeserializationError::Ok;
   }
@@ -485,6 +543,8 @@ class JsonDeserializer {
 
     move();
     for (;;) {
+      latch_.skipRun(PlainStringChar(stopChar));
+
       char c = current();
       move();
       if (c == stopChar)
@@ -501,50 +561,46 @@ class JsonDeserializer {
   }
 
   DeserializationError::Code skipNonQuotedString() {
-    char c = current();
-    while (canBeInNonQuotedString(c)) {
-      move();
-      c = current();
-    }
+    latch_.skipRun(IsNonQuotedStringChar());
     return DeserializationError::Ok;
   }
 
   DeserializationError::Code parseNumericValue(VariantData* result) {
-    uint8_t n = 0;
-
-    char c = current();
-    while (canBeInNumber(c) && n < 63) {
-      move();
-      buffer_[n++] = c;
-      c = current();
-    }
-    buffer_[n] = 0;
+    const char* end;
+    const char* begin =
+        latch_.readRun(IsNumberChar(), buffer_, sizeof(buffer_), end);
+    return storeNumber(begin, end, result, resources_);
+  }
 
-    auto number = parseNumber(buffer_);
+  static DeserializationError::Code storeNumber(const char* begin,
+                                                const char* end,
+                                                VariantData* result,
+                                                ResourceManager* resources) {
+    auto number = parseNumber(begin, end);
     switch (number.type()) {
       case NumberType::UnsignedInteger:
         if (VariantImpl::setInteger(number.asUnsignedInteger(), result,
-                                    resources_))
+                                    resources))
           return DeserializationError::Ok;
         else
           return DeserializationError::NoMemory;
 
       case NumberType::SignedInteger:
         if (VariantImpl::setInteger(number.asSignedInteger(), result,
-                                    resources_))
+                                    resources))
           return DeserializationError::Ok;
         else
           return DeserializationError::NoMemory;
 
       case NumberType::Float:
-        if (VariantImpl::setFloat(number.asFloat(), result, resources_))
+        if (VariantImpl::setFloat(number.asFloat(), result, resources))
           return DeserializationError::Ok;
         else
           return DeserializationError::NoMemory;
 
 #if ARDUINOJSON_USE_DOUBLE
       case NumberType::Double:
-        if (VariantImpl::setFloat(number.asDouble(), result, resources_))
+        if (VariantImpl::setFloat(number.asDouble(), result, resources))
           return DeserializationError::Ok;
         else
           return DeserializationError::NoMemory;
@@ -556,11 +612,7 @@ class JsonDeserializer {
   }
 
   DeserializationError::Code skipNumericValue() {
-    char c = current();
-    while (canBeInNumber(c)) {
-      move();
-      c = current();
-    }
+    latch_.skipRun(IsNumberChar());
     return DeserializationError::Ok;
   }
 
@@ -601,6 +653,31 @@ class JsonDeserializer {
     return c == '\'' || c == '\"';
   }
 
+  static inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+  }
+
+  // Predicates for the run functions of Latch (all reject '\0')
+  // See PlainStringChar in scanRun.hpp for quoted strings
+
+  struct IsNumberChar {
+    bool operator()(char c) const {
+      return canBeInNumber(c);
+    }
+  };
+
+  struct IsNonQuotedStringChar {
+    bool operator()(char c) const {
+      return canBeInNonQuotedString(c);
+    }
+  };
+
+  struct IsSpace {
+    bool operator()(char c) const {
+      return isSpace(c);
+    }
+  };
+
   static inline uint8_t decodeHex(char c) {
     if (c < 'A')
       return uint8_t(c - '0');
@@ -621,7 +698,7 @@ class JsonDeserializer {
         case '\t':
         case '\r':
         case '\n':
-          move();
+          latch_.skipRun(IsSpace());
           continue;
 
 #if ARDUINOJSON_ENABLE_COMMENTS
@@ -687,13 +764,15 @@ class JsonDeserializer {
     return DeserializationError::Ok;
   }
 
-  StringBuilder stringBuilder_;
+  JsonStringStorage<TReader> stringBuilder_;
   bool foundSomething_;
+  bool assumeUniqueKeys_;
   Latch<TReader> latch_;
   ResourceManager* resources_;
-  char buffer_[64];  // using a member instead of a local variable because it
-                     // ended in the recursive path after compiler inlined the
-                     // code
+  // Holds the numbers when the input is not in RAM; using a member instead of
+  // a local variable because it ended in the recursive path after compiler
+  // inlined the code
+  char buffer_[maxNumberLength];
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -724,4 +803,41 @@ inline DeserializationError deserializeJson(TDestination&& dst, TChar* input,
                                        input, detail::forward<Args>(args)...);
 }
 
+// Parses a JSON input, filters, and puts the result in a JsonDocument.
+// Unlike deserializeJson(), the strings are unescaped in the input buffer and
+// the document points to them instead of copying them. The input is modified
+// and must outlive the document.
+template <typename TDestination, typename... Args,
+          detail::enable_if_t<
+              detail::is_deserialize_destination<TDestination>::value &&
+                  !detail::is_integral<
+                      typename detail::first_or_void<Args...>::type>::value,
+              int> = 0>
+inline DeserializationError deserializeJsonInPlace(TDestination&& dst,
+                                                   char* input,
+                                                   const Args&... args) {
+  using namespace detail;
+  return doDeserialize<JsonDeserializer>(dst, InPlaceReader(input),
+                                         makeDeserializationOptions(args...));
+}
+
+// Parses a JSON input, filters, and puts the result in a JsonDocument.
+// Unlike deserializeJson(), the strings are unescaped in the input buffer and
+// the document points to them instead of copying them. The input is modified
+// and must outlive the document.
+template <typename TDestination, typename TSize, typename... Args,
+          detail::enable_if_t<
+              detail::is_deserialize_destination<TDestination>::value &&
+                  detail::is_integral<TSize>::value,
+              int> = 0>
+inline DeserializationError deserializeJsonInPlace(TDestination&& dst,
+                                                   char* input,
+                                                   TSize inputSize,
+                                                   const Args&... args) {
+  using namespace detail;
+  return doDeserialize<JsonDeserializer>(
+      dst, InPlaceReader(input, size_t(inputSize)),
+      makeDeserializationOptions(args...));
+}
+
 ARDUINOJSON_END_PUBLIC_NAMESPACE
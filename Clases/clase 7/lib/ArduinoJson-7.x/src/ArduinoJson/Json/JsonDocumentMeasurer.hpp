@@ -0,0 +1,264 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+#include <ArduinoJson/Memory/StringBlock.hpp>
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// The memory that deserializeJson() needs for an input.
+// See measureDeserializeJson() and JsonDocument::reserve().
+struct JsonDocumentSize {
+  size_t variantSlots = 0;
+  size_t stringBytes = 0;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Counts the characters of a string instead of storing them
+struct StringLengthCounter {
+  void append(char c) {
+    if (!c)
+      containsNul = true;
+    length++;
+  }
+
+  void append(const char*, size_t n) {  // the runs don't contain '\0'
+    length += n;
+  }
+
+  size_t length = 0;
+  bool containsNul = false;
+};
+
+// Reads a JSON input with the functions of JsonDeserializer and counts the
+// variant slots and the string bytes that parsing it would allocate.
+// The values are skipped with skipVariant(), except the collections and the
+// strings, whose length is counted without storing them.
+template <typename TReader>
+class JsonDocumentMeasurer {
+  using Parser = JsonDeserializer<TReader>;
+
+ public:
+  JsonDocumentMeasurer(ResourceManager* resources, TReader reader)
+      : parser_(resources, reader) {}
+
+  DeserializationError::Code measure(
+      JsonDocumentSize& size,
+      DeserializationOption::NestingLimit nestingLimit) {
+    auto err = measureVariant(nestingLimit);
+    size.variantSlots = slots_;
+    size.stringBytes = stringBytes_;
+    if (foundString_) {
+      // room for the string that StringBuilder grows while it parses, which
+      // can be twice as long as the longest string
+      size_t scratchLength = 2 * longestString_ + 1;
+      if (scratchLength < StringBuilder::initialCapacity)
+        scratchLength = StringBuilder::initialCapacity;
+      size.stringBytes += StringBlock::sizeForLength(scratchLength);
+    }
+    return err;
+  }
+
+ private:
+  DeserializationError::Code measureVariant(
+      DeserializationOption::NestingLimit nestingLimit) {
+    auto err = parser_.skipSpacesAndComments();
+    if (err)
+      return err;
+
+    switch (parser_.current()) {
+      case '[':
+        return measureArray(nestingLimit);
+
+      case '{':
+        return measureObject(nestingLimit);
+
+      case '\"':
+      case '\'':
+        return measureString();
+
+      default:
+        return parser_.skipVariant(nestingLimit);
+    }
+  }
+
+  DeserializationError::Code measureArray(
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening bracket
+    ARDUINOJSON_ASSERT(parser_.current() == '[');
+    parser_.move();
+
+    // Skip spaces
+    err = parser_.skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty array?
+    if (parser_.eat(']'))
+      return DeserializationError::Ok;
+
+    for (;;) {
+      slots_++;
+
+      err = measureVariant(nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = parser_.skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More values?
+      if (parser_.eat(']'))
+        return DeserializationError::Ok;
+      if (!parser_.eat(','))
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  DeserializationError::Code measureObject(
+      DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(parser_.current() == '{');
+    parser_.move();
+
+    // Skip spaces
+    err = parser_.skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty object?
+    if (parser_.eat('}'))
+      return DeserializationError::Ok;
+
+    for (;;) {
+      slots_ += 2;  // the key and the value
+
+      err = measureString();
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = parser_.skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // Colon
+      if (!parser_.eat(':'))
+        return DeserializationError::InvalidInput;
+
+      err = measureVariant(nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = parser_.skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More keys/values?
+      if (parser_.eat('}'))
+        return DeserializationError::Ok;
+      if (!parser_.eat(','))
+        return DeserializationError::InvalidInput;
+
+      // Skip spaces
+      err = parser_.skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+
+  // Counts a string value or a key, which might not be quoted.
+  // The tiny strings are stored in the variants.
+  DeserializationError::Code measureString() {
+    StringLengthCounter counter;
+    auto err = Parser::isQuote(parser_.current())
+                   ? parser_.readQuotedString(counter)
+                   : parser_.readNonQuotedString(counter);
+    if (err)
+      return err;
+
+    foundString_ = true;
+    if (counter.length > longestString_)
+      longestString_ = counter.length;
+    if (counter.length > tinyStringMaxLength || counter.containsNul)
+      stringBytes_ += StringBlock::sizeForLength(counter.length);
+    return DeserializationError::Ok;
+  }
+
+  Parser parser_;
+  size_t slots_ = 0;
+  size_t stringBytes_ = 0;
+  size_t longestString_ = 0;
+  bool foundString_ = false;
+};
+
+template <typename TReader>
+DeserializationError measureJsonDocument(
+    JsonDocumentSize& size, TReader reader,
+    DeserializationOption::NestingLimit nestingLimit) {
+  ResourceManager resources;  // not used: the strings are only counted
+  return JsonDocumentMeasurer<TReader>(&resources, reader)
+      .measure(size, nestingLimit);
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Reads a JSON input without storing it and tells how many variant slots and
+// string bytes deserializeJson() would allocate, so that
+// JsonDocument::reserve() can allocate them at once.
+// It's exact unless a string appears several times, in which case it's an
+// upper bound. The numbers stored in the 8-byte pool and the hash indexes
+// aren't counted.
+template <typename TInput>
+DeserializationError measureDeserializeJson(
+    JsonDocumentSize& size, TInput&& input,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return measureJsonDocument(size, makeReader(detail::forward<TInput>(input)),
+                             nestingLimit);
+}
+
+// Reads a JSON input without storing it and tells how many variant slots and
+// string bytes deserializeJson() would allocate.
+template <typename TChar>
+DeserializationError measureDeserializeJson(
+    JsonDocumentSize& size, TChar* input,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return measureJsonDocument(size, makeReader(input), nestingLimit);
+}
+
+// Reads at most inputSize characters of a JSON input and tells how many
+// variant slots and string bytes deserializeJson() would allocate.
+template <typename TChar, typename TSize,
+          detail::enable_if_t<detail::is_integral<TSize>::value, int> = 0>
+DeserializationError measureDeserializeJson(
+    JsonDocumentSize& size, TChar* input, TSize inputSize,
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return measureJsonDocument(size, makeReader(input, size_t(inputSize)),
+                             nestingLimit);
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
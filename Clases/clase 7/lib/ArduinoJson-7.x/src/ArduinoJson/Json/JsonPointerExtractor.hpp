@@ -0,0 +1,428 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A JSON Pointer (RFC 6901), such as "/candidates/0/content/parts/0/text".
+// The leading slash is optional, except for "/", which designates the key "".
+// "" designates the whole document.
+class JsonPointer {
+ public:
+  // The depth of a null pointer, or of one that is too deep to match anything
+  static const uint8_t invalidDepth = 255;
+
+  JsonPointer() : tokens_(nullptr), depth_(invalidDepth) {}
+
+  explicit JsonPointer(const char* s) : tokens_(s), depth_(invalidDepth) {
+    if (!s)
+      return;
+    if (*s == 0) {
+      depth_ = 0;
+      return;
+    }
+    if (*s == '/')
+      tokens_++;
+    size_t depth = 1;
+    for (const char* p = tokens_; *p; p++)
+      if (*p == '/')
+        depth++;
+    if (depth < invalidDepth)
+      depth_ = uint8_t(depth);
+  }
+
+  bool isValid() const {
+    return depth_ != invalidDepth;
+  }
+
+  // Returns the number of tokens
+  uint8_t depth() const {
+    return depth_;
+  }
+
+  // Returns the token at the given depth, which ends with '/' or '\0'
+  const char* token(uint8_t depth) const {
+    ARDUINOJSON_ASSERT(depth < depth_);
+    const char* p = tokens_;
+    for (; depth > 0; depth--) {
+      while (*p != '/')
+        p++;
+      p++;
+    }
+    return p;
+  }
+
+  // Compares a token with a key, decoding "~0" and "~1"
+  static bool tokenEquals(const char* token, JsonString key) {
+    const char* k = key.c_str();
+    const char* end = k + key.size();
+    while (*token && *token != '/') {
+      char c = *token++;
+      if (c == '~') {
+        if (*token == '0')
+          c = '~';
+        else if (*token == '1')
+          c = '/';
+        else
+          return false;
+        token++;
+      }
+      if (k == end || *k++ != c)
+        return false;
+    }
+    return k == end;
+  }
+
+  // Compares a token with an array index.
+  // The token must be in decimal, without leading zeros.
+  static bool tokenEquals(const char* token, size_t index) {
+    if (*token == '0')
+      return index == 0 && (token[1] == 0 || token[1] == '/');
+    size_t value = 0;
+    const char* p = token;
+    for (; *p >= '0' && *p <= '9'; p++) {
+      if (value > (size_t(-1) - 9) / 10)
+        return false;
+      value = value * 10 + size_t(*p - '0');
+    }
+    return p != token && (*p == 0 || *p == '/') && value == index;
+  }
+
+  // Follows the tokens from the given depth in a value of the document
+  JsonVariantConst resolve(JsonVariantConst variant, uint8_t depth) const {
+    for (; depth < depth_ && !variant.isNull(); depth++) {
+      const char* t = token(depth);
+      JsonVariantConst child;
+      if (variant.is<JsonObjectConst>()) {
+        for (JsonPairConst kv : variant.as<JsonObjectConst>()) {
+          if (tokenEquals(t, kv.key())) {
+            child = kv.value();
+            break;
+          }
+        }
+      } else if (variant.is<JsonArrayConst>()) {
+        size_t i = 0;
+        for (JsonVariantConst element : variant.as<JsonArrayConst>()) {
+          if (tokenEquals(t, i++)) {
+            child = element;
+            break;
+          }
+        }
+      }
+      variant = child;
+    }
+    return variant;
+  }
+
+ private:
+  const char* tokens_;
+  uint8_t depth_;
+};
+
+// Reads a JSON input with the functions of JsonDeserializer and only keeps the
+// values designated by a set of JSON Pointers.
+// The other values are skipped with skipVariant(), so the memory usage only
+// depends on the extracted values (and on the longest key on the path).
+template <typename TReader>
+class JsonPointerExtractor {
+  using Parser = JsonDeserializer<TReader>;
+
+ public:
+  // pointers, results, and depths are arrays of count elements
+  JsonPointerExtractor(ResourceManager* resources, TReader reader,
+                       const JsonPointer* pointers, VariantData** results,
+                       uint8_t* depths, size_t count)
+      : parser_(resources, reader),
+        resources_(resources),
+        pointers_(pointers),
+        results_(results),
+        depths_(depths),
+        count_(count) {}
+
+  DeserializationError::Code extract(
+      DeserializationOption::NestingLimit nestingLimit) {
+    for (size_t i = 0; i < count_; i++)
+      depths_[i] = pointers_[i].isValid() ? 0 : JsonPointer::invalidDepth;
+    return extractVariant(0, nestingLimit);
+  }
+
+ private:
+  // Extracts the values in the variant at the given depth of the path.
+  // A pointer is on the path when its first depths_[i] tokens match it.
+  DeserializationError::Code extractVariant(
+      uint8_t depth, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    size_t found = count_;
+    bool deeper = false;
+    for (size_t i = 0; i < count_; i++) {
+      if (depths_[i] != depth)
+        continue;
+      if (pointers_[i].depth() == depth) {
+        if (found == count_)
+          found = i;
+      } else {
+        deeper = true;
+      }
+    }
+
+    if (found != count_)
+      return extractValue(found, depth, nestingLimit);
+
+    if (!deeper)
+      return parser_.skipVariant(nestingLimit);
+
+    err = parser_.skipSpacesAndComments();
+    if (err)
+      return err;
+
+    switch (parser_.current()) {
+      case '[':
+        return extractArray(depth, nestingLimit);
+
+      case '{':
+        return extractObject(depth, nestingLimit);
+
+      default:  // a scalar can't contain the deeper pointers
+        return parser_.skipVariant(nestingLimit);
+    }
+  }
+
+  // Parses the value designated by pointers_[found], then extracts the other
+  // pointers on the path from the parsed value.
+  DeserializationError::Code extractValue(
+      size_t found, uint8_t depth,
+      DeserializationOption::NestingLimit nestingLimit) {
+    VariantImpl::clear(results_[found], resources_);
+    auto err =
+        parser_.parseVariant(results_[found], AllowAllFilter(), nestingLimit);
+    if (err)
+      return err;
+
+    JsonVariantConst value(results_[found], resources_);
+    for (size_t i = 0; i < count_; i++) {
+      if (i == found || depths_[i] != depth)
+        continue;
+      JsonVariant result(results_[i], resources_);
+      if (!result.set(pointers_[i].resolve(value, depth)))
+        return DeserializationError::NoMemory;
+    }
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code extractArray(
+      uint8_t depth, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening bracket
+    ARDUINOJSON_ASSERT(parser_.current() == '[');
+    parser_.move();
+
+    // Skip spaces
+    err = parser_.skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty array?
+    if (parser_.eat(']'))
+      return DeserializationError::Ok;
+
+    for (size_t index = 0;; index++) {
+      bool matched = false;
+      for (size_t i = 0; i < count_; i++) {
+        if (depths_[i] == depth && pointers_[i].depth() > depth &&
+            JsonPointer::tokenEquals(pointers_[i].token(depth), index)) {
+          depths_[i]++;
+          matched = true;
+        }
+      }
+
+      err = extractChild(matched, depth, nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = parser_.skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More values?
+      if (parser_.eat(']'))
+        return DeserializationError::Ok;
+      if (!parser_.eat(','))
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  DeserializationError::Code extractObject(
+      uint8_t depth, DeserializationOption::NestingLimit nestingLimit) {
+    DeserializationError::Code err;
+
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(parser_.current() == '{');
+    parser_.move();
+
+    // Skip spaces
+    err = parser_.skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty object?
+    if (parser_.eat('}'))
+      return DeserializationError::Ok;
+
+    for (;;) {
+      // Parse key in the string buffer, which is reused for each key
+      err = parser_.parseKey();
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = parser_.skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // Colon
+      if (!parser_.eat(':'))
+        return DeserializationError::InvalidInput;
+
+      JsonString key = parser_.stringBuilder_.str();
+
+      bool matched = false;
+      for (size_t i = 0; i < count_; i++) {
+        if (depths_[i] == depth && pointers_[i].depth() > depth &&
+            JsonPointer::tokenEquals(pointers_[i].token(depth), key)) {
+          depths_[i]++;
+          matched = true;
+        }
+      }
+
+      err = extractChild(matched, depth, nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = parser_.skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More keys/values?
+      if (parser_.eat('}'))
+        return DeserializationError::Ok;
+      if (!parser_.eat(','))
+        return DeserializationError::InvalidInput;
+
+      // Skip spaces
+      err = parser_.skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+
+  // Extracts the pointers that matched the key or the index, or skips the
+  // value if none did
+  DeserializationError::Code extractChild(
+      bool matched, uint8_t depth,
+      DeserializationOption::NestingLimit nestingLimit) {
+    if (!matched)
+      return parser_.skipVariant(nestingLimit);
+
+    auto err = extractVariant(uint8_t(depth + 1), nestingLimit);
+
+    // Back to the parent: the pointers are on its path again
+    for (size_t i = 0; i < count_; i++)
+      if (depths_[i] > depth && depths_[i] != JsonPointer::invalidDepth)
+        depths_[i] = depth;
+
+    return err;
+  }
+
+  Parser parser_;
+  ResourceManager* resources_;
+  const JsonPointer* pointers_;
+  VariantData** results_;
+  uint8_t* depths_;
+  size_t count_;
+};
+
+template <size_t N, typename TReader>
+DeserializationError extractJsonPointers(
+    JsonDocument& doc, TReader reader, const char* const (&pointers)[N],
+    DeserializationOption::NestingLimit nestingLimit) {
+  auto root = VariantAttorney::getOrCreateData(doc);
+  if (!root)
+    return DeserializationError::NoMemory;
+  auto resources = VariantAttorney::getResourceManager(doc);
+  doc.clear();
+
+  JsonPointer parsedPointers[N];
+  VariantData* results[N];
+  uint8_t depths[N];
+
+  root->toArray();
+  for (size_t i = 0; i < N; i++) {
+    parsedPointers[i] = JsonPointer(pointers[i]);
+    results[i] = VariantImpl::addNewElement(root, resources);
+    if (!results[i])
+      return DeserializationError::NoMemory;
+  }
+
+  auto err = JsonPointerExtractor<TReader>(resources, reader, parsedPointers,
+                                          results, depths, N)
+                 .extract(nestingLimit);
+  shrinkJsonDocument(doc);
+  return err;
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Reads a JSON input in one pass and only keeps the values designated by the
+// JSON Pointers (RFC 6901): doc[i] receives the value at pointers[i], or null
+// if there is none.
+// The rest of the input is skipped without allocating memory.
+template <size_t N, typename TInput>
+DeserializationError extractJson(
+    JsonDocument& doc, TInput&& input, const char* const (&pointers)[N],
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return extractJsonPointers(doc, makeReader(detail::forward<TInput>(input)),
+                             pointers, nestingLimit);
+}
+
+// Reads a JSON input in one pass and only keeps the values designated by the
+// JSON Pointers.
+template <size_t N, typename TChar>
+DeserializationError extractJson(
+    JsonDocument& doc, TChar* input, const char* const (&pointers)[N],
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return extractJsonPointers(doc, makeReader(input), pointers, nestingLimit);
+}
+
+// Reads at most inputSize characters of a JSON input and only keeps the values
+// designated by the JSON Pointers.
+template <size_t N, typename TChar, typename TSize,
+          detail::enable_if_t<detail::is_integral<TSize>::value, int> = 0>
+DeserializationError extractJson(
+    JsonDocument& doc, TChar* input, TSize inputSize,
+    const char* const (&pointers)[N],
+    DeserializationOption::NestingLimit nestingLimit = {}) {
+  using namespace detail;
+  return extractJsonPointers(doc, makeReader(input, size_t(inputSize)),
+                             pointers, nestingLimit);
+}
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,359 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+
+#include <string.h>  // strlen
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// The items returned by JsonReader::next()
+enum class JsonEvent : uint8_t {
+  End,    // the root value has been read
+  Error,  // see JsonReader::error()
+  StartObject,
+  EndObject,
+  StartArray,
+  EndArray,
+  Key,
+  String,
+  Number,
+  Boolean,
+  Null,
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Reads a JSON input one event at a time with the functions of
+// JsonDeserializer, but without building a tree.
+// The memory usage is constant: a bit per nesting level and a buffer as large
+// as the longest string.
+template <typename TReader>
+class JsonPullParser {
+ public:
+  JsonPullParser(Allocator* allocator, TReader reader,
+                 DeserializationOption::NestingLimit nestingLimit)
+      : resources_(allocator), parser_(&resources_, reader) {
+    while (!nestingLimit.reached()) {
+      nestingLimit = nestingLimit.decrement();
+      maxDepth_++;
+    }
+  }
+
+  JsonPullParser(const JsonPullParser&) = delete;
+  JsonPullParser& operator=(const JsonPullParser&) = delete;
+
+  JsonEvent next() {
+    if (error_)
+      return JsonEvent::Error;
+
+    if (state_ == Done) {
+      event_ = JsonEvent::End;
+      return event_;
+    }
+
+    auto err = readEvent();
+    if (err) {
+      error_ = err;
+      event_ = JsonEvent::Error;
+    }
+    return event_;
+  }
+
+  DeserializationError error() const {
+    return error_;
+  }
+
+  template <typename T>
+  enable_if_t<(is_integral<T>::value && !is_same<T, bool>::value) ||
+                  is_floating_point<T>::value,
+              T>
+  as() const {
+    return event_ == JsonEvent::Number ? number_.convertTo<T>() : T();
+  }
+
+  template <typename T>
+  enable_if_t<is_same<T, bool>::value, T> as() const {
+    return event_ == JsonEvent::Boolean && boolean_;
+  }
+
+  template <typename T>
+  enable_if_t<is_same<T, JsonString>::value, T> as() const {
+    if (event_ != JsonEvent::Key && event_ != JsonEvent::String)
+      return JsonString();
+    return parser_.stringBuilder_.str();
+  }
+
+  template <typename T>
+  enable_if_t<is_same<T, const char*>::value, T> as() const {
+    return as<JsonString>().c_str();
+  }
+
+ private:
+  enum State : uint8_t {
+    ExpectRoot,
+    ExpectFirstElement,
+    ExpectNextElement,
+    ExpectFirstMember,
+    ExpectNextMember,
+    ExpectMemberValue,
+    Done,
+  };
+
+  using Parser = JsonDeserializer<TReader>;
+
+  DeserializationError::Code readEvent() {
+    DeserializationError::Code err;
+
+    switch (state_) {
+      case ExpectFirstElement:
+      case ExpectNextElement:
+        err = parser_.skipSpacesAndComments();
+        if (err)
+          return err;
+        if (parser_.eat(']'))
+          return endContainer(JsonEvent::EndArray);
+        if (state_ == ExpectNextElement && !parser_.eat(','))
+          return DeserializationError::InvalidInput;
+        return readValue();
+
+      case ExpectFirstMember:
+      case ExpectNextMember:
+        err = parser_.skipSpacesAndComments();
+        if (err)
+          return err;
+        if (parser_.eat('}'))
+          return endContainer(JsonEvent::EndObject);
+        if (state_ == ExpectNextMember) {
+          if (!parser_.eat(','))
+            return DeserializationError::InvalidInput;
+          err = parser_.skipSpacesAndComments();
+          if (err)
+            return err;
+        }
+        return readKey();
+
+      default:  // ExpectRoot or ExpectMemberValue
+        return readValue();
+    }
+  }
+
+  DeserializationError::Code readKey() {
+    DeserializationError::Code err;
+
+    err = parser_.parseKey();
+    if (err)
+      return err;
+
+    err = parser_.skipSpacesAndComments();
+    if (err)
+      return err;
+
+    if (!parser_.eat(':'))
+      return DeserializationError::InvalidInput;
+
+    event_ = JsonEvent::Key;
+    state_ = ExpectMemberValue;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code readValue() {
+    DeserializationError::Code err;
+
+    err = parser_.skipSpacesAndComments();
+    if (err)
+      return err;
+
+    switch (parser_.current()) {
+      case '[':
+        return startContainer(false);
+
+      case '{':
+        return startContainer(true);
+
+      case '\"':
+      case '\'':
+        parser_.stringBuilder_.startString();
+        err = parser_.parseQuotedString();
+        if (err)
+          return err;
+        return endValue(JsonEvent::String);
+
+      case 't':
+        boolean_ = true;
+        err = parser_.skipKeyword("true");
+        if (err)
+          return err;
+        return endValue(JsonEvent::Boolean);
+
+      case 'f':
+        boolean_ = false;
+        err = parser_.skipKeyword("false");
+        if (err)
+          return err;
+        return endValue(JsonEvent::Boolean);
+
+      case 'n':
+        err = parser_.skipKeyword("null");
+        if (err)
+          return err;
+        return endValue(JsonEvent::Null);
+
+      default: {
+        const char* end;
+        const char* begin = parser_.latch_.readRun(
+            typename Parser::IsNumberChar(), parser_.buffer_,
+            sizeof(parser_.buffer_), end);
+        number_ = parseNumber(begin, end);
+        if (number_.type() == NumberType::Invalid)
+          return DeserializationError::InvalidInput;
+        // like JsonDeserializer, nothing can follow a number at the root
+        if (depth_ == 0 && parser_.current() != 0)
+          return DeserializationError::InvalidInput;
+        return endValue(JsonEvent::Number);
+      }
+    }
+  }
+
+  DeserializationError::Code startContainer(bool isObject) {
+    if (depth_ >= maxDepth_)
+      return DeserializationError::TooDeep;
+
+    uint8_t mask = uint8_t(1 << (depth_ % 8));
+    if (isObject)
+      containers_[depth_ / 8] |= mask;
+    else
+      containers_[depth_ / 8] &= uint8_t(~mask);
+    depth_++;
+
+    parser_.move();
+    event_ = isObject ? JsonEvent::StartObject : JsonEvent::StartArray;
+    state_ = isObject ? ExpectFirstMember : ExpectFirstElement;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code endContainer(JsonEvent event) {
+    depth_--;
+    return endValue(event);
+  }
+
+  DeserializationError::Code endValue(JsonEvent event) {
+    event_ = event;
+    if (depth_ == 0)
+      state_ = Done;
+    else if (containers_[(depth_ - 1) / 8] & (1 << ((depth_ - 1) % 8)))
+      state_ = ExpectNextMember;
+    else
+      state_ = ExpectNextElement;
+    return DeserializationError::Ok;
+  }
+
+  ResourceManager resources_;  // only used by the string buffer
+  Parser parser_;
+  Number number_;
+  bool boolean_ = false;
+  JsonEvent event_ = JsonEvent::End;
+  State state_ = ExpectRoot;
+  DeserializationError error_ = DeserializationError::Ok;
+  uint8_t depth_ = 0;
+  uint8_t maxDepth_ = 0;
+  uint8_t containers_[32];  // one bit per level: 1 = object, 0 = array
+};
+
+// How JsonReader<TInput> takes and reads its input
+template <typename TInput, typename Enable = void>
+struct JsonReaderSource {
+  using input_type = TInput&;
+  using reader_type = Reader<TInput>;
+
+  static reader_type makeReader(TInput& input) {
+    return reader_type(input);
+  }
+};
+
+template <typename TSource>
+struct JsonReaderSource<TSource*, enable_if_t<!IsCharOrVoid<TSource>::value>> {
+  using input_type = TSource*;
+  using reader_type = Reader<TSource*>;
+
+  static reader_type makeReader(TSource* input) {
+    return reader_type(input);
+  }
+};
+
+// Character buffers can have a size, so they always use a BoundedReader
+template <typename TChar>
+struct JsonReaderSource<TChar*, enable_if_t<IsCharOrVoid<TChar>::value>> {
+  using input_type = TChar*;
+  using reader_type = BoundedReader<TChar*>;
+
+  static reader_type makeReader(TChar* input) {
+    const char* s = input ? reinterpret_cast<const char*>(input) : "";
+    return reader_type(s, strlen(s));
+  }
+
+  static reader_type makeReader(TChar* input, size_t inputSize) {
+    if (!input)
+      return makeReader(input);
+    return reader_type(input, inputSize);
+  }
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Reads a JSON input one event at a time, without building a JsonDocument.
+// TInput is the type of input, the same as for deserializeJson(): a char
+// pointer, a std::string, a std::istream, a Stream...
+template <typename TInput>
+class JsonReader {
+  using source_type = detail::JsonReaderSource<TInput>;
+
+ public:
+  explicit JsonReader(
+      typename source_type::input_type input,
+      DeserializationOption::NestingLimit nestingLimit = {},
+      Allocator* allocator = detail::DefaultAllocator::instance())
+      : parser_(allocator, source_type::makeReader(input), nestingLimit) {}
+
+  // Reads at most inputSize characters from a char buffer
+  template <typename TSize,
+            detail::enable_if_t<detail::is_integral<TSize>::value, int> = 0>
+  JsonReader(typename source_type::input_type input, TSize inputSize,
+             DeserializationOption::NestingLimit nestingLimit = {},
+             Allocator* allocator = detail::DefaultAllocator::instance())
+      : parser_(allocator, source_type::makeReader(input, size_t(inputSize)),
+                nestingLimit) {}
+
+  // Reads the next event.
+  // Returns JsonEvent::End after the root value, and JsonEvent::Error if the
+  // input is invalid.
+  JsonEvent next() {
+    return parser_.next();
+  }
+
+  // Returns the reason of the last JsonEvent::Error
+  DeserializationError error() const {
+    return parser_.error();
+  }
+
+  // Returns the value that comes with the last event:
+  // - JsonString or const char* for Key and String, valid until next()
+  // - an integral or floating point type for Number
+  // - bool for Boolean
+  template <typename T>
+  T as() const {
+    return parser_.template as<T>();
+  }
+
+ private:
+  detail::JsonPullParser<typename source_type::reader_type> parser_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,531 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+#include <ArduinoJson/Json/scanRun.hpp>
+
+#include <string.h>  // strlen
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Parses a JSON input that comes in chunks of any size.
+// Unlike JsonDeserializer, which pulls the characters from a Reader, this
+// class is a state machine that receives them, so it can stop at the end of a
+// chunk, in the middle of a token, and resume with the next one.
+class JsonPushParser {
+  // for the character classes and storeNumber()
+  using Helpers = JsonDeserializer<BoundedReader<const char*>>;
+
+ public:
+  JsonPushParser(VariantData* root, ResourceManager* resources,
+                 DeserializationOption::NestingLimit nestingLimit)
+      : stringBuilder_(resources), resources_(resources), value_(root) {
+    while (!nestingLimit.reached()) {
+      nestingLimit = nestingLimit.decrement();
+      maxDepth_++;
+    }
+  }
+
+  ~JsonPushParser() {
+    freeStack();
+  }
+
+  JsonPushParser(const JsonPushParser&) = delete;
+  JsonPushParser& operator=(const JsonPushParser&) = delete;
+
+  // Returns Ok when the root value is complete, IncompleteInput when it needs
+  // more characters, or an error.
+  DeserializationError::Code feed(const char* p, const char* end) {
+    if (error_)
+      return error_;
+
+    while (p != end && state_ != Done) {
+      error_ = step(p, end);
+      if (error_)
+        return error_;
+    }
+
+    return state_ == Done ? DeserializationError::Ok
+                          : DeserializationError::IncompleteInput;
+  }
+
+  // Tells that there are no more characters, which is the only way to know
+  // that a number at the root is complete.
+  DeserializationError::Code finish() {
+    if (error_)
+      return error_;
+
+    if (state_ == InNumber && depth_ == 0) {
+      error_ = endNumber();
+      if (error_)
+        return error_;
+    }
+
+    if (state_ == Done)
+      return DeserializationError::Ok;
+
+#if ARDUINOJSON_ENABLE_COMMENTS
+    if (state_ == InCommentStart)  // a single '/'
+      return DeserializationError::InvalidInput;
+    if (state_ > InCommentStart)
+      return DeserializationError::IncompleteInput;
+#endif
+
+    return foundSomething_ ? DeserializationError::IncompleteInput
+                           : DeserializationError::EmptyInput;
+  }
+
+ private:
+  enum State : uint8_t {
+    // between tokens
+    ExpectValue,
+    ExpectFirstElement,
+    ExpectElement,
+    ExpectFirstMember,
+    ExpectKey,
+    ExpectColon,
+    ExpectCommaOrEnd,
+    Done,
+
+    // inside a token
+    InString,
+    InEscape,
+    InUnicode,
+    InNonQuotedKey,
+    InNumber,
+    InKeyword,
+
+    // inside a comment
+    InCommentStart,
+    InBlockComment,
+    InBlockCommentStar,
+    InLineComment,
+  };
+
+  // Consumes one or more characters, or changes the state without consuming
+  // anything when the current token ends
+  DeserializationError::Code step(const char*& p, const char* end) {
+    char c = *p;
+
+    switch (state_) {
+      case InString: {
+        const char* run = scanRun(p, end, PlainStringChar(stopChar_));
+        if (run != p) {
+          stringBuilder_.append(p, size_t(run - p));
+          p = run;
+          return DeserializationError::Ok;
+        }
+        p++;
+        if (c == stopChar_)
+          return endString();
+        if (c == '\\') {
+          state_ = InEscape;
+          return DeserializationError::Ok;
+        }
+        // a NUL ends the input for the other deserializers
+        return DeserializationError::InvalidInput;
+      }
+
+      case InEscape:
+        if (c == 'u') {
+#if ARDUINOJSON_DECODE_UNICODE
+          p++;
+          codeunit_ = 0;
+          hexDigits_ = 0;
+          state_ = InUnicode;
+#else
+          // keep the escape sequence as is
+          stringBuilder_.append('\\');
+          state_ = InString;
+#endif
+          return DeserializationError::Ok;
+        }
+        c = EscapeSequence::unescapeChar(c);
+        if (c == '\0')
+          return DeserializationError::InvalidInput;
+        p++;
+        stringBuilder_.append(c);
+        state_ = InString;
+        return DeserializationError::Ok;
+
+#if ARDUINOJSON_DECODE_UNICODE
+      case InUnicode: {
+        uint8_t digit = Helpers::decodeHex(c);
+        if (digit > 0x0F)
+          return DeserializationError::InvalidInput;
+        p++;
+        codeunit_ = uint16_t((codeunit_ << 4) | digit);
+        if (++hexDigits_ < 4)
+          return DeserializationError::Ok;
+        if (codepoint_.append(codeunit_))
+          Utf8::encodeCodepoint(codepoint_.value(), stringBuilder_);
+        state_ = InString;
+        return DeserializationError::Ok;
+      }
+#endif
+
+      case InNonQuotedKey:
+        if (!Helpers::canBeInNonQuotedString(c))
+          return endString();
+        p++;
+        stringBuilder_.append(c);
+        return DeserializationError::Ok;
+
+      case InNumber:
+        while (Helpers::canBeInNumber(*p)) {
+          if (numberLength_ >= sizeof(number_))
+            return DeserializationError::InvalidInput;
+          number_[numberLength_++] = *p++;
+          if (p == end)
+            return DeserializationError::Ok;
+        }
+        // like deserializeJson(), nothing can follow a number at the root
+        if (depth_ == 0)
+          return DeserializationError::InvalidInput;
+        return endNumber();
+
+      case InKeyword:
+        if (c != *keyword_)
+          return DeserializationError::InvalidInput;
+        p++;
+        if (*++keyword_)
+          return DeserializationError::Ok;
+        return endValue();
+
+#if ARDUINOJSON_ENABLE_COMMENTS
+      case InCommentStart:
+        p++;
+        if (c == '*')
+          state_ = InBlockComment;
+        else if (c == '/')
+          state_ = InLineComment;
+        else
+          return DeserializationError::InvalidInput;
+        return DeserializationError::Ok;
+
+      case InBlockComment:
+        p++;
+        if (c == '*')
+          state_ = InBlockCommentStar;
+        return DeserializationError::Ok;
+
+      case InBlockCommentStar:
+        p++;
+        if (c == '/')
+          state_ = stateAfterComment_;
+        else if (c != '*')
+          state_ = InBlockComment;
+        return DeserializationError::Ok;
+
+      case InLineComment:
+        p++;
+        if (c == '\n')
+          state_ = stateAfterComment_;
+        return DeserializationError::Ok;
+#endif
+
+      default:
+        break;
+    }
+
+    // Between tokens
+    if (Helpers::isSpace(c)) {
+      p++;
+      return DeserializationError::Ok;
+    }
+
+#if ARDUINOJSON_ENABLE_COMMENTS
+    if (c == '/') {
+      p++;
+      stateAfterComment_ = state_;
+      state_ = InCommentStart;
+      return DeserializationError::Ok;
+    }
+#endif
+
+    switch (state_) {
+      case ExpectFirstElement:
+        if (c == ']') {
+          p++;
+          return endContainer();
+        }
+        value_ = VariantImpl::addNewElement(stack_[depth_ - 1], resources_);
+        if (!value_)
+          return DeserializationError::NoMemory;
+        return startValue(p);
+
+      case ExpectElement:
+        value_ = VariantImpl::addNewElement(stack_[depth_ - 1], resources_);
+        if (!value_)
+          return DeserializationError::NoMemory;
+        return startValue(p);
+
+      case ExpectFirstMember:
+        if (c == '}') {
+          p++;
+          return endContainer();
+        }
+        return startKey(p);
+
+      case ExpectKey:
+        return startKey(p);
+
+      case ExpectColon:
+        if (c != ':')
+          return DeserializationError::InvalidInput;
+        p++;
+        state_ = ExpectValue;
+        return DeserializationError::Ok;
+
+      case ExpectCommaOrEnd: {
+        p++;
+        bool inObject = stack_[depth_ - 1]->isObject();
+        if (c == ',') {
+          state_ = inObject ? ExpectKey : ExpectElement;
+          return DeserializationError::Ok;
+        }
+        if (c == (inObject ? '}' : ']'))
+          return endContainer();
+        return DeserializationError::InvalidInput;
+      }
+
+      default:  // ExpectValue
+        foundSomething_ = true;
+        return startValue(p);
+    }
+  }
+
+  DeserializationError::Code startValue(const char*& p) {
+    char c = *p;
+
+    switch (c) {
+      case '[':
+      case '{':
+        if (c == '[')
+          value_->toArray();
+        else
+          value_->toObject();
+        if (depth_ >= maxDepth_)
+          return DeserializationError::TooDeep;
+        if (!pushContainer(value_))
+          return DeserializationError::NoMemory;
+        p++;
+        state_ = c == '[' ? ExpectFirstElement : ExpectFirstMember;
+        return DeserializationError::Ok;
+
+      case '\"':
+      case '\'':
+        p++;
+        startString(c, false);
+        return DeserializationError::Ok;
+
+      case 't':
+        value_->setBoolean(true);
+        return startKeyword(p, "true");
+
+      case 'f':
+        value_->setBoolean(false);
+        return startKeyword(p, "false");
+
+      case 'n':
+        // the variant is already null, except if the same object key was
+        // used twice, in which case the member has been cleared
+        return startKeyword(p, "null");
+
+      default:
+        if (!Helpers::canBeInNumber(c))
+          return DeserializationError::InvalidInput;
+        numberLength_ = 0;
+        state_ = InNumber;
+        return DeserializationError::Ok;
+    }
+  }
+
+  DeserializationError::Code startKey(const char*& p) {
+    char c = *p;
+    if (c == '\"' || c == '\'') {
+      p++;
+      startString(c, true);
+      return DeserializationError::Ok;
+    }
+    if (!Helpers::canBeInNonQuotedString(c))
+      return DeserializationError::InvalidInput;
+    startString(0, true);
+    state_ = InNonQuotedKey;
+    return DeserializationError::Ok;
+  }
+
+  void startString(char stopChar, bool isKey) {
+    stringBuilder_.startString();
+#if ARDUINOJSON_DECODE_UNICODE
+    codepoint_ = Utf16::Codepoint();
+#endif
+    stopChar_ = stopChar;
+    isKey_ = isKey;
+    state_ = InString;
+  }
+
+  DeserializationError::Code startKeyword(const char*& p, const char* s) {
+    p++;
+    keyword_ = s + 1;
+    state_ = InKeyword;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code endString() {
+    if (!stringBuilder_.isValid())
+      return DeserializationError::NoMemory;
+
+    if (!isKey_) {
+      stringBuilder_.save(value_);
+      return endValue();
+    }
+
+    VariantData* object = stack_[depth_ - 1];
+    VariantData* member = VariantImpl::getMember(
+        adaptString(stringBuilder_.str()), object, resources_);
+    if (member) {
+      VariantImpl::clear(member, resources_);
+    } else {
+      auto keyVariant = VariantImpl::addPair(&member, object, resources_);
+      if (!keyVariant)
+        return DeserializationError::NoMemory;
+      stringBuilder_.saveKey(keyVariant);
+    }
+
+    value_ = member;
+    state_ = ExpectColon;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError::Code endNumber() {
+    auto err = Helpers::storeNumber(number_, number_ + numberLength_, value_,
+                                    resources_);
+    if (err)
+      return err;
+    return endValue();
+  }
+
+  DeserializationError::Code endContainer() {
+    depth_--;
+    return endValue();
+  }
+
+  DeserializationError::Code endValue() {
+    if (depth_ > 0) {
+      state_ = ExpectCommaOrEnd;
+      return DeserializationError::Ok;
+    }
+
+    state_ = Done;
+    freeStack();
+#if ARDUINOJSON_AUTO_SHRINK
+    if (!resources_->recycling())
+      resources_->shrinkToFit();
+#endif
+    return DeserializationError::Ok;
+  }
+
+  // The containers being parsed; the array grows with the nesting level
+  bool pushContainer(VariantData* container) {
+    if (depth_ == stackCapacity_) {
+      size_t capacity = depth_ ? depth_ * 2U : 4U;
+      if (capacity > maxDepth_)
+        capacity = maxDepth_;
+      auto allocator = resources_->allocator();
+      size_t bytes = capacity * sizeof(VariantData*);
+      void* stack = stack_ ? allocator->reallocate(stack_, bytes)
+                           : allocator->allocate(bytes);
+      if (!stack)
+        return false;
+      stack_ = static_cast<VariantData**>(stack);
+      stackCapacity_ = uint8_t(capacity);
+    }
+    stack_[depth_++] = container;
+    return true;
+  }
+
+  void freeStack() {
+    if (stack_)
+      resources_->allocator()->deallocate(stack_);
+    stack_ = nullptr;
+    stackCapacity_ = 0;
+  }
+
+  StringBuilder stringBuilder_;
+  ResourceManager* resources_;
+  VariantData* value_;  // where the next value goes
+  VariantData** stack_ = nullptr;
+  const char* keyword_ = nullptr;  // the remaining characters of the keyword
+#if ARDUINOJSON_DECODE_UNICODE
+  Utf16::Codepoint codepoint_;
+  uint16_t codeunit_ = 0;
+  uint8_t hexDigits_ = 0;
+#endif
+  DeserializationError::Code error_ = DeserializationError::Ok;
+  State state_ = ExpectValue;
+  State stateAfterComment_ = ExpectValue;
+  uint8_t depth_ = 0;
+  uint8_t maxDepth_ = 0;
+  uint8_t stackCapacity_ = 0;
+  uint8_t numberLength_ = 0;
+  char stopChar_ = 0;
+  bool isKey_ = false;
+  bool foundSomething_ = false;
+  char number_[Helpers::maxNumberLength];
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Parses a JSON input that arrives in chunks, for example the body of an HTTP
+// response, without keeping the input in memory.
+// Each call to feed() resumes where the previous one stopped, even in the
+// middle of a string, a number, or an escape sequence.
+class JsonStreamParser {
+ public:
+  explicit JsonStreamParser(
+      JsonDocument& doc, DeserializationOption::NestingLimit nestingLimit = {})
+      : parser_(prepare(doc), detail::VariantAttorney::getResourceManager(doc),
+                nestingLimit) {}
+
+  // Parses the next chunk of the input.
+  // Returns Ok when the document is complete, IncompleteInput when more input
+  // is needed, or the error that stopped the parser. The characters after the
+  // end of the document are ignored.
+  DeserializationError feed(const void* input, size_t inputSize) {
+    auto p = reinterpret_cast<const char*>(input);
+    if (!p)
+      return parser_.feed(p, p);
+    return parser_.feed(p, p + inputSize);
+  }
+
+  // Parses the next chunk of the input (NUL-terminated)
+  DeserializationError feed(const char* input) {
+    return feed(input, input ? strlen(input) : 0);
+  }
+
+  // Signals the end of the input.
+  // Returns Ok if the document is complete, EmptyInput or IncompleteInput if
+  // it isn't, or the error returned by feed().
+  // This is only needed if the root value is a number, because feed() can't
+  // know where it ends.
+  DeserializationError finish() {
+    return parser_.finish();
+  }
+
+ private:
+  static detail::VariantData* prepare(JsonDocument& doc) {
+    detail::clearDestination(doc);
+    return detail::VariantAttorney::getOrCreateData(doc);
+  }
+
+  detail::JsonPushParser parser_;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
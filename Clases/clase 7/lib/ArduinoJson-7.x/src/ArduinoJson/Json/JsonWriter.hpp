@@ -0,0 +1,143 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/JsonSerializer.hpp>
+#include <ArduinoJson/Json/TextFormatter.hpp>
+#include <ArduinoJson/Serialization/StreamingWriter.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Writes the tokens of JsonWriter with a TextFormatter: the punctuation, the
+// keys, and the values.
+template <typename TWriter>
+class JsonTokenWriter {
+ public:
+  explicit JsonTokenWriter(TWriter writer)
+      : writer_(writer), formatter_(writer) {}
+
+  JsonTokenWriter& operator=(const JsonTokenWriter&) = delete;
+
+  // Returns the number of bytes sent to the TWriter implementation
+  size_t bytesWritten() const {
+    return formatter_.bytesWritten() + variantBytes_;
+  }
+
+  void beginCollection(bool isObject, size_t) {
+    beginValue();
+    formatter_.writeRaw(isObject ? '{' : '[');
+    needsComma_ = false;
+  }
+
+  void endArray() {
+    formatter_.writeRaw(']');
+    needsComma_ = true;
+  }
+
+  void endObject() {
+    formatter_.writeRaw('}');
+    needsComma_ = true;
+  }
+
+  template <typename TAdaptedString>
+  void writeKey(const TAdaptedString& s) {
+    writeString(s);
+    formatter_.writeRaw(':');
+    needsComma_ = false;
+  }
+
+  void writeString(RamString s) {
+    beginValue();
+    formatter_.writeString(s.data(), s.size());
+    needsComma_ = true;
+  }
+
+  // Strings that can't be read with a pointer, like Flash strings
+  template <typename TAdaptedString>
+  void writeString(const TAdaptedString& s) {
+    beginValue();
+    formatter_.writeRaw('\"');
+    for (size_t i = 0; i < s.size(); i++)
+      formatter_.writeChar(s[i]);
+    formatter_.writeRaw('\"');
+    needsComma_ = true;
+  }
+
+  template <typename T>
+  void writeInteger(T value) {
+    beginValue();
+    formatter_.writeInteger(value);
+    needsComma_ = true;
+  }
+
+  template <typename T>
+  void writeFloat(T value) {
+    beginValue();
+    formatter_.writeFloat(value);
+    needsComma_ = true;
+  }
+
+  void writeBoolean(bool value) {
+    beginValue();
+    formatter_.writeBoolean(value);
+    needsComma_ = true;
+  }
+
+  void writeNull() {
+    beginValue();
+    formatter_.writeRaw("null");
+    needsComma_ = true;
+  }
+
+  void writeVariant(JsonVariantConst variant) {
+    beginValue();
+    variantBytes_ += doSerialize<JsonSerializer, TWriter>(variant, writer_);
+    needsComma_ = true;
+  }
+
+ private:
+  void beginValue() {
+    if (needsComma_)
+      formatter_.writeRaw(',');
+  }
+
+  TWriter writer_;  // for writeVariant(); the formatter has its own copy
+  TextFormatter<TWriter> formatter_;
+  size_t variantBytes_ = 0;
+  bool needsComma_ = false;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Writes a minified JSON document one token at a time, without a JsonDocument.
+// TDestination is the same as for serializeJson(): a std::string, a String, a
+// std::ostream, a Print...
+// The output is sent to the destination at the end of the root value.
+// When ARDUINOJSON_DEBUG is set, a wrong sequence of calls triggers an
+// assertion.
+template <typename TDestination>
+class JsonWriter
+    : public detail::StreamingWriter<detail::JsonTokenWriter, TDestination> {
+  using base_type =
+      detail::StreamingWriter<detail::JsonTokenWriter, TDestination>;
+
+ public:
+  explicit JsonWriter(TDestination& destination) : base_type(destination) {}
+
+  // Writes '['; the elements follow, then endArray()
+  void beginArray() {
+    this->beginCollection(false, detail::WriterValidator::unknownSize);
+  }
+
+  // Writes '{'; the members follow as key() and value() pairs, then
+  // endObject()
+  void beginObject() {
+    this->beginCollection(true, detail::WriterValidator::unknownSize);
+  }
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -4,11 +4,17 @@
 
 #pragma once
 
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Json/scanRun.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
-template <typename TReader>
+// Buffers the current character of the input.
+// The run functions consume consecutive characters that satisfy a predicate;
+// the predicate must return false for '\0'.
+template <typename TReader, typename Enable = void>
 class Latch {
  public:
   Latch(TReader reader) : reader_(reader), loaded_(false) {
@@ -32,6 +38,38 @@ class Latch {
     return current_;
   }
 
+  template <typename TPredicate, typename TSink>
+  void appendRun(TPredicate predicate, TSink& sink) {
+    char c = current();
+    while (predicate(c)) {
+      sink.append(c);
+      clear();
+      c = current();
+    }
+  }
+
+  template <typename TPredicate>
+  void skipRun(TPredicate predicate) {
+    while (predicate(current()))
+      clear();
+  }
+
+  // Reads at most maxLength characters and returns the range that contains
+  // them, which is in buffer
+  template <typename TPredicate>
+  const char* readRun(TPredicate predicate, char* buffer, size_t maxLength,
+                      const char*& end) {
+    size_t n = 0;
+    char c = current();
+    while (n < maxLength && predicate(c)) {
+      buffer[n++] = c;
+      clear();
+      c = current();
+    }
+    end = buffer + n;
+    return buffer;
+  }
+
  private:
   void load() {
     ARDUINOJSON_ASSERT(!ended_);
@@ -53,4 +91,76 @@ class Latch {
 #endif
 };
 
+// When the input is in RAM, the latch is just a pointer in the buffer, and the
+// runs are scanned without going through the reader.
+// NUL-terminated inputs are scanned one char at a time, so that nothing is
+// read past the terminator.
+template <typename TReader>
+class Latch<TReader,
+            enable_if_t<is_base_of<ContiguousReader, TReader>::value>> {
+ public:
+  Latch(const TReader& reader)
+      : ptr_(reader.ptr()),
+        end_(reader.bounded() ? reader.end() : nullptr),
+        bounded_(reader.bounded()) {}
+
+  // Never moves past the end of the input
+  void clear() {
+    if (current())
+      ptr_++;
+  }
+
+  int last() const {
+    return current();
+  }
+
+  FORCE_INLINE char current() const {
+    return ptr_ != end_ ? *ptr_ : 0;
+  }
+
+  template <typename TPredicate, typename TSink>
+  void appendRun(TPredicate predicate, TSink& sink) {
+    const char* p = scan(predicate);
+    sink.append(ptr_, size_t(p - ptr_));
+    ptr_ = p;
+  }
+
+  template <typename TPredicate>
+  void skipRun(TPredicate predicate) {
+    ptr_ = scan(predicate);
+  }
+
+  // Returns the range in the input, buffer is not used
+  template <typename TPredicate>
+  const char* readRun(TPredicate predicate, char*, size_t maxLength,
+                      const char*& end) {
+    const char* begin = ptr_;
+    size_t n = maxLength;
+    if (bounded_ && size_t(end_ - ptr_) < n)
+      n = size_t(end_ - ptr_);
+    while (n && predicate(*ptr_)) {
+      ptr_++;
+      n--;
+    }
+    end = ptr_;
+    return begin;
+  }
+
+ private:
+  // The predicate stops at the NUL terminator
+  template <typename TPredicate>
+  const char* scan(TPredicate predicate) const {
+    if (bounded_)
+      return scanRun(ptr_, end_, predicate);
+    const char* p = ptr_;
+    while (predicate(*p))
+      p++;
+    return p;
+  }
+
+  const char* ptr_;
+  const char* end_;  // null if not bounded_, so that ptr_ never reaches it
+  bool bounded_;
+};
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -8,15 +8,32 @@
 #include <string.h>  // for strlen
 
 #include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/scanRun.hpp>
 #include <ArduinoJson/Numbers/FloatParts.hpp>
 #include <ArduinoJson/Numbers/JsonInteger.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/attributes.hpp>
+#include <ArduinoJson/Polyfills/pgmspace_generic.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 #include <ArduinoJson/Serialization/CountingDecorator.hpp>
 
+#if ARDUINOJSON_ENABLE_SHORTEST_FLOAT
+#  include <ArduinoJson/Numbers/ShortestFloat.hpp>
+#endif
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
+// Returns the digits of 00 to 99, two by two
+// Not a member of TextFormatter, so that there is a single copy of the table
+inline const char* digitPairs() {
+  ARDUINOJSON_DEFINE_PROGMEM_ARRAY(
+      char, pairs,
+      "00010203040506070809101112131415161718192021222324252627282930313233"
+      "34353637383940414243444546474849505152535455565758596061626364656667"
+      "6869707172737475767778798081828384858687888990919293949596979899");
+  return pairs;
+}
+
 template <typename TWriter>
 class TextFormatter {
  public:
@@ -38,17 +55,23 @@ class TextFormatter {
 
   void writeString(const char* value) {
     ARDUINOJSON_ASSERT(value != NULL);
-    writeRaw('\"');
-    while (*value)
-      writeChar(*value++);
-    writeRaw('\"');
+    writeString(value, strlen(value));
   }
 
   void writeString(const char* value, size_t n) {
     ARDUINOJSON_ASSERT(value != NULL);
+    const char* end = value + n;
     writeRaw('\"');
-    while (n--)
-      writeChar(*value++);
+    for (;;) {
+      // copy the characters that don't need escaping in one call
+      const char* p = scanRun(value, end, VerbatimChar());
+      if (p != value)
+        writeRaw(value, p);
+      if (p == end)
+        break;
+      writeChar(*p);
+      value = p + 1;
+    }
     writeRaw('\"');
   }
 
@@ -66,41 +89,18 @@ class TextFormatter {
 
   template <typename T>
   void writeFloat(T value) {
-    writeFloat(JsonFloat(value), sizeof(T) >= 8 ? 9 : 6);
-  }
-
-  void writeFloat(JsonFloat value, int8_t decimalPlaces) {
-    if (isnan(value))
-      return writeRaw(ARDUINOJSON_ENABLE_NAN ? "NaN" : "null");
-
-#if ARDUINOJSON_ENABLE_INFINITY
-    if (value < 0.0) {
-      writeRaw('-');
-      value = -value;
-    }
-
-    if (isinf(value))
-      return writeRaw("Infinity");
+    if (!writeFloatSign(value))
+      return;
+#if ARDUINOJSON_ENABLE_SHORTEST_FLOAT
+    writeShortestFloat(value);
 #else
-    if (isinf(value))
-      return writeRaw("null");
-
-    if (value < 0.0) {
-      writeRaw('-');
-      value = -value;
-    }
+    writePositiveFloat(JsonFloat(value), sizeof(T) >= 8 ? 9 : 6);
 #endif
+  }
 
-    auto parts = decomposeFloat(value, decimalPlaces);
-
-    writeInteger(parts.integral);
-    if (parts.decimalPlaces)
-      writeDecimals(parts.decimal, parts.decimalPlaces);
-
-    if (parts.exponent) {
-      writeRaw('e');
-      writeInteger(parts.exponent);
-    }
+  void writeFloat(JsonFloat value, int8_t decimalPlaces) {
+    if (writeFloatSign(value))
+      writePositiveFloat(value, decimalPlaces);
   }
 
   template <typename T>
@@ -120,32 +120,20 @@ class TextFormatter {
   enable_if_t<is_unsigned<T>::value> writeInteger(T value) {
     char buffer[22];
     char* end = buffer + sizeof(buffer);
-    char* begin = end;
-
-    // write the string in reverse order
-    do {
-      *--begin = char(value % 10 + '0');
-      value = T(value / 10);
-    } while (value);
-
-    // and dump it in the right order
-    writeRaw(begin, end);
+    writeRaw(formatDigits(value, end), end);
   }
 
   void writeDecimals(uint32_t value, int8_t width) {
     // buffer should be big enough for all digits and the dot
     char buffer[16];
     char* end = buffer + sizeof(buffer);
-    char* begin = end;
+    char* begin = formatDigits(value, end);
 
-    // write the string in reverse order
-    while (width--) {
-      *--begin = char(value % 10 + '0');
-      value /= 10;
-    }
+    // pad with leading zeros
+    while (end - begin < width)
+      *--begin = '0';
     *--begin = '.';
 
-    // and dump it in the right order
     writeRaw(begin, end);
   }
 
@@ -172,6 +160,130 @@ class TextFormatter {
 
  protected:
   CountingDecorator<TWriter> writer_;
+
+ private:
+  // Writes NaN and Infinity, or the minus sign of a finite value.
+  // Returns true if the digits of value remain to be written.
+  template <typename T>
+  bool writeFloatSign(T& value) {
+    if (isnan(value)) {
+      writeRaw(ARDUINOJSON_ENABLE_NAN ? "NaN" : "null");
+      return false;
+    }
+
+#if ARDUINOJSON_ENABLE_INFINITY
+    if (value < 0.0) {
+      writeRaw('-');
+      value = -value;
+    }
+
+    if (isinf(value)) {
+      writeRaw("Infinity");
+      return false;
+    }
+#else
+    if (isinf(value)) {
+      writeRaw("null");
+      return false;
+    }
+
+    if (value < 0.0) {
+      writeRaw('-');
+      value = -value;
+    }
+#endif
+
+    return true;
+  }
+
+  void writePositiveFloat(JsonFloat value, int8_t decimalPlaces) {
+    auto parts = decomposeFloat(value, decimalPlaces);
+
+    writeInteger(parts.integral);
+    if (parts.decimalPlaces)
+      writeDecimals(parts.decimal, parts.decimalPlaces);
+
+    if (parts.exponent) {
+      writeRaw('e');
+      writeInteger(parts.exponent);
+    }
+  }
+
+#if ARDUINOJSON_ENABLE_SHORTEST_FLOAT
+  template <typename T>
+  void writeShortestFloat(T value) {
+    if (value == 0)
+      return writeRaw('0');
+
+    DecimalFloat decimal = toShortestDecimal(value);
+
+    char buffer[20];
+    char* end = buffer + sizeof(buffer);
+    char* begin = formatDigits(decimal.significand, end);
+    int digits = int(end - begin);
+
+    // the exponent of the first digit
+    int exponent = digits - 1 + decimal.exponent;
+
+    if (value >= ARDUINOJSON_POSITIVE_EXPONENTIATION_THRESHOLD ||
+        value <= ARDUINOJSON_NEGATIVE_EXPONENTIATION_THRESHOLD) {
+      writeRaw(*begin);
+      if (digits > 1) {
+        writeRaw('.');
+        writeRaw(begin + 1, end);
+      }
+      writeRaw('e');
+      writeInteger(int16_t(exponent));
+    } else if (exponent < 0) {
+      writeRaw("0.");
+      for (int i = -1; i > exponent; i--)
+        writeRaw('0');
+      writeRaw(begin, end);
+    } else if (exponent + 1 < digits) {
+      writeRaw(begin, begin + exponent + 1);
+      writeRaw('.');
+      writeRaw(begin + exponent + 1, end);
+    } else {
+      writeRaw(begin, end);
+      for (int i = digits; i <= exponent; i++)
+        writeRaw('0');
+    }
+  }
+#endif
+
+  // Writes the digits of value before end, two at a time, and returns a
+  // pointer to the first one
+  template <typename T>
+  static char* formatDigits(T value, char* end) {
+    pgm_ptr<char> pairs(digitPairs());
+
+    if (sizeof(T) > 4 && uint64_t(value) >> 32) {
+      // write the last eight digits with 32-bit arithmetic, which is faster
+      char* begin = formatDigits(uint32_t(value % 100000000), end);
+      end -= 8;
+      while (begin > end)
+        *--begin = '0';
+      value = T(value / 100000000);
+      return formatDigits(value, end);
+    }
+
+    while (value >= 100) {
+      intptr_t i = intptr_t(value % 100) * 2;
+      value = T(value / 100);
+      *--end = pairs[i + 1];
+      *--end = pairs[i];
+    }
+
+    if (value >= 10) {
+      intptr_t i = intptr_t(value) * 2;
+      *--end = pairs[i + 1];
+      *--end = pairs[i];
+    } else {
+      *--end = char(value + '0');
+    }
+
+    return end;
+  }
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,286 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/bits.hpp>
+
+#include <stddef.h>  // ptrdiff_t
+#include <stdint.h>  // uint32_t, uint64_t
+#include <string.h>  // memcpy
+
+#define ARDUINOJSON_SCAN_SSE2 0
+#define ARDUINOJSON_SCAN_AVX2 0
+#define ARDUINOJSON_SCAN_NEON 0
+
+#if ARDUINOJSON_ENABLE_SIMD
+#  if defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    undef ARDUINOJSON_SCAN_SSE2
+#    define ARDUINOJSON_SCAN_SSE2 1
+#    include <emmintrin.h>
+#    ifdef __AVX2__
+#      undef ARDUINOJSON_SCAN_AVX2
+#      define ARDUINOJSON_SCAN_AVX2 1
+#      include <immintrin.h>
+#    endif
+#  elif (defined(__ARM_NEON) || defined(__ARM_NEON__) || \
+         defined(_M_ARM64)) &&                           \
+      ARDUINOJSON_LITTLE_ENDIAN
+#    undef ARDUINOJSON_SCAN_NEON
+#    define ARDUINOJSON_SCAN_NEON 1
+#    include <arm_neon.h>
+#  endif
+#endif
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Matches the characters that don't end a quoted string or start an escape
+// sequence
+class PlainStringChar {
+ public:
+  PlainStringChar(char stopChar) : stopChar_(stopChar) {}
+
+  bool operator()(char c) const {
+    return c != stopChar_ && c != '\\' && c != '\0';
+  }
+
+  char stopChar() const {
+    return stopChar_;
+  }
+
+ private:
+  char stopChar_;
+};
+
+// Matches the characters that the serializer copies without looking them up
+// in the escape table: everything but quotes, backslashes, and control chars
+struct VerbatimChar {
+  bool operator()(char c) const {
+    return static_cast<unsigned char>(c) >= 0x20 && c != '"' && c != '\\';
+  }
+};
+
+// Returns a pointer to the first character of [p, end) that doesn't satisfy
+// the predicate, or end if they all do
+template <typename TPredicate>
+inline const char* scanRun(const char* p, const char* end,
+                           TPredicate predicate) {
+  while (p != end && predicate(*p))
+    p++;
+  return p;
+}
+
+#if ARDUINOJSON_ENABLE_SIMD
+
+// Skips the blocks of 4 or 8 bytes that contain no special character, by
+// testing all the bytes of a word at once.
+// Stops at the first block containing a special character and lets the caller
+// find it, so this works regardless of the byte order.
+inline const char* scanBlocksSwar(const char* p, const char* end,
+                                  char stopChar) {
+#  if ARDUINOJSON_SIZEOF_POINTER >= 8
+  using word_t = uint64_t;
+#  else
+  using word_t = uint32_t;
+#  endif
+  const word_t ones = word_t(-1) / 0xFF;  // 0x0101...
+  const word_t highBits = ones * 0x80;    // 0x8080...
+  const word_t quotes = ones * static_cast<unsigned char>(stopChar);
+  const word_t backslashes = ones * static_cast<unsigned char>('\\');
+
+  while (end - p >= static_cast<ptrdiff_t>(sizeof(word_t))) {
+    word_t w;
+    memcpy(&w, p, sizeof(w));  // unaligned load
+    word_t q = w ^ quotes;
+    word_t b = w ^ backslashes;
+    // a byte of x is zero iff (x - 0x01) & ~x has its high bit set
+    word_t zeros = ((w - ones) & ~w) | ((q - ones) & ~q) | ((b - ones) & ~b);
+    if (zeros & highBits)
+      break;
+    p += sizeof(word_t);
+  }
+  return p;
+}
+
+inline const char* scanVerbatimBlocksSwar(const char* p, const char* end) {
+#  if ARDUINOJSON_SIZEOF_POINTER >= 8
+  using word_t = uint64_t;
+#  else
+  using word_t = uint32_t;
+#  endif
+  const word_t ones = word_t(-1) / 0xFF;  // 0x0101...
+  const word_t highBits = ones * 0x80;    // 0x8080...
+  const word_t spaces = ones * 0x20;
+  const word_t quotes = ones * '"';
+  const word_t backslashes = ones * '\\';
+
+  while (end - p >= static_cast<ptrdiff_t>(sizeof(word_t))) {
+    word_t w;
+    memcpy(&w, p, sizeof(w));  // unaligned load
+    word_t q = w ^ quotes;
+    word_t b = w ^ backslashes;
+    // a byte of x is below n iff (x - n) & ~x has its high bit set
+    word_t special =
+        ((w - spaces) & ~w) | ((q - ones) & ~q) | ((b - ones) & ~b);
+    if (special & highBits)
+      break;
+    p += sizeof(word_t);
+  }
+  return p;
+}
+
+#  if ARDUINOJSON_SCAN_SSE2
+inline const char* scanBlocksSse2(const char* p, const char* end,
+                                  char stopChar) {
+#    if ARDUINOJSON_SCAN_AVX2
+  const __m256i quotes32 = _mm256_set1_epi8(stopChar);
+  const __m256i backslashes32 = _mm256_set1_epi8('\\');
+  const __m256i zeros32 = _mm256_setzero_si256();
+  while (end - p >= 32) {
+    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i special = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quotes32),
+                        _mm256_cmpeq_epi8(chunk, backslashes32)),
+        _mm256_cmpeq_epi8(chunk, zeros32));
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+    if (mask)
+      return p + countTrailingZeros(mask);
+    p += 32;
+  }
+#    endif
+
+  const __m128i quotes = _mm_set1_epi8(stopChar);
+  const __m128i backslashes = _mm_set1_epi8('\\');
+  const __m128i zeros = _mm_setzero_si128();
+  while (end - p >= 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i special =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quotes),
+                                  _mm_cmpeq_epi8(chunk, backslashes)),
+                     _mm_cmpeq_epi8(chunk, zeros));
+    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+    if (mask)
+      return p + countTrailingZeros(mask);
+    p += 16;
+  }
+  return p;
+}
+#  endif
+
+#  if ARDUINOJSON_SCAN_SSE2
+inline const char* scanVerbatimBlocksSse2(const char* p, const char* end) {
+  // c < 0x20 iff max(c, 0x1F) == 0x1F
+#    if ARDUINOJSON_SCAN_AVX2
+  const __m256i quotes32 = _mm256_set1_epi8('"');
+  const __m256i backslashes32 = _mm256_set1_epi8('\\');
+  const __m256i controls32 = _mm256_set1_epi8(0x1F);
+  while (end - p >= 32) {
+    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i special = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quotes32),
+                        _mm256_cmpeq_epi8(chunk, backslashes32)),
+        _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, controls32), controls32));
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+    if (mask)
+      return p + countTrailingZeros(mask);
+    p += 32;
+  }
+#    endif
+
+  const __m128i quotes = _mm_set1_epi8('"');
+  const __m128i backslashes = _mm_set1_epi8('\\');
+  const __m128i controls = _mm_set1_epi8(0x1F);
+  while (end - p >= 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i special = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, quotes),
+                     _mm_cmpeq_epi8(chunk, backslashes)),
+        _mm_cmpeq_epi8(_mm_max_epu8(chunk, controls), controls));
+    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+    if (mask)
+      return p + countTrailingZeros(mask);
+    p += 16;
+  }
+  return p;
+}
+#  endif
+
+#  if ARDUINOJSON_SCAN_NEON
+inline const char* scanBlocksNeon(const char* p, const char* end,
+                                  char stopChar) {
+  const uint8x16_t quotes = vdupq_n_u8(static_cast<uint8_t>(stopChar));
+  const uint8x16_t backslashes = vdupq_n_u8('\\');
+  const uint8x16_t zeros = vdupq_n_u8(0);
+  while (end - p >= 16) {
+    uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    uint8x16_t special = vorrq_u8(
+        vorrq_u8(vceqq_u8(chunk, quotes), vceqq_u8(chunk, backslashes)),
+        vceqq_u8(chunk, zeros));
+    // narrow each byte to a nibble: bit 4*i is set iff byte i is special
+    uint64_t mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(special), 4)), 0);
+    if (mask)
+      return p + (countTrailingZeros(mask) >> 2);
+    p += 16;
+  }
+  return p;
+}
+#  endif
+
+#  if ARDUINOJSON_SCAN_NEON
+inline const char* scanVerbatimBlocksNeon(const char* p, const char* end) {
+  const uint8x16_t quotes = vdupq_n_u8('"');
+  const uint8x16_t backslashes = vdupq_n_u8('\\');
+  const uint8x16_t spaces = vdupq_n_u8(0x20);
+  while (end - p >= 16) {
+    uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    uint8x16_t special = vorrq_u8(
+        vorrq_u8(vceqq_u8(chunk, quotes), vceqq_u8(chunk, backslashes)),
+        vcltq_u8(chunk, spaces));
+    // narrow each byte to a nibble: bit 4*i is set iff byte i is special
+    uint64_t mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(special), 4)), 0);
+    if (mask)
+      return p + (countTrailingZeros(mask) >> 2);
+    p += 16;
+  }
+  return p;
+}
+#  endif
+
+// Strings are scanned in blocks of 16 or 32 bytes with SSE2, AVX2, or NEON,
+// or in words of 4 or 8 bytes on other architectures.
+inline const char* scanRun(const char* p, const char* end,
+                           PlainStringChar predicate) {
+#  if ARDUINOJSON_SCAN_SSE2
+  p = scanBlocksSse2(p, end, predicate.stopChar());
+#  elif ARDUINOJSON_SCAN_NEON
+  p = scanBlocksNeon(p, end, predicate.stopChar());
+#  else
+  p = scanBlocksSwar(p, end, predicate.stopChar());
+#  endif
+  while (p != end && predicate(*p))
+    p++;
+  return p;
+}
+
+inline const char* scanRun(const char* p, const char* end,
+                           VerbatimChar predicate) {
+#  if ARDUINOJSON_SCAN_SSE2
+  p = scanVerbatimBlocksSse2(p, end);
+#  elif ARDUINOJSON_SCAN_NEON
+  p = scanVerbatimBlocksNeon(p, end);
+#  else
+  p = scanVerbatimBlocksSwar(p, end);
+#  endif
+  while (p != end && predicate(*p))
+    p++;
+  return p;
+}
+
+#endif  // ARDUINOJSON_ENABLE_SIMD
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,148 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Alignment.hpp>
+#include <ArduinoJson/Memory/Allocator.hpp>
+
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// An allocator that cuts the blocks out of large chunks, for the documents
+// that live and die together, like the request and the response of a server.
+// deallocate() does nothing; call reset() to recycle all the memory once no
+// document uses it, or release() to return the chunks to the upstream
+// allocator.
+class ArenaAllocator : public Allocator {
+ public:
+  explicit ArenaAllocator(
+      size_t chunkSize = 4096,
+      Allocator* upstream = detail::DefaultAllocator::instance())
+      : chunkSize_(chunkSize), upstream_(upstream) {}
+
+  ArenaAllocator(const ArenaAllocator&) = delete;
+  ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+  virtual ~ArenaAllocator() {
+    release();
+  }
+
+  void* allocate(size_t size) override {
+    size_t blockSize = blockHeaderSize + detail::addPadding(size);
+    if (!current_ || used_ + blockSize > current_->capacity) {
+      if (!useNextChunk(blockSize))
+        return nullptr;
+    }
+    char* block = payload(current_) + used_;
+    used_ += blockSize;
+    *reinterpret_cast<size_t*>(block) = size;
+    last_ = block + blockHeaderSize;
+    return last_;
+  }
+
+  void deallocate(void*) override {}
+
+  void* reallocate(void* ptr, size_t size) override {
+    if (!ptr)
+      return allocate(size);
+    auto header = reinterpret_cast<size_t*>(static_cast<char*>(ptr) -
+                                            blockHeaderSize);
+
+    // the last block grows or shrinks in place when the chunk allows it
+    if (ptr == last_) {
+      size_t end = size_t(static_cast<char*>(ptr) - payload(current_)) +
+                   detail::addPadding(size);
+      if (end <= current_->capacity) {
+        used_ = end;
+        *header = size;
+        return ptr;
+      }
+    } else if (size <= *header) {
+      *header = size;
+      return ptr;
+    }
+
+    void* copy = allocate(size);
+    if (!copy)
+      return nullptr;
+    memcpy(copy, ptr, *header < size ? *header : size);
+    return copy;
+  }
+
+  // Makes all the chunks available again.
+  // The blocks allocated so far must not be used anymore.
+  void reset() {
+    current_ = chunks_;
+    used_ = 0;
+    last_ = nullptr;
+  }
+
+  // Returns all the chunks to the upstream allocator.
+  // The blocks allocated so far must not be used anymore.
+  void release() {
+    while (chunks_) {
+      Chunk* next = chunks_->next;
+      upstream_->deallocate(chunks_);
+      chunks_ = next;
+    }
+    reset();
+  }
+
+  // Returns the total size of the chunks, in bytes.
+  size_t capacity() const {
+    size_t total = 0;
+    for (Chunk* chunk = chunks_; chunk; chunk = chunk->next)
+      total += chunk->capacity;
+    return total;
+  }
+
+ private:
+  struct Chunk {
+    Chunk* next;
+    size_t capacity;
+  };
+
+  static const size_t chunkHeaderSize =
+      detail::AddPadding<sizeof(Chunk)>::value;
+  static const size_t blockHeaderSize =
+      detail::AddPadding<sizeof(size_t)>::value;
+
+  static char* payload(Chunk* chunk) {
+    return reinterpret_cast<char*>(chunk) + chunkHeaderSize;
+  }
+
+  // Moves to the next chunk, or inserts a new one after the current one if
+  // there is none or if it's too small
+  bool useNextChunk(size_t minCapacity) {
+    Chunk* next = current_ ? current_->next : chunks_;
+    if (!next || next->capacity < minCapacity) {
+      size_t capacity = chunkSize_ > minCapacity ? chunkSize_ : minCapacity;
+      auto chunk = static_cast<Chunk*>(
+          upstream_->allocate(chunkHeaderSize + capacity));
+      if (!chunk)
+        return false;
+      chunk->capacity = capacity;
+      chunk->next = next;
+      if (current_)
+        current_->next = chunk;
+      else
+        chunks_ = chunk;
+      next = chunk;
+    }
+    current_ = next;
+    used_ = 0;
+    return true;
+  }
+
+  size_t chunkSize_;
+  Allocator* upstream_;
+  Chunk* chunks_ = nullptr;   // in the order they are used
+  Chunk* current_ = nullptr;  // the chunk that serves the allocations
+  size_t used_ = 0;           // in the current chunk
+  void* last_ = nullptr;      // the last block, which can grow in place
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
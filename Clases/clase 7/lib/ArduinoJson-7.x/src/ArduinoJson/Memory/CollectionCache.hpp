@@ -0,0 +1,86 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/MemoryPool.hpp>
+
+#include <stddef.h>  // size_t
+
+#if ARDUINOJSON_COLLECTION_CACHE_SIZE
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+struct VariantData;
+
+// Remembers the number of slots of the most recently used collections, and the
+// position of the last accessed element, so that size() and sequential
+// indexing don't have to walk the list from the head.
+// (CollectionData has no room for these without making every slot bigger.)
+class CollectionCache {
+ public:
+  static constexpr size_t unknownSize = size_t(-1);
+
+  struct Entry {
+    const VariantData* collection;
+    size_t slotCount;  // or unknownSize
+    size_t index;      // position of the cursor
+    SlotId slot;       // slot of the cursor, or NULL_SLOT if none
+  };
+
+  CollectionCache() {
+    clear();
+  }
+
+  // Returns the entry of the collection, or null if it isn't cached
+  Entry* find(const VariantData* collection) {
+    for (size_t i = 0; i < ARDUINOJSON_COLLECTION_CACHE_SIZE; i++) {
+      if (entries_[i].collection == collection)
+        return moveToFront(i);
+    }
+    return nullptr;
+  }
+
+  // Returns the entry of the collection, replacing the least recently used
+  // entry if the collection isn't cached
+  Entry* get(const VariantData* collection) {
+    ARDUINOJSON_ASSERT(collection != nullptr);
+    auto entry = find(collection);
+    if (entry)
+      return entry;
+    entry = moveToFront(ARDUINOJSON_COLLECTION_CACHE_SIZE - 1);
+    entry->collection = collection;
+    entry->slotCount = unknownSize;
+    entry->index = 0;
+    entry->slot = NULL_SLOT;
+    return entry;
+  }
+
+  void remove(const VariantData* collection) {
+    for (size_t i = 0; i < ARDUINOJSON_COLLECTION_CACHE_SIZE; i++) {
+      if (entries_[i].collection == collection)
+        entries_[i].collection = nullptr;
+    }
+  }
+
+  void clear() {
+    for (size_t i = 0; i < ARDUINOJSON_COLLECTION_CACHE_SIZE; i++)
+      entries_[i].collection = nullptr;
+  }
+
+ private:
+  Entry* moveToFront(size_t i) {
+    auto entry = entries_[i];
+    for (; i > 0; i--)
+      entries_[i] = entries_[i - 1];
+    entries_[0] = entry;
+    return &entries_[0];
+  }
+
+  Entry entries_[ARDUINOJSON_COLLECTION_CACHE_SIZE];
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+#endif
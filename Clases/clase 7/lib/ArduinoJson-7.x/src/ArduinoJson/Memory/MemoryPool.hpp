@@ -80,6 +80,12 @@ class MemoryPool {
     usage_ = 0;
   }
 
+  // Forgets the slots after the first n
+  void truncate(SlotCount n) {
+    ARDUINOJSON_ASSERT(n <= usage_);
+    usage_ = n;
+  }
+
   void shrinkToFit(Allocator* allocator) {
     auto newSlots = reinterpret_cast<T*>(
         allocator->reallocate(slots_, slotsToBytes(usage_)));
@@ -93,6 +99,10 @@ class MemoryPool {
     return usage_;
   }
 
+  SlotCount capacity() const {
+    return capacity_;
+  }
+
   static SlotCount bytesToSlots(size_t n) {
     return static_cast<SlotCount>(n / sizeof(T));
   }
@@ -6,6 +6,7 @@
 
 #include <ArduinoJson/Memory/MemoryPool.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/bits.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
 
 #include <string.h>  // memcpy
@@ -14,6 +15,25 @@ ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 using PoolCount = SlotId;
 
+constexpr size_t countPoolGrowthSteps(size_t ratio) {
+  return ratio <= 1 ? 0 : 1 + countPoolGrowthSteps(ratio / 2);
+}
+
+// Number of times the capacity of the pools doubles
+const size_t POOL_GROWTH_STEPS = countPoolGrowthSteps(
+    ARDUINOJSON_MAX_POOL_CAPACITY / ARDUINOJSON_POOL_CAPACITY);
+
+static_assert(size_t(ARDUINOJSON_POOL_CAPACITY) << POOL_GROWTH_STEPS ==
+                  size_t(ARDUINOJSON_MAX_POOL_CAPACITY),
+              "ARDUINOJSON_MAX_POOL_CAPACITY must be ARDUINOJSON_POOL_CAPACITY "
+              "times a power of two");
+
+// The pools double in size until they reach ARDUINOJSON_MAX_POOL_CAPACITY, so
+// the pool k starts at id ARDUINOJSON_POOL_CAPACITY * (2^k - 1) during the
+// growth, and a bit scan finds the pool of an id.
+// reserve() can make the first pool larger, in which case the ids of the
+// other pools are shifted by the extra capacity.
+
 template <typename T>
 class MemoryPoolList {
   struct FreeSlot {
@@ -29,6 +49,7 @@ class MemoryPoolList {
 
   ~MemoryPoolList() {
     ARDUINOJSON_ASSERT(count_ == 0);
+    ARDUINOJSON_ASSERT(spareCount_ == 0);
   }
 
   friend void swap(MemoryPoolList& a, MemoryPoolList& b) {
@@ -42,13 +63,13 @@ class MemoryPoolList {
         swap_(a.preallocatedPools_[i], b.preallocatedPools_[i]);
     } else if (bUsedPreallocated) {
       // only b => copy b's preallocated pools and give him a's pointer
-      for (PoolCount i = 0; i < b.count_; i++)
+      for (PoolCount i = 0; i < b.poolCount(); i++)
         a.preallocatedPools_[i] = b.preallocatedPools_[i];
       b.pools_ = a.pools_;
       a.pools_ = a.preallocatedPools_;
     } else if (aUsedPreallocated) {
       // only a => copy a's preallocated pools and give him b's pointer
-      for (PoolCount i = 0; i < a.count_; i++)
+      for (PoolCount i = 0; i < a.poolCount(); i++)
         b.preallocatedPools_[i] = a.preallocatedPools_[i];
       a.pools_ = b.pools_;
       b.pools_ = b.preallocatedPools_;
@@ -58,12 +79,15 @@ class MemoryPoolList {
     }
 
     swap_(a.count_, b.count_);
+    swap_(a.spareCount_, b.spareCount_);
     swap_(a.capacity_, b.capacity_);
+    swap_(a.firstCapacity_, b.firstCapacity_);
     swap_(a.freeList_, b.freeList_);
   }
 
   MemoryPoolList& operator=(MemoryPoolList&& src) {
     ARDUINOJSON_ASSERT(count_ == 0);
+    ARDUINOJSON_ASSERT(spareCount_ == 0);
     if (src.pools_ == src.preallocatedPools_) {
       memcpy(preallocatedPools_, src.preallocatedPools_,
              sizeof(preallocatedPools_));
@@ -73,8 +97,11 @@ class MemoryPoolList {
       src.pools_ = nullptr;
     }
     count_ = src.count_;
+    spareCount_ = src.spareCount_;
     capacity_ = src.capacity_;
+    firstCapacity_ = src.firstCapacity_;
     src.count_ = 0;
+    src.spareCount_ = 0;
     src.capacity_ = 0;
     return *this;
   }
@@ -108,16 +135,18 @@ class MemoryPoolList {
   T* getSlot(SlotId id) const {
     if (id == NULL_SLOT)
       return nullptr;
-    auto poolIndex = SlotId(id / ARDUINOJSON_POOL_CAPACITY);
-    auto indexInPool = SlotId(id % ARDUINOJSON_POOL_CAPACITY);
+    size_t index;
+    auto poolIndex = poolIndexOf(id, index);
     ARDUINOJSON_ASSERT(poolIndex < count_);
-    return pools_[poolIndex].getSlot(indexInPool);
+    return pools_[poolIndex].getSlot(SlotId(index));
   }
 
   void clear(Allocator* allocator) {
-    for (PoolCount i = 0; i < count_; i++)
+    for (PoolCount i = 0; i < poolCount(); i++)
       pools_[i].destroy(allocator);
     count_ = 0;
+    spareCount_ = 0;
+    firstCapacity_ = ARDUINOJSON_POOL_CAPACITY;
     freeList_ = NULL_SLOT;
     if (pools_ != preallocatedPools_) {
       allocator->deallocate(pools_);
@@ -126,6 +155,38 @@ class MemoryPoolList {
     }
   }
 
+  // Empties the pools, but keeps them for the next allocations
+  void recycle() {
+    for (PoolCount i = 0; i < count_; i++)
+      pools_[i].clear();
+    spareCount_ = PoolCount(spareCount_ + count_);
+    count_ = 0;
+    freeList_ = NULL_SLOT;
+  }
+
+  // Creates the first pool with room for the given number of slots, so that
+  // they come from a single allocation. The list must be empty; the pool is
+  // a spare until the first allocation.
+  bool reserve(size_t capacity, Allocator* allocator) {
+    ARDUINOJSON_ASSERT(poolCount() == 0);
+    if (capacity < ARDUINOJSON_POOL_CAPACITY)
+      capacity = ARDUINOJSON_POOL_CAPACITY;
+    if (capacity > NULL_SLOT)
+      capacity = NULL_SLOT;
+    pools_[0].create(SlotCount(capacity), allocator);
+    if (pools_[0].capacity() == 0)
+      return false;
+    firstCapacity_ = SlotCount(capacity);
+    spareCount_ = 1;
+    return true;
+  }
+
+  // Releases the pools kept by recycle() that are still empty
+  void releaseSpares(Allocator* allocator) {
+    while (spareCount_)
+      pools_[count_ + --spareCount_].destroy(allocator);
+  }
+
   SlotCount usage() const {
     SlotCount total = 0;
     for (PoolCount i = 0; i < count_; i++)
@@ -137,7 +198,47 @@ class MemoryPoolList {
     return Pool::slotsToBytes(usage());
   }
 
+  // Returns one more than the highest id that was allocated, free or not
+  size_t idCount() const {
+    if (!count_)
+      return 0;
+    return poolStart(count_ - 1) + pools_[count_ - 1].usage();
+  }
+
+  // Returns the first id, starting at id, that was allocated from a pool.
+  // There are holes in the ids when shrinkToFit() was called before a new pool
+  // was added.
+  SlotId firstAllocatedId(SlotId id) const {
+    for (;;) {
+      auto poolIndex = poolIndexOf(id);
+      ARDUINOJSON_ASSERT(poolIndex < count_);
+      if (id - poolStart(poolIndex) < pools_[poolIndex].usage())
+        return id;
+      id = SlotId(poolStart(poolIndex + 1U));
+    }
+  }
+
+  void swapSlots(SlotId a, SlotId b) {
+    swap_(*getSlot(a), *getSlot(b));
+  }
+
+  // Keeps the slots whose ids are lower than end, and releases the pools that
+  // don't contain any of them. The free slots are forgotten.
+  void truncate(size_t end, Allocator* allocator) {
+    releaseSpares(allocator);
+    freeList_ = NULL_SLOT;
+    if (!end) {
+      clear(allocator);
+      return;
+    }
+    auto lastPool = poolIndexOf(end - 1);
+    while (count_ > lastPool + 1)
+      pools_[--count_].destroy(allocator);
+    pools_[lastPool].truncate(SlotCount(end - poolStart(lastPool)));
+  }
+
   void shrinkToFit(Allocator* allocator) {
+    releaseSpares(allocator);
     if (count_ > 0)
       pools_[count_ - 1].shrinkToFit(allocator);
     if (pools_ != preallocatedPools_ && count_ != capacity_) {
@@ -163,26 +264,33 @@ class MemoryPoolList {
     auto slot = pools_[poolIndex].allocSlot();
     if (!slot)
       return {};
-    return {slot.ptr(),
-            SlotId(poolIndex * ARDUINOJSON_POOL_CAPACITY + slot.id())};
+    return {slot.ptr(), SlotId(poolStart(poolIndex) + slot.id())};
   }
 
   Pool* addPool(Allocator* allocator) {
-    if (count_ == capacity_ && !increaseCapacity(allocator))
-      return nullptr;
-    auto pool = &pools_[count_++];
-    SlotCount poolCapacity = ARDUINOJSON_POOL_CAPACITY;
-    if (count_ == maxPools)  // last pool is smaller because of NULL_SLOT
-      poolCapacity--;
-    pool->create(poolCapacity, allocator);
+    if (spareCount_) {  // reuse a pool emptied by recycle()
+      spareCount_--;
+      auto pool = &pools_[count_++];
+      if (pool->capacity() > 0)
+        return pool;
+      pool->destroy(allocator);  // its allocation had failed
+    } else {
+      if (count_ == maxPools())
+        return nullptr;
+      if (count_ == capacity_ && !increaseCapacity(allocator))
+        return nullptr;
+      count_++;
+    }
+    auto pool = &pools_[count_ - 1];
+    pool->create(poolCapacity(count_ - 1U), allocator);
     return pool;
   }
 
   bool increaseCapacity(Allocator* allocator) {
-    if (capacity_ == maxPools)
-      return false;
     void* newPools;
     auto newCapacity = PoolCount(capacity_ * 2);
+    if (newCapacity > maxPools() || newCapacity < capacity_)
+      newCapacity = maxPools();
 
     if (pools_ == preallocatedPools_) {
       newPools = allocator->allocate(newCapacity * sizeof(Pool));
@@ -200,15 +308,91 @@ class MemoryPoolList {
     return true;
   }
 
+  // The pools in use, followed by the spare ones
+  PoolCount poolCount() const {
+    return PoolCount(count_ + spareCount_);
+  }
+
   Pool preallocatedPools_[ARDUINOJSON_INITIAL_POOL_COUNT];
   Pool* pools_ = preallocatedPools_;
   PoolCount count_ = 0;
+  PoolCount spareCount_ = 0;  // emptied by recycle(), after the ones in use
   PoolCount capacity_ = ARDUINOJSON_INITIAL_POOL_COUNT;
+  SlotCount firstCapacity_ = ARDUINOJSON_POOL_CAPACITY;  // see reserve()
   SlotId freeList_ = NULL_SLOT;
 
  public:
-  static const PoolCount maxPools =
-      PoolCount(NULL_SLOT / ARDUINOJSON_POOL_CAPACITY + 1);
+  // Returns the index of the pool that contains the id, and stores the index
+  // of the slot in that pool
+  PoolCount poolIndexOf(size_t id, size_t& index) const {
+    if (id < firstCapacity_) {
+      index = id;
+      return 0;
+    }
+    return locate(id - extraCapacity(), index);
+  }
+
+  // Returns the index of the pool that contains the id
+  PoolCount poolIndexOf(size_t id) const {
+    size_t index;
+    return poolIndexOf(id, index);
+  }
+
+  // Returns the first id of the pool
+  size_t poolStart(size_t poolIndex) const {
+    if (poolIndex == 0)
+      return 0;
+    return defaultPoolStart(poolIndex) + extraCapacity();
+  }
+
+  // Returns the number of slots of the pool; the last one is smaller because
+  // no id can be NULL_SLOT
+  SlotCount poolCapacity(size_t poolIndex) const {
+    if (poolIndex == 0)
+      return firstCapacity_;
+    size_t capacity = size_t(ARDUINOJSON_POOL_CAPACITY)
+                      << (poolIndex < POOL_GROWTH_STEPS ? poolIndex
+                                                        : POOL_GROWTH_STEPS);
+    size_t available = NULL_SLOT - poolStart(poolIndex);
+    return SlotCount(capacity < available ? capacity : available);
+  }
+
+  PoolCount maxPools() const {
+    return PoolCount(poolIndexOf(NULL_SLOT - 1U) + 1);
+  }
+
+ private:
+  size_t extraCapacity() const {
+    return firstCapacity_ - size_t(ARDUINOJSON_POOL_CAPACITY);
+  }
+
+  // Same as poolIndexOf() when the first pool has the default capacity
+  static PoolCount locate(size_t id, size_t& index) {
+    const size_t capacity = ARDUINOJSON_POOL_CAPACITY;
+    if (POOL_GROWTH_STEPS == 0) {
+      index = id % capacity;
+      return PoolCount(id / capacity);
+    }
+    size_t n = id + capacity;  // capacity * 2^k + index in the pool k
+    if (n < capacity << (POOL_GROWTH_STEPS + 1)) {
+      auto poolIndex = 63 - countLeadingZeros(n / capacity);
+      index = n - (capacity << poolIndex);
+      return PoolCount(poolIndex);
+    }
+    const size_t maxCapacity = capacity << POOL_GROWTH_STEPS;
+    n -= capacity << (POOL_GROWTH_STEPS + 1);
+    index = n % maxCapacity;
+    return PoolCount(POOL_GROWTH_STEPS + 1 + n / maxCapacity);
+  }
+
+  // Same as poolStart() when the first pool has the default capacity
+  static size_t defaultPoolStart(size_t poolIndex) {
+    if (poolIndex <= POOL_GROWTH_STEPS)
+      return ARDUINOJSON_POOL_CAPACITY * ((size_t(1) << poolIndex) - 1);
+    return ARDUINOJSON_POOL_CAPACITY *
+           ((size_t(2) << POOL_GROWTH_STEPS) - 1 +
+            ((poolIndex - POOL_GROWTH_STEPS - 1) << POOL_GROWTH_STEPS));
+  }
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
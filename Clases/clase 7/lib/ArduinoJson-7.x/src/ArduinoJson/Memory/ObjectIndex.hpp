@@ -0,0 +1,59 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/MemoryPool.hpp>
+
+#include <stddef.h>  // offsetof
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+struct VariantData;
+
+// An open-addressing hash table (linear probing) that maps the keys of an
+// object to their slots.
+// The members are indexed in order, up to lastValue; the members appended after
+// that are indexed lazily on the next lookup.
+struct ObjectIndex {
+  ObjectIndex* next;
+  const VariantData* object;
+  SlotId lastValue;
+  size_t size;
+  size_t capacity;  // always a power of two
+  SlotId keys[1];
+
+  static constexpr size_t sizeForCapacity(size_t n) {
+    return offsetof(ObjectIndex, keys) + n * sizeof(SlotId);
+  }
+
+  static ObjectIndex* create(const VariantData* object, size_t capacity,
+                             Allocator* allocator) {
+    ARDUINOJSON_ASSERT((capacity & (capacity - 1)) == 0);
+    auto index = reinterpret_cast<ObjectIndex*>(
+        allocator->allocate(sizeForCapacity(capacity)));
+    if (!index)
+      return nullptr;
+    index->capacity = capacity;
+    index->reset(object);
+    return index;
+  }
+
+  // Empties the index and assigns it to another object
+  void reset(const VariantData* obj) {
+    next = nullptr;
+    object = obj;
+    lastValue = NULL_SLOT;
+    size = 0;
+    for (size_t i = 0; i < capacity; i++)
+      keys[i] = NULL_SLOT;
+  }
+
+  static void destroy(ObjectIndex* index, Allocator* allocator) {
+    allocator->deallocate(index);
+  }
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -5,23 +5,42 @@
 #pragma once
 
 #include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/CollectionCache.hpp>
 #include <ArduinoJson/Memory/MemoryPoolList.hpp>
+#include <ArduinoJson/Memory/ObjectIndex.hpp>
+#include <ArduinoJson/Memory/StringInternTable.hpp>
 #include <ArduinoJson/Memory/StringPool.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
 #include <ArduinoJson/Strings/StringAdapters.hpp>
 #include <ArduinoJson/Variant/VariantData.hpp>
 
+#include <string.h>  // memcpy
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 class VariantWithId;
 
 class ResourceManager {
  public:
-  ResourceManager(Allocator* allocator = DefaultAllocator::instance())
-      : allocator_(allocator), overflowed_(false) {}
+  ResourceManager(Allocator* allocator = DefaultAllocator::instance(),
+                  StringInternTable* internTable = nullptr)
+      : allocator_(allocator),
+        internTable_(internTable),
+        overflowed_(false),
+        frozen_(false),
+        recycling_(false) {
+    if (internTable_)
+      internTable_->attach();
+  }
 
   ~ResourceManager() {
+    if (internTable_)
+      internTable_->detach();
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    clearObjectIndexes();
+    releaseSpareObjectIndexes();
+#endif
     stringPool_.clear(allocator_);
     variantPools_.clear(allocator_);
 #if ARDUINOJSON_USE_8_BYTE_POOL
@@ -37,15 +56,29 @@ class ResourceManager {
     swap(a.variantPools_, b.variantPools_);
 #if ARDUINOJSON_USE_8_BYTE_POOL
     swap(a.eightBytePools_, b.eightBytePools_);
+#endif
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    swap_(a.objectIndexes_, b.objectIndexes_);
+    swap_(a.spareObjectIndexes_, b.spareObjectIndexes_);
+#endif
+#if ARDUINOJSON_COLLECTION_CACHE_SIZE
+    swap_(a.collectionCache_, b.collectionCache_);
 #endif
     swap_(a.allocator_, b.allocator_);
+    swap_(a.internTable_, b.internTable_);
     swap_(a.overflowed_, b.overflowed_);
+    swap_(a.frozen_, b.frozen_);
+    swap_(a.recycling_, b.recycling_);
   }
 
   Allocator* allocator() const {
     return allocator_;
   }
 
+  StringInternTable* internTable() const {
+    return internTable_;
+  }
+
   size_t size() const {
     return variantPools_.size() + stringPool_.size();
   }
@@ -54,6 +87,45 @@ class ResourceManager {
     return overflowed_;
   }
 
+  // A frozen document is never modified: the children of each collection have
+  // consecutive ids, the members of each object are sorted by key, and the
+  // readers don't update the caches.
+  bool frozen() const {
+    return frozen_;
+  }
+
+  void freeze() {
+    frozen_ = true;
+  }
+
+  // After recycle() or reserve(), deserializeXxx() keeps the pools, the
+  // strings, and the object indexes for the next content instead of releasing
+  // them, until clear() or shrinkToFit() is called.
+  bool recycling() const {
+    return recycling_;
+  }
+
+  // Empties the document, but keeps its memory for the next content.
+  // The spare memory that the previous content didn't use is released.
+  void recycle() {
+    recycling_ = true;
+    empty(true);
+  }
+
+  // Empties the document and allocates one pool for the variants and one
+  // block for the strings, then recycles them like recycle().
+  // Returns false if one of the allocations failed.
+  bool reserve(size_t variantSlots, size_t stringBytes) {
+    clear();
+    recycling_ = true;
+    bool ok = true;
+    if (variantSlots && !variantPools_.reserve(variantSlots, allocator_))
+      ok = false;
+    if (!stringPool_.reserve(stringBytes, allocator_))
+      ok = false;
+    return ok;
+  }
+
   Slot<VariantData> allocVariant() {
     auto slot = variantPools_.allocSlot(allocator_);
     if (!slot) {
@@ -66,6 +138,7 @@ class ResourceManager {
 
   void freeVariant(Slot<VariantData> slot) {
     ARDUINOJSON_ASSERT(slot->type == VariantType::Null);
+    slot->type = VariantType::Free;  // so iterators can tell it was removed
     variantPools_.freeSlot(slot);
   }
 
@@ -105,8 +178,15 @@ class ResourceManager {
     return node;
   }
 
+  // Returns the node of the key in the shared table, or null if there is no
+  // table or it's full, in which case the caller must store the key
+  template <typename TAdaptedString>
+  StringNode* internKey(const TAdaptedString& str) {
+    return internTable_ ? internTable_->intern(str) : nullptr;
+  }
+
   void saveString(StringNode* node) {
-    stringPool_.add(node);
+    stringPool_.add(node, allocator_);
   }
 
   template <typename TAdaptedString>
@@ -115,13 +195,33 @@ class ResourceManager {
   }
 
   StringNode* createString(size_t length) {
-    auto node = StringNode::create(length, allocator_);
+    auto node = stringPool_.takeSpare(length);
+    if (!node)
+      node = stringPool_.takeReserved(length);
+    if (!node)
+      node = StringNode::create(length, allocator_);
     if (!node)
       overflowed_ = true;
     return node;
   }
 
   StringNode* resizeString(StringNode* node, size_t length) {
+    if (stringPool_.isReserved(node)) {
+      if (stringPool_.resizeReserved(node, length))
+        return node;
+      auto copy = createString(length);
+      if (copy)
+        memcpy(copy->data, node->data, node->length);  // it grows
+      stringPool_.releaseReserved(node);
+      return copy;
+    }
+    auto spare = stringPool_.takeSpare(length);
+    if (spare) {
+      memcpy(spare->data, node->data,
+             node->length < length ? node->length : length);
+      stringPool_.addSpare(node);
+      return spare;
+    }
     node = StringNode::resize(node, length, allocator_);
     if (!node)
       overflowed_ = true;
@@ -129,37 +229,319 @@ class ResourceManager {
   }
 
   void destroyString(StringNode* node) {
-    StringNode::destroy(node, allocator_);
+    releaseString(node);
   }
 
-  void dereferenceString(const char* s) {
-    stringPool_.dereference(s, allocator_);
+  void dereferenceString(StringNode* node) {
+    if (internTable_ && internTable_->contains(node))
+      return;  // it belongs to the table
+    if (stringPool_.dereference(node))
+      releaseString(node);
   }
 
-  void clear() {
-    variantPools_.clear(allocator_);
-    overflowed_ = false;
-    stringPool_.clear(allocator_);
-#if ARDUINOJSON_USE_8_BYTE_POOL
-    eightBytePools_.clear(allocator_);
+#if ARDUINOJSON_COLLECTION_CACHE_SIZE
+  CollectionCache::Entry* findCachedCollection(const VariantData* collection) {
+    return collectionCache_.find(collection);
+  }
+
+  CollectionCache::Entry* cacheCollection(const VariantData* collection) {
+    return collectionCache_.get(collection);
+  }
+
+  void uncacheCollection(const VariantData* collection) {
+    collectionCache_.remove(collection);
+  }
+#endif
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  // Returns the index of the object, or null if it doesn't have one
+  ObjectIndex* getObjectIndex(const VariantData* object) {
+    ObjectIndex* prev = nullptr;
+    for (auto index = objectIndexes_; index; index = index->next) {
+      if (index->object == object) {
+        if (prev) {  // move to front, so that the LRU index is at the back
+          prev->next = index->next;
+          index->next = objectIndexes_;
+          objectIndexes_ = index;
+        }
+        return index;
+      }
+      prev = index;
+    }
+    return nullptr;
+  }
+
+  // Doesn't set the overflowed flag because the index is optional
+  ObjectIndex* createObjectIndex(const VariantData* object, size_t capacity) {
+    ARDUINOJSON_ASSERT(getObjectIndex(object) == nullptr);
+    auto index = takeSpareObjectIndex(object, capacity);
+    if (!index)
+      index = ObjectIndex::create(object, capacity, allocator_);
+    if (!index)
+      return nullptr;
+    index->next = objectIndexes_;
+    objectIndexes_ = index;
+
+    // destroy the least recently used index if there are too many
+    auto last = objectIndexes_;
+    for (size_t n = 1; n < ARDUINOJSON_MAX_OBJECT_INDEXES && last->next; n++)
+      last = last->next;
+    if (last->next) {
+      releaseObjectIndex(last->next);
+      last->next = nullptr;
+    }
+
+    return index;
+  }
+
+  void destroyObjectIndex(const VariantData* object) {
+    ObjectIndex* prev = nullptr;
+    for (auto index = objectIndexes_; index; index = index->next) {
+      if (index->object == object) {
+        if (prev)
+          prev->next = index->next;
+        else
+          objectIndexes_ = index->next;
+        releaseObjectIndex(index);
+        return;
+      }
+      prev = index;
+    }
+  }
 #endif
+
+  // Empties the document and releases its memory, including the memory kept
+  // by recycle()
+  void clear() {
+    recycling_ = false;
+    empty(false);
   }
 
+  // Also releases the memory kept by recycle() and stops recycling
   void shrinkToFit() {
+    recycling_ = false;
+    stringPool_.releaseSpares(allocator_);
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    releaseSpareObjectIndexes();
+#endif
+    // the slots might move
+#if ARDUINOJSON_COLLECTION_CACHE_SIZE
+    collectionCache_.clear();
+#endif
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    clearObjectIndexes();  // (they are cheap to rebuild)
+#endif
     variantPools_.shrinkToFit(allocator_);
 #if ARDUINOJSON_USE_8_BYTE_POOL
     eightBytePools_.shrinkToFit(allocator_);
 #endif
   }
 
+  // Moves the slots reachable from root to the beginning of the pools, in
+  // depth-first order, then releases the free slots and the emptied pools.
+  // Needs a temporary table of one SlotId per allocated slot; returns false,
+  // without changing anything, if it can't be allocated.
+  bool compact(VariantData* root) {
+    size_t variantCount = variantPools_.idCount();
+    size_t tableSize = variantCount;
+#if ARDUINOJSON_USE_8_BYTE_POOL
+    size_t eightByteCount = eightBytePools_.idCount();
+    tableSize += eightByteCount;
+#endif
+    if (!tableSize)
+      return true;
+
+    auto table =
+        static_cast<SlotId*>(allocator_->allocate(tableSize * sizeof(SlotId)));
+    if (!table)
+      return false;
+    for (size_t i = 0; i < tableSize; i++)
+      table[i] = NULL_SLOT;
+
+    SlotCompaction compaction;
+    compaction.newVariantIds = table;
+#if ARDUINOJSON_USE_8_BYTE_POOL
+    compaction.newEightByteIds = table + variantCount;
+#endif
+    numberSlots(root, compaction);
+
+    // rewrite the ids while the slots are still at their old place
+    updateIds(root, compaction);
+    for (size_t i = 0; i < variantCount; i++)
+      if (table[i] != NULL_SLOT)
+        updateIds(getVariant(SlotId(i)), compaction);
+
+    moveSlots(variantPools_, compaction.newVariantIds, variantCount);
+    variantPools_.truncate(compaction.variantEnd, allocator_);
+#if ARDUINOJSON_USE_8_BYTE_POOL
+    moveSlots(eightBytePools_, compaction.newEightByteIds, eightByteCount);
+    eightBytePools_.truncate(compaction.eightByteEnd, allocator_);
+#endif
+
+    allocator_->deallocate(table);
+    shrinkToFit();
+    return true;
+  }
+
  private:
+  struct SlotCompaction {
+    SlotId* newVariantIds;
+    size_t variantEnd = 0;
+#if ARDUINOJSON_USE_8_BYTE_POOL
+    SlotId* newEightByteIds;
+    size_t eightByteEnd = 0;
+#endif
+  };
+
+  // Gives the next free ids to the slots of the variant, recursively
+  void numberSlots(VariantData* variant, SlotCompaction& compaction) {
+#if ARDUINOJSON_USE_8_BYTE_POOL
+    if (variant->type & VariantTypeBits::EightByteBit) {
+      auto id =
+          eightBytePools_.firstAllocatedId(SlotId(compaction.eightByteEnd));
+      compaction.newEightByteIds[variant->content.asSlotId] = id;
+      compaction.eightByteEnd = size_t(id) + 1;
+    }
+#endif
+    if (!variant->isCollection())
+      return;
+    for (SlotId id = variant->content.asCollection.head; id != NULL_SLOT;) {
+      auto child = getVariant(id);
+      auto newId =
+          variantPools_.firstAllocatedId(SlotId(compaction.variantEnd));
+      compaction.newVariantIds[id] = newId;
+      compaction.variantEnd = size_t(newId) + 1;
+      numberSlots(child, compaction);
+      id = child->next;
+    }
+  }
+
+  static void updateIds(VariantData* variant,
+                        const SlotCompaction& compaction) {
+    if (variant->next != NULL_SLOT)
+      variant->next = compaction.newVariantIds[variant->next];
+#if ARDUINOJSON_USE_8_BYTE_POOL
+    if (variant->type & VariantTypeBits::EightByteBit)
+      variant->content.asSlotId =
+          compaction.newEightByteIds[variant->content.asSlotId];
+#endif
+    if (variant->isCollection()) {
+      auto& coll = variant->content.asCollection;
+      if (coll.head != NULL_SLOT) {
+        coll.head = compaction.newVariantIds[coll.head];
+        coll.tail = compaction.newVariantIds[coll.tail];
+      }
+    }
+  }
+
+  // Puts each slot at its new id by following the cycles of the permutation.
+  // The free slots don't have a new id and end up after the others.
+  template <typename T>
+  static void moveSlots(MemoryPoolList<T>& pools, SlotId* newIds,
+                        size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      while (newIds[i] != NULL_SLOT && newIds[i] != i) {
+        auto j = newIds[i];
+        pools.swapSlots(SlotId(i), j);
+        swap_(newIds[i], newIds[j]);
+      }
+    }
+  }
+
+  void releaseString(StringNode* node) {
+    if (stringPool_.isReserved(node))
+      stringPool_.releaseReserved(node);
+    else if (recycling_)
+      stringPool_.addSpare(node);
+    else
+      StringNode::destroy(node, allocator_);
+  }
+
+  void empty(bool keepMemory) {
+#if ARDUINOJSON_COLLECTION_CACHE_SIZE
+    collectionCache_.clear();
+#endif
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    releaseSpareObjectIndexes();
+    clearObjectIndexes();  // they become spares if recycling_
+#endif
+    overflowed_ = false;
+    if (keepMemory) {
+      variantPools_.recycle();
+      stringPool_.recycle(allocator_);
+#if ARDUINOJSON_USE_8_BYTE_POOL
+      eightBytePools_.recycle();
+#endif
+      return;
+    }
+    variantPools_.clear(allocator_);
+    stringPool_.clear(allocator_);
+#if ARDUINOJSON_USE_8_BYTE_POOL
+    eightBytePools_.clear(allocator_);
+#endif
+  }
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  void clearObjectIndexes() {
+    while (objectIndexes_) {
+      auto index = objectIndexes_;
+      objectIndexes_ = index->next;
+      releaseObjectIndex(index);
+    }
+  }
+
+  void releaseObjectIndex(ObjectIndex* index) {
+    if (recycling_) {
+      index->next = spareObjectIndexes_;
+      spareObjectIndexes_ = index;
+    } else {
+      ObjectIndex::destroy(index, allocator_);
+    }
+  }
+
+  ObjectIndex* takeSpareObjectIndex(const VariantData* object,
+                                    size_t capacity) {
+    ObjectIndex* prev = nullptr;
+    for (auto index = spareObjectIndexes_; index; index = index->next) {
+      if (index->capacity == capacity) {
+        if (prev)
+          prev->next = index->next;
+        else
+          spareObjectIndexes_ = index->next;
+        index->reset(object);
+        return index;
+      }
+      prev = index;
+    }
+    return nullptr;
+  }
+
+  void releaseSpareObjectIndexes() {
+    while (spareObjectIndexes_) {
+      auto index = spareObjectIndexes_;
+      spareObjectIndexes_ = index->next;
+      ObjectIndex::destroy(index, allocator_);
+    }
+  }
+#endif
+
   Allocator* allocator_;
+  StringInternTable* internTable_;
   bool overflowed_;
+  bool frozen_;
+  bool recycling_;
   StringPool stringPool_;
   MemoryPoolList<VariantData> variantPools_;
 #if ARDUINOJSON_USE_8_BYTE_POOL
   MemoryPoolList<EightByteValue> eightBytePools_;
 #endif
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  ObjectIndex* objectIndexes_ = nullptr;  // most recently used first
+  ObjectIndex* spareObjectIndexes_ = nullptr;
+#endif
+#if ARDUINOJSON_COLLECTION_CACHE_SIZE
+  CollectionCache collectionCache_;
+#endif
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,126 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Alignment.hpp>
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/StringNode.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/utility.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A single allocation that holds the strings reserved with
+// JsonDocument::reserve(). The nodes are cut one after the other; the last
+// one can grow or shrink in place, and reset() releases them all at once.
+class StringBlock {
+ public:
+  StringBlock() = default;
+  StringBlock(const StringBlock&) = delete;
+  StringBlock& operator=(const StringBlock&) = delete;
+
+  ~StringBlock() {
+    ARDUINOJSON_ASSERT(buffer_ == nullptr);
+  }
+
+  friend void swap(StringBlock& a, StringBlock& b) {
+    swap_(a.buffer_, b.buffer_);
+    swap_(a.capacity_, b.capacity_);
+    swap_(a.used_, b.used_);
+  }
+
+  // Returns the room that a string of n characters takes in the block
+  static size_t sizeForLength(size_t n) {
+    return addPadding(StringNode::sizeForLength(n));
+  }
+
+  // Replaces the block with one of the given size (in bytes).
+  // The block must not contain any string.
+  bool allocate(size_t capacity, Allocator* allocator) {
+    ARDUINOJSON_ASSERT(used_ == 0);
+    release(allocator);
+    if (!capacity)
+      return true;
+    buffer_ = static_cast<char*>(allocator->allocate(capacity));
+    if (!buffer_)
+      return false;
+    capacity_ = capacity;
+    return true;
+  }
+
+  void release(Allocator* allocator) {
+    if (buffer_)
+      allocator->deallocate(buffer_);
+    buffer_ = nullptr;
+    capacity_ = 0;
+    used_ = 0;
+  }
+
+  // Forgets all the strings, but keeps the memory
+  void reset() {
+    used_ = 0;
+  }
+
+  bool contains(const StringNode* node) const {
+    auto p = reinterpret_cast<const char*>(node);
+    return buffer_ && p >= buffer_ && p < buffer_ + capacity_;
+  }
+
+  // Returns a node cut from the free part of the block, or null if it's too
+  // small
+  StringNode* create(size_t length) {
+    if (length > StringNode::maxLength)
+      return nullptr;
+    size_t size = sizeForLength(length);
+    if (size > capacity_ - used_)
+      return nullptr;
+    auto node = reinterpret_cast<StringNode*>(buffer_ + used_);
+    used_ += size;
+    node->length = StringNode::length_type(length);
+    node->references = 1;
+    return node;
+  }
+
+  // Changes the length of a node of the block, if possible without moving it
+  bool resize(StringNode* node, size_t length) {
+    ARDUINOJSON_ASSERT(contains(node));
+    if (length > StringNode::maxLength)
+      return false;
+    if (isLast(node)) {
+      size_t offset = size_t(reinterpret_cast<char*>(node) - buffer_);
+      size_t size = sizeForLength(length);
+      if (size > capacity_ - offset)
+        return false;
+      used_ = offset + size;
+    } else if (length > node->length) {
+      return false;
+    }
+    node->length = StringNode::length_type(length);
+    return true;
+  }
+
+  // Gives back the memory of the node if it's the last one
+  void destroy(StringNode* node) {
+    ARDUINOJSON_ASSERT(contains(node));
+    if (isLast(node))
+      used_ = size_t(reinterpret_cast<char*>(node) - buffer_);
+  }
+
+  size_t capacity() const {
+    return capacity_;
+  }
+
+ private:
+  bool isLast(const StringNode* node) const {
+    return reinterpret_cast<const char*>(node) + sizeForLength(node->length) ==
+           buffer_ + used_;
+  }
+
+  char* buffer_ = nullptr;
+  size_t capacity_ = 0;
+  size_t used_ = 0;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
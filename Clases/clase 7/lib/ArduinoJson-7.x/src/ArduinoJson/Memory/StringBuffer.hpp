@@ -47,6 +47,20 @@ class StringBuffer {
       data->setLongString(commitStringNode());
   }
 
+  // Same as save(), but uses the shared string table if there is one
+  void saveKey(VariantData* data) {
+    ARDUINOJSON_ASSERT(node_ != nullptr);
+    const char* s = node_->data;
+    if (!isTinyString(s, size_)) {
+      auto node = resources_->internKey(adaptString(s, size_));
+      if (node) {
+        data->setLongString(node);
+        return;
+      }
+    }
+    save(data);
+  }
+
   void saveRaw(VariantData* data) {
     data->setRawString(commitStringNode());
   }
@@ -7,6 +7,8 @@
 #include <ArduinoJson/Memory/ResourceManager.hpp>
 #include <ArduinoJson/Strings/JsonString.hpp>
 
+#include <string.h>  // memcpy
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 class StringBuilder {
@@ -39,8 +41,12 @@ class StringBuilder {
     p[size_] = 0;
     StringNode* node = resources_->getString(adaptString(p, size_));
     if (!node) {
-      node = resources_->resizeString(node_, size_);
-      ARDUINOJSON_ASSERT(node != nullptr);  // realloc to smaller can't fail
+      if (node_->length != size_) {
+        node = resources_->resizeString(node_, size_);
+        ARDUINOJSON_ASSERT(node != nullptr);  // realloc to smaller can't fail
+      } else {
+        node = node_;
+      }
       resources_->saveString(node);
       node_ = nullptr;  // next time we need a new string
     } else {
@@ -49,14 +55,38 @@ class StringBuilder {
     variant->setLongString(node);
   }
 
+  // Same as save(), but uses the shared string table if there is one
+  void saveKey(VariantData* variant) {
+    ARDUINOJSON_ASSERT(variant != nullptr);
+    ARDUINOJSON_ASSERT(node_ != nullptr);
+
+    char* p = node_->data;
+    if (!isTinyString(p, size_)) {
+      auto node = resources_->internKey(adaptString(p, size_));
+      if (node) {
+        variant->setLongString(node);
+        return;
+      }
+    }
+    save(variant);
+  }
+
   void append(const char* s) {
     while (*s)
       append(*s++);
   }
 
   void append(const char* s, size_t n) {
-    while (n-- > 0)  // TODO: memcpy
-      append(*s++);
+    if (node_ && size_ + n > node_->length) {
+      size_t capacity = size_ * 2U + 1;
+      if (capacity < size_ + n)
+        capacity = size_ + n;
+      node_ = resources_->resizeString(node_, capacity);
+    }
+    if (node_) {
+      memcpy(node_->data + size_, s, n);
+      size_ += n;
+    }
   }
 
   void append(char c) {
@@ -0,0 +1,110 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/StringPool.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+class ResourceManager;
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// A table of keys shared by several documents, so that the keys they have in
+// common are allocated once instead of once per document.
+// The documents attached to the table (see the constructor of JsonDocument)
+// store their keys in it until it holds maxStrings strings; after that, the
+// new keys are stored in the documents as usual. The keys stay in the table
+// until clear(), even when no document uses them anymore, so that the next
+// documents find them.
+// The table counts the documents attached to it and must outlive them.
+// CAUTION: the table isn't synchronized. Creating, modifying, parsing, or
+// destroying an attached document writes to the table, so all the documents
+// attached to a table must be used from a single thread.
+class StringInternTable {
+ public:
+  explicit StringInternTable(
+      size_t maxStrings = 64,
+      Allocator* allocator = detail::DefaultAllocator::instance())
+      : allocator_(allocator), maxStrings_(maxStrings) {}
+
+  StringInternTable(const StringInternTable&) = delete;
+  StringInternTable& operator=(const StringInternTable&) = delete;
+
+  ~StringInternTable() {
+    ARDUINOJSON_ASSERT(users_ == 0);
+    strings_.clear(allocator_);
+  }
+
+  Allocator* allocator() const {
+    return allocator_;
+  }
+
+  // Returns the number of strings in the table
+  size_t size() const {
+    return size_;
+  }
+
+  // Returns the number of documents attached to the table
+  size_t users() const {
+    return users_;
+  }
+
+  // Releases all the strings.
+  // Does nothing and returns false if a document is still attached.
+  bool clear() {
+    if (users_)
+      return false;
+    strings_.clear(allocator_);
+    size_ = 0;
+    return true;
+  }
+
+ private:
+  friend class detail::ResourceManager;
+
+  void attach() {
+    users_++;
+  }
+
+  void detach() {
+    ARDUINOJSON_ASSERT(users_ > 0);
+    users_--;
+  }
+
+  // Returns the node of the string, adding it if needed, or null if the table
+  // is full or the allocation failed.
+  // The reference count of the nodes isn't used: they belong to the table.
+  template <typename TAdaptedString>
+  detail::StringNode* intern(const TAdaptedString& str) {
+    auto node = strings_.get(str);
+    if (node || size_ >= maxStrings_)
+      return node;
+
+    size_t n = str.size();
+    node = detail::StringNode::create(n, allocator_);
+    if (!node)
+      return nullptr;
+    detail::stringGetChars(str, node->data, n);
+    node->data[n] = 0;
+    strings_.add(node, allocator_);
+    size_++;
+    return node;
+  }
+
+  bool contains(const detail::StringNode* node) const {
+    return strings_.contains(node);
+  }
+
+  detail::StringPool strings_;
+  Allocator* allocator_;
+  size_t maxStrings_;
+  size_t size_ = 0;
+  size_t users_ = 0;
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
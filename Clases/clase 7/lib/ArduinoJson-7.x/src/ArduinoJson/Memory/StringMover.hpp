@@ -0,0 +1,87 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/ResourceManager.hpp>
+#include <ArduinoJson/Strings/JsonString.hpp>
+
+#include <string.h>  // memchr, memmove
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Same interface as StringBuilder, but writes the strings in the input buffer
+// instead of allocating them.
+// This works because the unescaped string is never longer than its JSON
+// representation, so the write pointer always lags behind the read pointer.
+class StringMover {
+ public:
+  StringMover(ResourceManager* resources, char* buffer)
+      : resources_(resources), writePtr_(buffer) {}
+
+  void startString() {
+    // reuses the space of the previous string if it wasn't saved
+    size_ = 0;
+  }
+
+  void save(VariantData* variant) {
+    ARDUINOJSON_ASSERT(variant != nullptr);
+
+    if (isTinyString(writePtr_, size_)) {
+      variant->setTinyString(adaptString(writePtr_, size_));
+      return;
+    }
+
+    if (memchr(writePtr_, 0, size_)) {
+      // a linked string ends at the first NUL, so this one must be copied
+      StringNode* node = resources_->saveString(adaptString(writePtr_, size_));
+      if (node)
+        variant->setLongString(node);
+      return;
+    }
+
+    writePtr_[size_] = 0;
+    variant->setLinkedString(writePtr_);
+    writePtr_ += size_ + 1;
+    size_ = 0;
+  }
+
+  // The keys stay in the input buffer too
+  void saveKey(VariantData* variant) {
+    save(variant);
+  }
+
+  void append(const char* s) {
+    append(s, strlen(s));
+  }
+
+  void append(const char* s, size_t n) {
+    memmove(writePtr_ + size_, s, n);
+    size_ += n;
+  }
+
+  void append(char c) {
+    writePtr_[size_++] = c;
+  }
+
+  bool isValid() const {
+    return true;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  JsonString str() const {
+    writePtr_[size_] = 0;
+    return JsonString(writePtr_, size_);
+  }
+
+ private:
+  ResourceManager* resources_;
+  char* writePtr_;
+  size_t size_ = 0;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -21,8 +21,17 @@ struct StringNode {
 
   using length_type = uint_t<ARDUINOJSON_STRING_LENGTH_SIZE * 8>;
 
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+  // Use the same type as SlotId to store the hash
+  // (there can never be more strings than slots)
+  using hash_type = uint_t<ARDUINOJSON_SLOT_ID_SIZE * 8>;
+#endif
+
   struct StringNode* next;
   references_type references;
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+  hash_type hash;
+#endif
   length_type length;
   char data[1];
 
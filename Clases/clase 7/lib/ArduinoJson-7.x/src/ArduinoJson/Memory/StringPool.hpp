@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Memory/Allocator.hpp>
+#include <ArduinoJson/Memory/StringBlock.hpp>
 #include <ArduinoJson/Memory/StringNode.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/utility.hpp>
@@ -12,6 +13,17 @@
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
+// The strings are stored in a linked list until there are more than
+// ARDUINOJSON_STRING_INDEX_THRESHOLD of them, at which point they are moved to
+// an open-addressing hash table (linear probing) keyed by StringNode::hash.
+// If the allocation of the table fails, the strings remain in the list.
+// recycle() moves the strings to lists of spare nodes, one per length modulo
+// spareBuckets, which add() and takeSpare() reuse when the length matches.
+// Only the first spares of a list are looked at, and recycle() releases the
+// ones that the previous content didn't take when they outnumber the strings,
+// so the lists stay short.
+// The nodes cut from the block allocated by reserve() are never destroyed one
+// by one: the block is reset or released with the pool.
 class StringPool {
  public:
   StringPool() = default;
@@ -20,17 +32,153 @@ class StringPool {
 
   ~StringPool() {
     ARDUINOJSON_ASSERT(strings_ == nullptr);
+#if ARDUINOJSON_DEBUG
+    for (size_t i = 0; i < spareBuckets; i++)
+      ARDUINOJSON_ASSERT(spares_[i] == nullptr);
+#endif
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    ARDUINOJSON_ASSERT(index_ == nullptr);
+#endif
   }
 
   friend void swap(StringPool& a, StringPool& b) {
     swap_(a.strings_, b.strings_);
+    for (size_t i = 0; i < spareBuckets; i++)
+      swap_(a.spares_[i], b.spares_[i]);
+    swap(a.block_, b.block_);
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    swap_(a.listSize_, b.listSize_);
+    swap_(a.index_, b.index_);
+    swap_(a.indexCapacity_, b.indexCapacity_);
+    swap_(a.indexSize_, b.indexSize_);
+#endif
   }
 
   void clear(Allocator* allocator) {
     while (strings_) {
       auto node = strings_;
       strings_ = node->next;
-      StringNode::destroy(node, allocator);
+      destroy(node, allocator);
+    }
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    listSize_ = 0;
+    if (index_) {
+      for (size_t i = 0; i < indexCapacity_; i++)
+        if (index_[i])
+          destroy(index_[i], allocator);
+      allocator->deallocate(index_);
+      index_ = nullptr;
+      indexCapacity_ = 0;
+      indexSize_ = 0;
+    }
+#endif
+    releaseSpares(allocator);
+    block_.release(allocator);
+  }
+
+  // Empties the pool, but keeps the nodes (and the index) for reuse.
+  // Releases the spare nodes that weren't reused since the last call if there
+  // are at least as many as strings (and there are strings: recycling twice
+  // in a row keeps the spares).
+  void recycle(Allocator* allocator) {
+    size_t count = 0;
+    for (auto node = strings_; node; node = node->next)
+      count++;
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    count += indexSize_;
+#endif
+    if (count && spareCount() >= count)
+      releaseSpares(allocator);
+
+    while (strings_) {
+      auto node = strings_;
+      strings_ = node->next;
+      recycle(node);
+    }
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    listSize_ = 0;
+    for (size_t i = 0; i < indexCapacity_; i++) {
+      if (index_[i]) {
+        recycle(index_[i]);
+        index_[i] = nullptr;
+      }
+    }
+    indexSize_ = 0;
+#endif
+    block_.reset();
+  }
+
+  // Allocates a block of the given size (in bytes) for the next strings.
+  // The pool must be empty.
+  bool reserve(size_t size, Allocator* allocator) {
+    ARDUINOJSON_ASSERT(strings_ == nullptr);
+    return block_.allocate(size, allocator);
+  }
+
+  // Returns a node cut from the reserved block, or null if there is no room
+  StringNode* takeReserved(size_t length) {
+    return block_.create(length);
+  }
+
+  bool isReserved(const StringNode* node) const {
+    return block_.contains(node);
+  }
+
+  // Changes the length of a node of the reserved block; returns false if it
+  // can't be done in place
+  bool resizeReserved(StringNode* node, size_t length) {
+    return block_.resize(node, length);
+  }
+
+  // Gives back the memory of the node, if it's the last one of the block
+  void releaseReserved(StringNode* node) {
+    block_.destroy(node);
+  }
+
+  void addSpare(StringNode* node) {
+    auto& spares = spares_[node->length % spareBuckets];
+    node->next = spares;
+    spares = node;
+  }
+
+  // Returns a spare node of exactly this length, or null if there is none
+  // among the first ones of its list.
+  // recycle() keeps the strings in the order they were added, so a document
+  // with the same shape usually finds its nodes at the front.
+  StringNode* takeSpare(size_t length) {
+    auto& spares = spares_[length % spareBuckets];
+    StringNode* prev = nullptr;
+    auto node = spares;
+    for (size_t i = 0; node && i < maxSpareLookups; i++) {
+      if (node->length == length) {
+        if (prev)
+          prev->next = node->next;
+        else
+          spares = node->next;
+        node->references = 1;
+        return node;
+      }
+      prev = node;
+      node = node->next;
+    }
+    return nullptr;
+  }
+
+  size_t spareCount() const {
+    size_t count = 0;
+    for (size_t i = 0; i < spareBuckets; i++)
+      for (auto node = spares_[i]; node; node = node->next)
+        count++;
+    return count;
+  }
+
+  void releaseSpares(Allocator* allocator) {
+    for (size_t i = 0; i < spareBuckets; i++) {
+      while (spares_[i]) {
+        auto node = spares_[i];
+        spares_[i] = node->next;
+        StringNode::destroy(node, allocator);
+      }
     }
   }
 
@@ -38,6 +186,11 @@ class StringPool {
     size_t total = 0;
     for (auto node = strings_; node; node = node->next)
       total += sizeofString(node->length);
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    for (size_t i = 0; i < indexCapacity_; i++)
+      if (index_[i])
+        total += sizeofString(index_[i]->length);
+#endif
     return total;
   }
 
@@ -53,50 +206,214 @@ class StringPool {
 
     size_t n = str.size();
 
-    node = StringNode::create(n, allocator);
+    node = takeSpare(n);
+    if (!node)
+      node = takeReserved(n);
+    if (!node)
+      node = StringNode::create(n, allocator);
     if (!node)
       return nullptr;
 
     stringGetChars(str, node->data, n);
     node->data[n] = 0;  // force NUL terminator
-    add(node);
+    add(node, allocator);
     return node;
   }
 
-  void add(StringNode* node) {
+  // Adds a node whose content is final (the hash is computed here)
+  void add(StringNode* node, Allocator* allocator) {
     ARDUINOJSON_ASSERT(node != nullptr);
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    auto str = adaptString(node->data, node->length);
+    node->hash = StringNode::hash_type(stringHash(str));
+    if (index_ || listSize_ >= ARDUINOJSON_STRING_INDEX_THRESHOLD) {
+      if (reserveIndex(indexSize_ + listSize_ + 1, allocator)) {
+        moveListToIndex();
+        insertInIndex(node);
+        return;
+      }
+    }
+    listSize_++;
+#else
+    (void)allocator;
+#endif
     node->next = strings_;
     strings_ = node;
   }
 
   template <typename TAdaptedString>
   StringNode* get(const TAdaptedString& str) const {
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    auto hash = StringNode::hash_type(stringHash(str));
+    if (index_) {
+      auto mask = indexCapacity_ - 1;
+      for (size_t i = hash & mask; index_[i]; i = (i + 1) & mask) {
+        auto node = index_[i];
+        if (node->hash == hash &&
+            stringEquals(str, adaptString(node->data, node->length)))
+          return node;
+      }
+    }
+#endif
     for (auto node = strings_; node; node = node->next) {
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+      if (node->hash != hash)
+        continue;
+#endif
       if (stringEquals(str, adaptString(node->data, node->length)))
         return node;
     }
     return nullptr;
   }
 
-  void dereference(const char* s, Allocator* allocator) {
+  // Returns true if this node (not only a string with the same content) is in
+  // the pool
+  bool contains(const StringNode* node) const {
+    ARDUINOJSON_ASSERT(node != nullptr);
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    if (index_) {
+      auto mask = indexCapacity_ - 1;
+      for (size_t i = node->hash & mask; index_[i]; i = (i + 1) & mask)
+        if (index_[i] == node)
+          return true;
+    }
+#endif
+    for (auto curr = strings_; curr; curr = curr->next)
+      if (curr == node)
+        return true;
+    return false;
+  }
+
+  // Returns true if the node isn't referenced anymore, in which case it's
+  // been removed from the pool and the caller must release it
+  bool dereference(StringNode* node) {
+    ARDUINOJSON_ASSERT(node != nullptr);
+    ARDUINOJSON_ASSERT(node->references > 0);
+    if (--node->references != 0)
+      return false;
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+    if (removeFromIndex(node))
+      return true;
+#endif
     StringNode* prev = nullptr;
-    for (auto node = strings_; node; node = node->next) {
-      if (node->data == s) {
-        if (--node->references == 0) {
-          if (prev)
-            prev->next = node->next;
-          else
-            strings_ = node->next;
-          StringNode::destroy(node, allocator);
-        }
-        return;
+    for (auto curr = strings_; curr; curr = curr->next) {
+      if (curr == node) {
+        if (prev)
+          prev->next = node->next;
+        else
+          strings_ = node->next;
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+        listSize_--;
+#endif
+        return true;
       }
-      prev = node;
+      prev = curr;
     }
+    return false;
   }
 
  private:
+  static const size_t spareBuckets = 16;
+  static const size_t maxSpareLookups = 32;
+
+  void destroy(StringNode* node, Allocator* allocator) {
+    if (!isReserved(node))
+      StringNode::destroy(node, allocator);
+  }
+
+  void recycle(StringNode* node) {
+    if (!isReserved(node))
+      addSpare(node);
+  }
+
+#if ARDUINOJSON_STRING_INDEX_THRESHOLD
+  // Makes sure the index can hold n strings while staying at most half full
+  bool reserveIndex(size_t n, Allocator* allocator) {
+    if (n * 2 <= indexCapacity_)
+      return true;
+
+    size_t newCapacity = indexCapacity_ ? indexCapacity_ * 2 : 16;
+    while (newCapacity < n * 2)
+      newCapacity *= 2;
+
+    auto newIndex = reinterpret_cast<StringNode**>(
+        allocator->allocate(newCapacity * sizeof(StringNode*)));
+    if (!newIndex)
+      return false;
+    for (size_t i = 0; i < newCapacity; i++)
+      newIndex[i] = nullptr;
+
+    auto oldIndex = index_;
+    auto oldCapacity = indexCapacity_;
+    index_ = newIndex;
+    indexCapacity_ = newCapacity;
+    indexSize_ = 0;
+
+    if (oldIndex) {
+      for (size_t i = 0; i < oldCapacity; i++)
+        if (oldIndex[i])
+          insertInIndex(oldIndex[i]);
+      allocator->deallocate(oldIndex);
+    }
+
+    return true;
+  }
+
+  void moveListToIndex() {
+    while (strings_) {
+      auto node = strings_;
+      strings_ = node->next;
+      insertInIndex(node);
+    }
+    listSize_ = 0;
+  }
+
+  void insertInIndex(StringNode* node) {
+    ARDUINOJSON_ASSERT(indexSize_ * 2 < indexCapacity_);
+    auto mask = indexCapacity_ - 1;
+    auto i = node->hash & mask;
+    while (index_[i])
+      i = (i + 1) & mask;
+    index_[i] = node;
+    indexSize_++;
+  }
+
+  bool removeFromIndex(StringNode* node) {
+    if (!index_)
+      return false;
+    auto mask = indexCapacity_ - 1;
+    auto i = node->hash & mask;
+    while (index_[i] != node) {
+      if (!index_[i])
+        return false;
+      i = (i + 1) & mask;
+    }
+
+    // backward-shift deletion: move up the entries that would become
+    // unreachable because of the hole
+    for (auto j = (i + 1) & mask; index_[j]; j = (j + 1) & mask) {
+      auto home = index_[j]->hash & mask;
+      bool homeInRange = i <= j ? (i < home && home <= j)  // no wrap-around
+                                : (i < home || home <= j);
+      if (homeInRange)
+        continue;
+      index_[i] = index_[j];
+      i = j;
+    }
+    index_[i] = nullptr;
+    indexSize_--;
+    return true;
+  }
+
+  size_t listSize_ = 0;
+  StringNode** index_ = nullptr;
+  size_t indexCapacity_ = 0;  // always a power of two
+  size_t indexSize_ = 0;
+#endif
+
   StringNode* strings_ = nullptr;
+  StringNode* spares_[spareBuckets] = {};
+  StringBlock block_;
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
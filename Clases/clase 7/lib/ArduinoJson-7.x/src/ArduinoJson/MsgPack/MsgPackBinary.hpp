@@ -41,7 +41,6 @@ struct Converter<MsgPackBinary> : private detail::VariantAttorney {
     if (!str)
       return false;
 
-    resources->saveString(str);
     auto ptr = reinterpret_cast<uint8_t*>(str->data);
     switch (headerSize) {
       case 2:
@@ -64,6 +63,7 @@ struct Converter<MsgPackBinary> : private detail::VariantAttorney {
         ARDUINOJSON_ASSERT(false);
     }
     memcpy(ptr + headerSize, src.data(), src.size());
+    resources->saveString(str);
     data->setRawString(str);
     return true;
   }
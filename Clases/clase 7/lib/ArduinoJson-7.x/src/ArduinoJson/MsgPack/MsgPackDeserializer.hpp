@@ -23,11 +23,12 @@ class MsgPackDeserializer {
         stringBuffer_(resources),
         foundSomething_(false) {}
 
+  // The members are always appended, so AssumeUniqueKeys makes no difference
   template <typename TFilter>
-  DeserializationError parse(VariantData* variant, TFilter filter,
-                             DeserializationOption::NestingLimit nestingLimit) {
+  DeserializationError parse(VariantData* variant,
+                             const DeserializationOptions<TFilter>& options) {
     DeserializationError::Code err;
-    err = parseVariant(variant, filter, nestingLimit);
+    err = parseVariant(variant, options.filter, options.nestingLimit);
     return foundSomething_ ? err : DeserializationError::EmptyInput;
   }
 
@@ -403,7 +404,7 @@ class MsgPackDeserializer {
         if (!keyVariant)
           return DeserializationError::NoMemory;
 
-        stringBuffer_.save(keyVariant);
+        stringBuffer_.saveKey(keyVariant);
       }
 
       err = parseVariant(member, memberFilter, nestingLimit.decrement());
@@ -72,13 +72,13 @@ struct Converter<MsgPackExtension> : private detail::VariantAttorney {
     if (!str)
       return false;
 
-    resources->saveString(str);
     auto ptr = reinterpret_cast<uint8_t*>(str->data);
     *ptr++ = uint8_t(format);
     for (uint8_t i = 0; i < sizeBytes; i++)
       *ptr++ = uint8_t(src.size() >> (sizeBytes - i - 1) * 8 & 0xff);
     *ptr++ = uint8_t(src.type());
     memcpy(ptr, src.data(), src.size());
+    resources->saveString(str);
     data->setRawString(str);
     return true;
   }
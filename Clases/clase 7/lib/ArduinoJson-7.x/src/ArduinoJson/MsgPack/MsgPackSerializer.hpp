@@ -51,16 +51,7 @@ class MsgPackSerializer : public VariantDataVisitor<size_t> {
     ARDUINOJSON_ASSERT(array != nullptr);
     ARDUINOJSON_ASSERT(array->isArray());
 
-    auto n = VariantImpl::size(array, resources_);
-    if (n < 0x10) {
-      writeByte(uint8_t(0x90 + n));
-    } else if (n < 0x10000) {
-      writeByte(0xDC);
-      writeInteger(uint16_t(n));
-    } else {
-      writeByte(0xDD);
-      writeInteger(uint32_t(n));
-    }
+    writeArrayHeader(VariantImpl::size(array, resources_));
 
     auto slotId = array->content.asCollection.head;
     while (slotId != NULL_SLOT) {
@@ -76,16 +67,7 @@ class MsgPackSerializer : public VariantDataVisitor<size_t> {
     ARDUINOJSON_ASSERT(object != nullptr);
     ARDUINOJSON_ASSERT(object->isObject());
 
-    auto n = VariantImpl::size(object, resources_);
-    if (n < 0x10) {
-      writeByte(uint8_t(0x80 + n));
-    } else if (n < 0x10000) {
-      writeByte(0xDE);
-      writeInteger(uint16_t(n));
-    } else {
-      writeByte(0xDF);
-      writeInteger(uint32_t(n));
-    }
+    writeObjectHeader(VariantImpl::size(object, resources_));
 
     auto slotId = object->content.asCollection.head;
     while (slotId != NULL_SLOT) {
@@ -105,19 +87,7 @@ class MsgPackSerializer : public VariantDataVisitor<size_t> {
     ARDUINOJSON_ASSERT(!value.isNull());
 
     auto n = value.size();
-
-    if (n < 0x20) {
-      writeByte(uint8_t(0xA0 + n));
-    } else if (n < 0x100) {
-      writeByte(0xD9);
-      writeInteger(uint8_t(n));
-    } else if (n < 0x10000) {
-      writeByte(0xDA);
-      writeInteger(uint16_t(n));
-    } else {
-      writeByte(0xDB);
-      writeInteger(uint32_t(n));
-    }
+    writeStringHeader(n);
     writeBytes(reinterpret_cast<const uint8_t*>(value.c_str()), n);
     return bytesWritten();
   }
@@ -195,11 +165,53 @@ class MsgPackSerializer : public VariantDataVisitor<size_t> {
     return bytesWritten();
   }
 
- private:
+  // The headers that precede the elements, the members, or the characters;
+  // also used by MsgPackWriter, which doesn't have a VariantData
+
+  void writeArrayHeader(size_t n) {
+    if (n < 0x10) {
+      writeByte(uint8_t(0x90 + n));
+    } else if (n < 0x10000) {
+      writeByte(0xDC);
+      writeInteger(uint16_t(n));
+    } else {
+      writeByte(0xDD);
+      writeInteger(uint32_t(n));
+    }
+  }
+
+  void writeObjectHeader(size_t n) {
+    if (n < 0x10) {
+      writeByte(uint8_t(0x80 + n));
+    } else if (n < 0x10000) {
+      writeByte(0xDE);
+      writeInteger(uint16_t(n));
+    } else {
+      writeByte(0xDF);
+      writeInteger(uint32_t(n));
+    }
+  }
+
+  void writeStringHeader(size_t n) {
+    if (n < 0x20) {
+      writeByte(uint8_t(0xA0 + n));
+    } else if (n < 0x100) {
+      writeByte(0xD9);
+      writeInteger(uint8_t(n));
+    } else if (n < 0x10000) {
+      writeByte(0xDA);
+      writeInteger(uint16_t(n));
+    } else {
+      writeByte(0xDB);
+      writeInteger(uint32_t(n));
+    }
+  }
+
   size_t bytesWritten() const {
     return writer_.count();
   }
 
+ private:
   void writeByte(uint8_t c) {
     writer_.write(c);
   }
@@ -0,0 +1,121 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/MsgPack/MsgPackSerializer.hpp>
+#include <ArduinoJson/Serialization/StreamingWriter.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Writes the tokens of MsgPackWriter with the functions of MsgPackSerializer
+template <typename TWriter>
+class MsgPackTokenWriter {
+ public:
+  explicit MsgPackTokenWriter(TWriter writer)
+      : writer_(writer), serializer_(writer, nullptr) {}
+
+  MsgPackTokenWriter& operator=(const MsgPackTokenWriter&) = delete;
+
+  // Returns the number of bytes sent to the TWriter implementation
+  size_t bytesWritten() const {
+    return serializer_.bytesWritten() + variantBytes_;
+  }
+
+  void beginCollection(bool isObject, size_t size) {
+    if (isObject)
+      serializer_.writeObjectHeader(size);
+    else
+      serializer_.writeArrayHeader(size);
+  }
+
+  // MessagePack collections have no end marker
+  void endArray() {}
+  void endObject() {}
+
+  template <typename TAdaptedString>
+  void writeKey(const TAdaptedString& s) {
+    writeString(s);
+  }
+
+  void writeString(RamString s) {
+    serializer_.writeStringHeader(s.size());
+    serializer_.visit(RawString(s.data(), s.size()));
+  }
+
+  // Strings that can't be read with a pointer, like Flash strings
+  template <typename TAdaptedString>
+  void writeString(const TAdaptedString& s) {
+    serializer_.writeStringHeader(s.size());
+    for (size_t i = 0; i < s.size(); i++) {
+      char c = s[i];
+      serializer_.visit(RawString(&c, 1));
+    }
+  }
+
+  template <typename T>
+  enable_if_t<is_signed<T>::value> writeInteger(T value) {
+    serializer_.visit(JsonInteger(value));
+  }
+
+  template <typename T>
+  enable_if_t<is_unsigned<T>::value> writeInteger(T value) {
+    serializer_.visit(JsonUInt(value));
+  }
+
+  template <typename T>
+  void writeFloat(T value) {
+    serializer_.visit(value);
+  }
+
+  void writeBoolean(bool value) {
+    serializer_.visit(value);
+  }
+
+  void writeNull() {
+    serializer_.visit(nullptr);
+  }
+
+  void writeVariant(JsonVariantConst variant) {
+    variantBytes_ += doSerialize<MsgPackSerializer, TWriter>(variant, writer_);
+  }
+
+ private:
+  TWriter writer_;  // for writeVariant(); the serializer has its own copy
+  MsgPackSerializer<TWriter> serializer_;
+  size_t variantBytes_ = 0;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
+ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
+
+// Writes a MessagePack document one token at a time, without a JsonDocument.
+// TDestination is the same as for serializeMsgPack().
+// Unlike JsonWriter, the arrays and objects need their size up front because
+// MessagePack stores it in the header.
+// When ARDUINOJSON_DEBUG is set, a wrong sequence of calls, or a wrong number
+// of elements, triggers an assertion.
+template <typename TDestination>
+class MsgPackWriter
+    : public detail::StreamingWriter<detail::MsgPackTokenWriter, TDestination> {
+  using base_type =
+      detail::StreamingWriter<detail::MsgPackTokenWriter, TDestination>;
+
+ public:
+  explicit MsgPackWriter(TDestination& destination) : base_type(destination) {}
+
+  // Writes the header of an array of n elements, which must follow
+  void beginArray(size_t n) {
+    this->beginCollection(false, n);
+  }
+
+  // Writes the header of an object of n members, which must follow as key()
+  // and value() pairs
+  void beginObject(size_t n) {
+    this->beginCollection(true, n);
+  }
+};
+
+ARDUINOJSON_END_PUBLIC_NAMESPACE
@@ -0,0 +1,95 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+
+#include <stddef.h>  // size_t
+#include <stdint.h>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A non-negative integer of up to 32 * N bits, for the rare cases where
+// decimalToFloat() must compare a number with a halfway point exactly.
+template <size_t N>
+class BigInteger {
+ public:
+  explicit BigInteger(uint64_t value = 0) : size_(0) {
+    while (value) {
+      limbs_[size_++] = uint32_t(value);
+      value >>= 32;
+    }
+  }
+
+  // this = this * factor + addend
+  void multiplyAdd(uint32_t factor, uint32_t addend) {
+    uint64_t carry = addend;
+    for (size_t i = 0; i < size_; i++) {
+      carry += uint64_t(limbs_[i]) * factor;
+      limbs_[i] = uint32_t(carry);
+      carry >>= 32;
+    }
+    if (carry)
+      push(uint32_t(carry));
+  }
+
+  void multiplyByPowerOfFive(uint32_t exponent) {
+    const uint32_t fiveToThe13 = 1220703125;
+    for (; exponent >= 13; exponent -= 13)
+      multiplyAdd(fiveToThe13, 0);
+    uint32_t factor = 1;
+    for (; exponent > 0; exponent--)
+      factor *= 5;
+    multiplyAdd(factor, 0);
+  }
+
+  void shiftLeft(uint32_t n) {
+    if (!size_)
+      return;
+    size_t limbShift = n / 32;
+    uint32_t bitShift = n % 32;
+    if (bitShift) {
+      uint32_t carry = 0;
+      for (size_t i = 0; i < size_; i++) {
+        uint32_t limb = limbs_[i];
+        limbs_[i] = (limb << bitShift) | carry;
+        carry = limb >> (32 - bitShift);
+      }
+      if (carry)
+        push(carry);
+    }
+    if (limbShift) {
+      ARDUINOJSON_ASSERT(size_ + limbShift <= N);
+      for (size_t i = size_; i-- > 0;)
+        limbs_[i + limbShift] = limbs_[i];
+      for (size_t i = 0; i < limbShift; i++)
+        limbs_[i] = 0;
+      size_ += limbShift;
+    }
+  }
+
+  // Returns a negative value if a < b, 0 if a == b, a positive value if a > b
+  friend int compare(const BigInteger& a, const BigInteger& b) {
+    if (a.size_ != b.size_)
+      return a.size_ < b.size_ ? -1 : 1;
+    for (size_t i = a.size_; i-- > 0;) {
+      if (a.limbs_[i] != b.limbs_[i])
+        return a.limbs_[i] < b.limbs_[i] ? -1 : 1;
+    }
+    return 0;
+  }
+
+ private:
+  void push(uint32_t limb) {
+    ARDUINOJSON_ASSERT(size_ < N);
+    limbs_[size_++] = limb;
+  }
+
+  uint32_t limbs_[N];
+  size_t size_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,121 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Numbers/FloatTraits.hpp>
+#include <ArduinoJson/Numbers/powersOfTen.hpp>
+#include <ArduinoJson/Polyfills/alias_cast.hpp>
+#include <ArduinoJson/Polyfills/bits.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// A number written as significand * 10^exponent
+struct DecimalFloat {
+  uint64_t significand;
+  int16_t exponent;
+};
+
+// floor(log10(2^e)), for |e| <= 1700
+inline int32_t floorLog10Pow2(int32_t e) {
+  return (e * 1262611) >> 22;
+}
+
+// floor(log10(3/4 * 2^e)), for |e| <= 1700
+inline int32_t floorLog10ThreeQuartersPow2(int32_t e) {
+  return (e * 1262611 - 524031) >> 22;
+}
+
+// Returns the high 64 bits of g * cp / 2^64, with the lowest bit set if the
+// result is inexact
+inline uint64_t roundToOdd(uint64_t gHigh, uint64_t gLow, uint64_t cp) {
+  uint64_t xHigh, yHigh;
+  multiply128(gLow, cp, xHigh);
+  uint64_t yLow = multiply128(gHigh, cp, yHigh);
+  uint64_t z = yLow + xHigh;
+  uint64_t result = yHigh + (z < yLow);
+  return result | (z > 1);
+}
+
+// Returns the shortest decimal that rounds to c * 2^q, and the closest one if
+// several have the same length.
+// This is the Schubfach algorithm from "The Schubfach way to render doubles"
+// by Raffaello Giulietti.
+inline DecimalFloat toShortestDecimal(uint64_t c, int32_t q,
+                                      bool lowerBoundaryIsCloser) {
+  // the bounds of the rounding interval, in units of 2^(q-2)
+  uint64_t cbl = 4 * c - 2 + lowerBoundaryIsCloser;
+  uint64_t cb = 4 * c;
+  uint64_t cbr = 4 * c + 2;
+
+  int32_t k = lowerBoundaryIsCloser ? floorLog10ThreeQuartersPow2(q)
+                                    : floorLog10Pow2(q);
+  int h = int(q + floorLog2Pow10(-k) + 1);  // between 1 and 4
+
+  uint64_t gHigh, gLow;
+  getPowerOfTen(-k, gHigh, gLow);
+
+  // the same values, scaled by 10^-k
+  uint64_t vbl = roundToOdd(gHigh, gLow, cbl << h);
+  uint64_t vb = roundToOdd(gHigh, gLow, cb << h);
+  uint64_t vbr = roundToOdd(gHigh, gLow, cbr << h);
+
+  // the bounds are included when c is even (round half to even)
+  bool isEven = (c & 1) == 0;
+  uint64_t lower = vbl + !isEven;
+  uint64_t upper = vbr - !isEven;
+
+  // try with one digit less
+  uint64_t s = vb / 4;
+  if (s >= 10) {
+    uint64_t sp = s / 10;
+    bool upInside = lower <= 40 * sp;
+    bool wpInside = 40 * sp + 40 <= upper;
+    if (upInside != wpInside)
+      return {sp + wpInside, int16_t(k + 1)};
+  }
+
+  // s or s + 1, whichever is in the interval
+  bool uInside = lower <= 4 * s;
+  bool wInside = 4 * s + 4 <= upper;
+  if (uInside != wInside)
+    return {s + wInside, int16_t(k)};
+
+  // both are, pick the closest
+  uint64_t mid = 4 * s + 2;
+  bool roundUp = vb > mid || (vb == mid && (s & 1) != 0);
+  return {s + roundUp, int16_t(k)};
+}
+
+// Returns the shortest decimal that rounds to a positive finite value, without
+// trailing zeros
+template <typename TFloat>
+inline DecimalFloat toShortestDecimal(TFloat value) {
+  using traits = FloatTraits<TFloat>;
+  using bits_type = typename traits::mantissa_type;
+  const int mantissaBits = traits::mantissa_bits;
+  const int exponentBias = (1 << (sizeof(TFloat) * 8 - mantissaBits - 2)) - 1;
+
+  ARDUINOJSON_ASSERT(value > 0);
+  bits_type bits = alias_cast<bits_type>(value);
+  bits_type mantissa = bits & traits::mantissa_max;
+  int32_t biasedExponent = int32_t(bits >> mantissaBits);
+
+  DecimalFloat result;
+  if (biasedExponent == 0)  // subnormal
+    result =
+        toShortestDecimal(mantissa, 1 - exponentBias - mantissaBits, false);
+  else
+    result = toShortestDecimal(mantissa | (bits_type(1) << mantissaBits),
+                               biasedExponent - exponentBias - mantissaBits,
+                               mantissa == 0 && biasedExponent > 1);
+
+  while (result.significand % 10 == 0) {
+    result.significand /= 10;
+    result.exponent++;
+  }
+  return result;
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,230 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Numbers/BigInteger.hpp>
+#include <ArduinoJson/Numbers/FloatTraits.hpp>
+#include <ArduinoJson/Numbers/powersOfTen.hpp>
+#include <ArduinoJson/Polyfills/bits.hpp>
+#include <ArduinoJson/Polyfills/ctype.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// The properties of the binary formats used by decimalToFloat()
+template <typename TFloat, size_t = sizeof(TFloat)>
+struct BinaryFormat {};
+
+template <typename TFloat>
+struct BinaryFormat<TFloat, 8 /*64bits*/> {
+  static const int mantissaBits = 52;
+  static const int exponentBias = 1023;
+  static const int infiniteExponent = 0x7FF;
+  // w * 10^q is zero below this power and infinite above this one
+  static const int32_t minPowerOfTen = -342;
+  static const int32_t maxPowerOfTen = 308;
+  // the powers of ten for which w * 10^q can fall exactly between two values
+  static const int32_t minRoundToEven = -4;
+  static const int32_t maxRoundToEven = 23;
+};
+
+template <typename TFloat>
+struct BinaryFormat<TFloat, 4 /*32bits*/> {
+  static const int mantissaBits = 23;
+  static const int exponentBias = 127;
+  static const int infiniteExponent = 0xFF;
+  static const int32_t minPowerOfTen = -64;
+  static const int32_t maxPowerOfTen = 38;
+  static const int32_t minRoundToEven = -17;
+  static const int32_t maxRoundToEven = 10;
+};
+
+// Returns the bits of the TFloat nearest to w * 10^q, for w > 0.
+// This is the Eisel-Lemire algorithm from "Number Parsing at a Gigabyte per
+// Second" by Daniel Lemire, which is always exact for 64-bit values of w, as
+// shown in "Fast Number Parsing Without Fallback" by Noble Mushtak and Daniel
+// Lemire.
+template <typename TFloat>
+inline uint64_t decimalToFloatBits(uint64_t w, int32_t q) {
+  using format = BinaryFormat<TFloat>;
+  const int mantissaBits = format::mantissaBits;
+
+  ARDUINOJSON_ASSERT(w != 0);
+  if (q < format::minPowerOfTen)
+    return 0;
+  if (q > format::maxPowerOfTen)
+    return uint64_t(format::infiniteExponent) << mantissaBits;
+
+  // getPowerOfTen() rounds all the values up, whereas this algorithm expects
+  // them truncated, except for 10^-27 to 10^-1 which must be rounded up.
+  uint64_t powerHigh, powerLow;
+  getPowerOfTen(q, powerHigh, powerLow);
+  if (q < -27 || q >= 0) {
+    if (powerLow == 0)
+      powerHigh--;
+    powerLow--;
+  }
+
+  int leadingZeros = int(countLeadingZeros(w));
+  w <<= leadingZeros;
+
+  // compute the product with enough precision for the mantissa
+  uint64_t productHigh;
+  uint64_t productLow = multiply128(w, powerHigh, productHigh);
+  const uint64_t precisionMask = ~uint64_t(0) >> (mantissaBits + 3);
+  if ((productHigh & precisionMask) == precisionMask) {
+    uint64_t secondHigh;
+    multiply128(w, powerLow, secondHigh);
+    productLow += secondHigh;
+    if (secondHigh > productLow)
+      productHigh++;
+  }
+
+  int upperBit = int(productHigh >> 63);
+  int shift = upperBit + 64 - mantissaBits - 3;
+  uint64_t mantissa = productHigh >> shift;
+  int32_t exponent = floorLog2Pow10(q) + 63 + upperBit - leadingZeros +
+                     format::exponentBias;
+
+  if (exponent <= 0) {  // subnormal
+    if (-exponent + 1 >= 64)
+      return 0;
+    mantissa >>= -exponent + 1;
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    // rounding may have turned it into the smallest normal number, whose
+    // exponent bits are 1
+    return mantissa;
+  }
+
+  // we normally round up, but if we are exactly in between two values, we
+  // must round to even
+  if (productLow <= 1 && q >= format::minRoundToEven &&
+      q <= format::maxRoundToEven && (mantissa & 3) == 1 &&
+      (mantissa << shift) == productHigh)
+    mantissa &= ~uint64_t(1);
+
+  mantissa += mantissa & 1;
+  mantissa >>= 1;
+  if (mantissa >= (uint64_t(2) << mantissaBits)) {
+    mantissa = uint64_t(1) << mantissaBits;
+    exponent++;
+  }
+  mantissa &= ~(uint64_t(1) << mantissaBits);
+
+  if (exponent >= format::infiniteExponent)
+    return uint64_t(format::infiniteExponent) << mantissaBits;
+
+  return mantissa | (uint64_t(exponent) << mantissaBits);
+}
+
+// Returns the TFloat nearest to w * 10^q, where w contains all the digits.
+template <typename TFloat>
+inline TFloat decimalToFloat(uint64_t w, int32_t q) {
+  using traits = FloatTraits<TFloat>;
+  using bits_type = typename traits::mantissa_type;
+  if (w == 0)
+    return 0;
+  return traits::forge(bits_type(decimalToFloatBits<TFloat>(w, q)));
+}
+
+// Compares the decimal number written in [digits, digitsEnd), which can
+// contain a dot, multiplied by 10^exponent, with the point halfway between
+// the TFloat whose bits are given and the next one.
+// Only the first maxDigits digits are read exactly; the others only count
+// when they are not zero, which is exact for any input shorter than
+// maxDigits, as the deserializers produce.
+template <typename TFloat>
+inline int compareWithHalfway(const char* digits, const char* digitsEnd,
+                              int32_t exponent, uint64_t bits) {
+  using format = BinaryFormat<TFloat>;
+  const int maxDigits = 64;
+
+  // the decimal number, as d * 10^exponent
+  BigInteger<32> d;
+  int count = 0;
+  bool afterDot = false;
+  bool nonZeroDigitsDropped = false;
+  for (const char* p = digits; p != digitsEnd; p++) {
+    if (*p == '.') {
+      afterDot = true;
+      continue;
+    }
+    ARDUINOJSON_ASSERT(isdigit(*p));
+    uint32_t digit = uint32_t(*p - '0');
+    if (count == 0 && digit == 0) {  // leading zero
+      if (afterDot)
+        exponent--;
+    } else if (count < maxDigits) {
+      d.multiplyAdd(10, digit);
+      count++;
+      if (afterDot)
+        exponent--;
+    } else {
+      if (digit)
+        nonZeroDigitsDropped = true;
+      if (!afterDot)
+        exponent++;
+    }
+  }
+  if (nonZeroDigitsDropped) {  // a digit that makes the comparison strict
+    d.multiplyAdd(10, 1);
+    exponent--;
+  }
+
+  // the halfway point, as (2 * m + 1) * 2^(e - 1)
+  const uint64_t mantissaMask = (uint64_t(1) << format::mantissaBits) - 1;
+  uint64_t m = bits & mantissaMask;
+  int32_t e = int32_t(bits >> format::mantissaBits);
+  if (e)
+    m |= uint64_t(1) << format::mantissaBits;
+  else
+    e = 1;
+  e -= format::exponentBias + format::mantissaBits;
+  BigInteger<32> halfway(2 * m + 1);
+
+  // cancel the powers of five and two
+  if (exponent >= 0)
+    d.multiplyByPowerOfFive(uint32_t(exponent));
+  else
+    halfway.multiplyByPowerOfFive(uint32_t(-exponent));
+  if (exponent > e - 1)
+    d.shiftLeft(uint32_t(exponent - (e - 1)));
+  else
+    halfway.shiftLeft(uint32_t(e - 1 - exponent));
+
+  return compare(d, halfway);
+}
+
+// Returns the TFloat nearest to the decimal number written in
+// [digits, digitsEnd), multiplied by 10^exponent.
+// w * 10^q must be the same number, truncated to the digits that fit in w.
+template <typename TFloat>
+inline TFloat decimalToFloat(uint64_t w, int32_t q, const char* digits,
+                             const char* digitsEnd, int32_t exponent) {
+  using traits = FloatTraits<TFloat>;
+  using bits_type = typename traits::mantissa_type;
+
+  // the number is between w * 10^q and (w + 1) * 10^q
+  uint64_t lower = decimalToFloatBits<TFloat>(w, q);
+  uint64_t upper;
+  if (w != ~uint64_t(0))
+    upper = decimalToFloatBits<TFloat>(w + 1, q);
+  else  // w + 1 overflows; use the slightly larger (2^64 / 10 + 1) * 10^(q+1)
+    upper = decimalToFloatBits<TFloat>(~uint64_t(0) / 10 + 1, q + 1);
+
+  // if they are on the same side of a halfway point, the missing digits don't
+  // matter
+  if (lower != upper) {
+    ARDUINOJSON_ASSERT(upper == lower + 1);
+    int comparison =
+        compareWithHalfway<TFloat>(digits, digitsEnd, exponent, lower);
+    if (comparison > 0 || (comparison == 0 && (lower & 1)))
+      lower = upper;
+  }
+
+  return traits::forge(bits_type(lower));
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -12,6 +12,12 @@
 #include <ArduinoJson/Polyfills/math.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 
+#if ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+#  include <ArduinoJson/Numbers/decimalToFloat.hpp>
+#endif
+
+#include <string.h>  // memcpy, strlen
+
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
 
 template <typename A, typename B>
@@ -102,134 +108,234 @@ class Number {
 #endif
 };
 
-inline Number parseNumber(const char* s) {
+#if ARDUINOJSON_ENABLE_SIMD && ARDUINOJSON_LITTLE_ENDIAN
+// Returns true if the 8 bytes of chunk are all ASCII digits
+inline bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+          (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+         0x3333333333333333;
+}
+
+// Returns the value of the 8 digits of chunk, the first one being in the
+// lowest byte
+inline uint32_t parseEightDigits(uint64_t chunk) {
+  const uint64_t mask = 0x000000FF000000FF;
+  const uint64_t mul1 = 100 + (uint64_t(1000000) << 32);
+  const uint64_t mul2 = 1 + (uint64_t(10000) << 32);
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  return uint32_t((((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >>
+                  32);
+}
+#endif
+
+// The first digits of a number, as mantissa * 10^exponent
+template <typename TMantissa>
+struct ParsedDigits {
+  TMantissa mantissa = 0;
+  int32_t exponent = 0;
+  bool full = false;       // mantissa can't take more digits
+  bool truncated = false;  // some of the dropped digits are not zero
+
+  // Consumes the digits at s and returns a pointer to the next character
+  const char* parse(const char* s, const char* end, bool isFraction) {
+    const TMantissa maxMantissa = TMantissa(-1);
+
+#if ARDUINOJSON_ENABLE_SIMD && ARDUINOJSON_LITTLE_ENDIAN
+    // eight digits at a time, as long as they fit
+    while (sizeof(TMantissa) >= 8 && !full && end - s >= 8 &&
+           uint64_t(mantissa) < 100000000000) {
+      uint64_t chunk;
+      memcpy(&chunk, s, 8);
+      if (!isEightDigits(chunk))
+        break;
+      mantissa = TMantissa(uint64_t(mantissa) * 100000000 +
+                           parseEightDigits(chunk));
+      if (isFraction)
+        exponent -= 8;
+      s += 8;
+    }
+#endif
+
+    TMantissa m = mantissa;
+    int32_t e = exponent;
+
+    // the digits that fit in the mantissa
+    for (; !full && s != end && isdigit(*s); s++) {
+      uint8_t digit = uint8_t(*s - '0');
+      if (m >= maxMantissa / 10 &&
+          (m > maxMantissa / 10 || digit > maxMantissa % 10)) {
+        full = true;
+        break;
+      }
+      m = TMantissa(m * 10 + digit);
+      if (isFraction)
+        e--;
+    }
+
+    // the ones that don't
+    if (full) {
+      for (; s != end && isdigit(*s); s++) {
+        if (*s != '0')
+          truncated = true;
+        if (!isFraction)
+          e++;
+      }
+    }
+
+    mantissa = m;
+    exponent = e;
+    return s;
+  }
+};
+
+// Parses the number in [s, end)
+inline Number parseNumber(const char* s, const char* end) {
+#if ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+  using mantissa_t = uint64_t;
+#else
   using traits = FloatTraits<JsonFloat>;
   using mantissa_t = largest_type<traits::mantissa_type, JsonUInt>;
-  using exponent_t = traits::exponent_type;
+#endif
 
   ARDUINOJSON_ASSERT(s != 0);
 
   bool is_negative = false;
-  switch (*s) {
-    case '-':
-      is_negative = true;
-      s++;
-      break;
-    case '+':
-      s++;
-      break;
+  if (s != end) {
+    switch (*s) {
+      case '-':
+        is_negative = true;
+        s++;
+        break;
+      case '+':
+        s++;
+        break;
+    }
   }
 
+  char first = s != end ? *s : '\0';
+
 #if ARDUINOJSON_ENABLE_NAN
-  if (*s == 'n' || *s == 'N') {
-    return Number(traits::nan());
+  if (first == 'n' || first == 'N') {
+    return Number(FloatTraits<JsonFloat>::nan());
   }
 #endif
 
 #if ARDUINOJSON_ENABLE_INFINITY
-  if (*s == 'i' || *s == 'I') {
-    return Number(is_negative ? -traits::inf() : traits::inf());
+  if (first == 'i' || first == 'I') {
+    return Number(is_negative ? -FloatTraits<JsonFloat>::inf()
+                              : FloatTraits<JsonFloat>::inf());
   }
 #endif
 
-  if (!isdigit(*s) && *s != '.')
+  if (!isdigit(first) && first != '.')
     return Number();
 
-  mantissa_t mantissa = 0;
-  exponent_t exponent_offset = 0;
-  const mantissa_t maxUint = JsonUInt(-1);
-
-  while (isdigit(*s)) {
-    uint8_t digit = uint8_t(*s - '0');
-    if (mantissa > maxUint / 10)
-      break;
-    mantissa *= 10;
-    if (mantissa > maxUint - digit)
-      break;
-    mantissa += digit;
-    s++;
-  }
+#if ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+  const char* digits = s;
+#endif
+  ParsedDigits<mantissa_t> parsed;
+  s = parsed.parse(s, end, false);
 
-  if (*s == '\0') {
+  if (s == end && !parsed.full && parsed.mantissa <= JsonUInt(-1)) {
     if (is_negative) {
       const mantissa_t sintMantissaMax = mantissa_t(1)
                                          << (sizeof(JsonInteger) * 8 - 1);
-      if (mantissa <= sintMantissaMax) {
-        return Number(JsonInteger(~mantissa + 1));
+      if (parsed.mantissa <= sintMantissaMax) {
+        return Number(JsonInteger(~parsed.mantissa + 1));
       }
     } else {
-      return Number(JsonUInt(mantissa));
+      return Number(JsonUInt(parsed.mantissa));
     }
   }
 
-  // avoid mantissa overflow
-  while (mantissa > traits::mantissa_max) {
-    mantissa /= 10;
-    exponent_offset++;
-  }
-
-  // remaing digits can't fit in the mantissa
-  while (isdigit(*s)) {
-    exponent_offset++;
-    s++;
-  }
+  if (s != end && *s == '.')
+    s = parsed.parse(s + 1, end, true);
 
-  if (*s == '.') {
-    s++;
-    while (isdigit(*s)) {
-      if (mantissa < traits::mantissa_max / 10) {
-        mantissa = mantissa * 10 + uint8_t(*s - '0');
-        exponent_offset--;
-      }
-      s++;
-    }
-  }
+#if ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+  const char* digitsEnd = s;
+#endif
 
-  int exponent = 0;
-  if (*s == 'e' || *s == 'E') {
+  int32_t exponent = 0;
+  if (s != end && (*s == 'e' || *s == 'E')) {
     s++;
     bool negative_exponent = false;
-    if (*s == '-') {
+    if (s != end && *s == '-') {
       negative_exponent = true;
       s++;
-    } else if (*s == '+') {
+    } else if (s != end && *s == '+') {
       s++;
     }
 
-    while (isdigit(*s)) {
-      exponent = exponent * 10 + (*s - '0');
-      if (exponent + exponent_offset > traits::exponent_max) {
-        if (negative_exponent)
-          return Number(is_negative ? -0.0f : 0.0f);
-        else
-          return Number(is_negative ? -traits::inf() : traits::inf());
-      }
-      s++;
+    for (; s != end && isdigit(*s); s++) {
+      if (exponent < 100000000)  // larger exponents all give 0 or infinity
+        exponent = exponent * 10 + (*s - '0');
     }
     if (negative_exponent)
       exponent = -exponent;
   }
-  exponent += exponent_offset;
 
   // we should be at the end of the string, otherwise it's an error
-  if (*s != '\0')
+  if (s != end)
     return Number();
 
+  if (parsed.mantissa == 0)
+    return Number(is_negative ? -0.0f : 0.0f);
+
+  mantissa_t mantissa = parsed.mantissa;
+  int32_t mantissaExponent = parsed.exponent + exponent;
+
+#if !ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+  // keep the digits that the float type can hold, otherwise make_float() can
+  // round the largest values up to infinity
+  while (mantissa > traits::mantissa_max) {
+    mantissa /= 10;
+    mantissaExponent++;
+  }
+
+  if (mantissaExponent > traits::exponent_max)
+    return Number(is_negative ? -traits::inf() : traits::inf());
+  if (mantissaExponent < -traits::exponent_max - 20)
+    return Number(is_negative ? -0.0f : 0.0f);
+#endif
+
 #if ARDUINOJSON_USE_DOUBLE
-  bool isDouble = exponent < -FloatTraits<float>::exponent_max ||
-                  exponent > FloatTraits<float>::exponent_max ||
+  bool isDouble = parsed.full ||
+                  mantissaExponent < -FloatTraits<float>::exponent_max ||
+                  mantissaExponent > FloatTraits<float>::exponent_max ||
                   mantissa > FloatTraits<float>::mantissa_max;
   if (isDouble) {
-    auto final_result = make_float(double(mantissa), exponent);
+#  if ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+    auto final_result =
+        parsed.truncated
+            ? decimalToFloat<double>(mantissa, mantissaExponent, digits,
+                                     digitsEnd, exponent)
+            : decimalToFloat<double>(mantissa, mantissaExponent);
+#  else
+    auto final_result = make_float(double(mantissa), mantissaExponent);
+#  endif
     return Number(is_negative ? -final_result : final_result);
   } else
 #endif
   {
-    auto final_result = make_float(float(mantissa), exponent);
+#if ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+    auto final_result =
+        parsed.truncated
+            ? decimalToFloat<float>(mantissa, mantissaExponent, digits,
+                                    digitsEnd, exponent)
+            : decimalToFloat<float>(mantissa, mantissaExponent);
+#else
+    auto final_result = make_float(float(mantissa), mantissaExponent);
+#endif
     return Number(is_negative ? -final_result : final_result);
   }
 }
 
+inline Number parseNumber(const char* s) {
+  ARDUINOJSON_ASSERT(s != 0);
+  return parseNumber(s, s + strlen(s));
+}
+
 template <typename T>
 inline T parseNumber(const char* s) {
   return parseNumber(s).convertTo<T>();
@@ -7,6 +7,26 @@
 #include <ArduinoJson/Object/JsonObjectConst.hpp>
 #include <ArduinoJson/Object/MemberProxy.hpp>
 
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Calls the predicate of JsonObject::removeIf() with a JsonPair
+template <typename TPredicate>
+class MemberPredicate {
+ public:
+  MemberPredicate(TPredicate& predicate, ResourceManager* resources)
+      : predicate_(predicate), resources_(resources) {}
+
+  bool operator()(CollectionIterator it) {
+    return predicate_(JsonPair(it, resources_));
+  }
+
+ private:
+  TPredicate& predicate_;
+  ResourceManager* resources_;
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
+
 ARDUINOJSON_BEGIN_PUBLIC_NAMESPACE
 
 class JsonArray;
@@ -131,6 +151,15 @@ class JsonObject : public detail::VariantOperators<JsonObject> {
     impl_.removeMember(it.iterator_);
   }
 
+  // Removes the members for which predicate(JsonPair) returns true, in a
+  // single pass. The predicate must not modify the object.
+  // Returns the number of members removed.
+  template <typename TPredicate>
+  size_t removeIf(TPredicate predicate) const {
+    detail::MemberPredicate<TPredicate> pred(predicate, impl_.resources());
+    return impl_.removeIf(pred);
+  }
+
   // Removes the member with the specified key.
   // https://arduinojson.org/v7/api/jsonobject/remove/
   template <typename TString,
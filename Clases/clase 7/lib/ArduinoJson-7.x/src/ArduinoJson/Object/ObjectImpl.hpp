@@ -43,16 +43,173 @@ inline VariantImpl::iterator VariantImpl::findKey(TAdaptedString key,
 
   if (key.isNull())
     return iterator();
+
+  if (resources->frozen())
+    return findFrozenKey(key, data, resources);
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  auto index = getObjectIndex(data, resources);
+  if (index)
+    return findKeyInIndex(key, index, resources);
+  size_t keyCount = 0;
+#endif
+
   bool isKey = true;
   for (auto it = createIterator(data, resources); !it.done();
        it.move(resources)) {
-    if (isKey && stringEquals(key, adaptString(it->asString())))
-      return it;
+    if (isKey) {
+      if (stringEquals(key, adaptString(it->asString())))
+        return it;
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+      if (++keyCount > ARDUINOJSON_OBJECT_INDEX_THRESHOLD) {
+        index = buildObjectIndex(data, resources);
+        if (index)
+          return findKeyInIndex(key, index, resources);
+        keyCount = 0;  // out of memory, keep scanning
+      }
+#endif
+    }
     isKey = !isKey;
   }
   return iterator();
 }
 
+// The members of a frozen object have consecutive ids and are sorted by key,
+// so the first one with the key is found with a binary search
+template <typename TAdaptedString>
+inline VariantImpl::iterator VariantImpl::findFrozenKey(
+    TAdaptedString key, VariantData* data, ResourceManager* resources) {
+  auto head = data->content.asCollection.head;
+  size_t count = countFrozenSlots(data) / 2;
+  size_t lo = 0, hi = count;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    auto keySlot = resources->getVariant(SlotId(head + mid * 2));
+    if (stringCompare(adaptString(keySlot->asString()), key) < 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  if (lo == count)
+    return iterator();
+  auto keyId = SlotId(head + lo * 2);
+  auto keySlot = resources->getVariant(keyId);
+  if (!stringEquals(key, adaptString(keySlot->asString())))
+    return iterator();
+  return iterator(keySlot, keyId);
+}
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+// Returns the index of the object (after indexing the members appended since
+// the last call), or null if the object doesn't have one
+inline ObjectIndex* VariantImpl::getObjectIndex(VariantData* data,
+                                                ResourceManager* resources) {
+  auto index = resources->getObjectIndex(data);
+  if (!index)
+    return nullptr;
+
+  auto keyId = index->lastValue == NULL_SLOT
+                   ? data->content.asCollection.head
+                   : resources->getVariant(index->lastValue)->next;
+  while (keyId != NULL_SLOT) {
+    if ((index->size + 1) * 2 > index->capacity)
+      return buildObjectIndex(data, resources);
+    auto valueId = resources->getVariant(keyId)->next;
+    addToIndex(keyId, index, resources);
+    index->lastValue = valueId;
+    keyId = resources->getVariant(valueId)->next;
+  }
+
+  return index;
+}
+
+// (Re)creates the index of the object with room for twice the current members
+inline ObjectIndex* VariantImpl::buildObjectIndex(VariantData* data,
+                                                  ResourceManager* resources) {
+  resources->destroyObjectIndex(data);
+
+  size_t keyCount = 0;
+  for (auto id = data->content.asCollection.head; id != NULL_SLOT;
+       id = resources->getVariant(id)->next)
+    keyCount++;
+  keyCount /= 2;
+
+  size_t capacity = 16;
+  while (capacity < keyCount * 4)
+    capacity *= 2;
+
+  auto index = resources->createObjectIndex(data, capacity);
+  if (!index)
+    return nullptr;
+
+  auto keyId = data->content.asCollection.head;
+  while (keyId != NULL_SLOT) {
+    auto valueId = resources->getVariant(keyId)->next;
+    addToIndex(keyId, index, resources);
+    index->lastValue = valueId;
+    keyId = resources->getVariant(valueId)->next;
+  }
+
+  return index;
+}
+
+template <typename TAdaptedString>
+inline VariantImpl::iterator VariantImpl::findKeyInIndex(
+    TAdaptedString key, ObjectIndex* index, ResourceManager* resources) {
+  auto mask = index->capacity - 1;
+  for (auto i = stringHash(key) & mask; index->keys[i] != NULL_SLOT;
+       i = (i + 1) & mask) {
+    auto keyId = index->keys[i];
+    auto keySlot = resources->getVariant(keyId);
+    if (stringEquals(key, adaptString(keySlot->asString())))
+      return iterator(keySlot, keyId);
+  }
+  return iterator();
+}
+
+inline void VariantImpl::addToIndex(SlotId keyId, ObjectIndex* index,
+                                    ResourceManager* resources) {
+  ARDUINOJSON_ASSERT(index->size * 2 < index->capacity);
+  auto key = adaptString(resources->getVariant(keyId)->asString());
+  auto mask = index->capacity - 1;
+  auto i = stringHash(key) & mask;
+  while (index->keys[i] != NULL_SLOT)
+    i = (i + 1) & mask;
+  index->keys[i] = keyId;
+  index->size++;
+}
+
+// Must be called before the key is destroyed because it needs its hash
+inline bool VariantImpl::removeFromIndex(SlotId keyId, ObjectIndex* index,
+                                         ResourceManager* resources) {
+  auto key = adaptString(resources->getVariant(keyId)->asString());
+  auto mask = index->capacity - 1;
+  auto i = stringHash(key) & mask;
+  while (index->keys[i] != keyId) {
+    if (index->keys[i] == NULL_SLOT)
+      return false;  // not indexed yet
+    i = (i + 1) & mask;
+  }
+
+  // backward-shift deletion: move up the entries that would become
+  // unreachable because of the hole
+  for (auto j = (i + 1) & mask; index->keys[j] != NULL_SLOT;
+       j = (j + 1) & mask) {
+    auto other = resources->getVariant(index->keys[j])->asString();
+    auto home = stringHash(adaptString(other)) & mask;
+    bool homeInRange = i <= j ? (i < home && home <= j)  // no wrap-around
+                              : (i < home || home <= j);
+    if (homeInRange)
+      continue;
+    index->keys[i] = index->keys[j];
+    i = j;
+  }
+  index->keys[i] = NULL_SLOT;
+  index->size--;
+  return true;
+}
+#endif
+
 template <typename TAdaptedString>
 inline VariantData* VariantImpl::addMember(TAdaptedString key,
                                            VariantData* data,
@@ -72,7 +229,11 @@ inline VariantData* VariantImpl::addMember(TAdaptedString key,
   if (!valueSlot)
     return nullptr;
 
-  if (!VariantImpl::setString(key, keySlot.ptr(), resources))
+  auto sharedKey =
+      isTinyString(key, key.size()) ? nullptr : resources->internKey(key);
+  if (sharedKey)
+    keySlot->setLongString(sharedKey);
+  else if (!VariantImpl::setString(key, keySlot.ptr(), resources))
     return nullptr;
 
   appendPair(keySlot, valueSlot, data, resources);
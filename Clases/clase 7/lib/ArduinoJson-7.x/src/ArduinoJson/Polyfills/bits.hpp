@@ -0,0 +1,76 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+
+#include <stdint.h>  // uint64_t
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#  include <intrin.h>  // _BitScanForward, _BitScanReverse, _umul128
+#endif
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Returns the index of the lowest bit set
+inline unsigned countTrailingZeros(uint64_t x) {
+  ARDUINOJSON_ASSERT(x != 0);
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+#  if defined(_M_X64) || defined(_M_ARM64)
+  _BitScanForward64(&index, x);
+#  else
+  if (!_BitScanForward(&index, static_cast<unsigned long>(x))) {
+    _BitScanForward(&index, static_cast<unsigned long>(x >> 32));
+    index += 32;
+  }
+#  endif
+  return static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+}
+
+// Returns the number of zeros above the highest bit set
+inline unsigned countLeadingZeros(uint64_t x) {
+  ARDUINOJSON_ASSERT(x != 0);
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+#  if defined(_M_X64) || defined(_M_ARM64)
+  _BitScanReverse64(&index, x);
+#  else
+  if (_BitScanReverse(&index, static_cast<unsigned long>(x >> 32)))
+    index += 32;
+  else
+    _BitScanReverse(&index, static_cast<unsigned long>(x));
+#  endif
+  return 63 - static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_clzll(x));
+#endif
+}
+
+// Returns the low half of the 128-bit product and stores the high half
+inline uint64_t multiply128(uint64_t a, uint64_t b, uint64_t& high) {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128_t;  // -pedantic
+  uint128_t product = uint128_t(a) * b;
+  high = uint64_t(product >> 64);
+  return uint64_t(product);
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+  return _umul128(a, b, &high);
+#else
+  uint64_t aLow = uint32_t(a), aHigh = a >> 32;
+  uint64_t bLow = uint32_t(b), bHigh = b >> 32;
+  uint64_t low = aLow * bLow;
+  uint64_t middle1 = aHigh * bLow + (low >> 32);
+  uint64_t middle2 = aLow * bHigh + uint32_t(middle1);
+  high = aHigh * bHigh + (middle1 >> 32) + (middle2 >> 32);
+  return (middle2 << 32) | uint32_t(low);
+#endif
+}
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -25,10 +25,20 @@ inline const T* pgm_read(const T* const* p) {
   return reinterpret_cast<const T*>(pgm_read_ptr(p));
 }
 
+inline char pgm_read(const char* p) {
+  return static_cast<char>(pgm_read_byte(p));
+}
+
 inline uint32_t pgm_read(const uint32_t* p) {
   return pgm_read_dword(p);
 }
 
+inline uint64_t pgm_read(const uint64_t* p) {
+  uint64_t result;
+  memcpy_P(&result, p, sizeof(result));
+  return result;
+}
+
 inline double pgm_read(const double* p) {
   return pgm_read_double(p);
 }
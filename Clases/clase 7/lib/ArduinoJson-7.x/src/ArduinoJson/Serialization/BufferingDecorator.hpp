@@ -0,0 +1,60 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <string.h>  // memcpy
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Collects the small writes of the serializers and forwards them to the
+// writer in large chunks.
+// The owner must call flush() at the end, which returns the number of bytes
+// accepted by the writer.
+template <typename TWriter, size_t N = ARDUINOJSON_WRITE_BUFFER_SIZE>
+class BufferingDecorator {
+ public:
+  explicit BufferingDecorator(TWriter& writer) : writer_(writer) {}
+
+  BufferingDecorator(const BufferingDecorator&) = delete;
+  BufferingDecorator& operator=(const BufferingDecorator&) = delete;
+
+  size_t write(uint8_t c) {
+    if (size_ == N)
+      flush();
+    buffer_[size_++] = c;
+    return 1;
+  }
+
+  size_t write(const uint8_t* s, size_t n) {
+    if (size_ + n > N) {
+      flush();
+      if (n > N) {  // too large to be worth copying
+        count_ += writer_.write(s, n);
+        return n;
+      }
+    }
+    memcpy(buffer_ + size_, s, n);
+    size_ += n;
+    return n;
+  }
+
+  size_t flush() {
+    if (size_) {
+      count_ += writer_.write(buffer_, size_);
+      size_ = 0;
+    }
+    return count_;
+  }
+
+ private:
+  TWriter& writer_;
+  size_t size_ = 0;
+  size_t count_ = 0;
+  uint8_t buffer_[N];
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -0,0 +1,278 @@
+// ArduinoJson - https://arduinojson.org
+// Copyright © 2014-2025, Benoit BLANCHON
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Serialization/BufferingDecorator.hpp>
+#include <ArduinoJson/Serialization/Writer.hpp>
+#include <ArduinoJson/Strings/StringAdapters.hpp>
+
+ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
+
+// Checks that the calls to JsonWriter and MsgPackWriter form a valid document:
+// keys only in objects, one value per key, matching ends, the announced
+// number of elements in MessagePack, and a single root value.
+// Only used when ARDUINOJSON_DEBUG is set.
+class WriterValidator {
+ public:
+  static const size_t unknownSize = size_t(-1);
+
+  bool beginCollection(bool isObject, size_t size) {
+    if (!value() || depth_ >= maxDepth)
+      return false;
+    uint8_t mask = uint8_t(1 << (depth_ % 8));
+    if (isObject)
+      objects_[depth_ / 8] |= mask;
+    else
+      objects_[depth_ / 8] &= uint8_t(~mask);
+    remaining_[depth_] = size;
+    depth_++;
+    return true;
+  }
+
+  bool endCollection(bool isObject) {
+    if (depth_ == 0 || afterKey_ || inObject() != isObject)
+      return false;
+    size_t remaining = remaining_[depth_ - 1];
+    if (remaining != unknownSize && remaining != 0)
+      return false;
+    depth_--;
+    return true;
+  }
+
+  bool key() {
+    if (depth_ == 0 || !inObject() || afterKey_)
+      return false;
+    afterKey_ = true;
+    return true;
+  }
+
+  bool value() {
+    if (depth_ == 0) {
+      if (started_)
+        return false;
+      started_ = true;
+      return true;
+    }
+    if (inObject()) {
+      if (!afterKey_)
+        return false;
+      afterKey_ = false;
+    }
+    size_t& remaining = remaining_[depth_ - 1];
+    if (remaining == 0)
+      return false;
+    if (remaining != unknownSize)
+      remaining--;
+    return true;
+  }
+
+  bool isComplete() const {
+    return started_ && depth_ == 0;
+  }
+
+ private:
+  static const uint8_t maxDepth = 32;
+
+  bool inObject() const {
+    return (objects_[(depth_ - 1) / 8] & (1 << ((depth_ - 1) % 8))) != 0;
+  }
+
+  size_t remaining_[maxDepth];
+  uint8_t objects_[maxDepth / 8];  // one bit per level: 1 = object, 0 = array
+  uint8_t depth_ = 0;
+  bool afterKey_ = false;
+  bool started_ = false;
+};
+
+// Writers that keep their own buffer, like Writer<::String>, have a flush()
+template <typename TWriter, typename = void>
+struct HasFlush : false_type {};
+
+template <typename TWriter>
+struct HasFlush<TWriter, void_t<decltype(declval<TWriter&>().flush())>>
+    : true_type {};
+
+// The part of JsonWriter and MsgPackWriter that doesn't depend on the format.
+// TTokenWriter<TWriter> writes the tokens; the output goes through the same
+// BufferingDecorator as serializeJson().
+template <template <typename> class TTokenWriter, typename TDestination>
+class StreamingWriter {
+#if ARDUINOJSON_WRITE_BUFFER_SIZE
+  using output_type = BufferingDecorator<Writer<TDestination>>;
+#else
+  using output_type = Writer<TDestination>;
+#endif
+
+ public:
+  explicit StreamingWriter(TDestination& destination)
+      : writer_(destination),
+#if ARDUINOJSON_WRITE_BUFFER_SIZE
+        buffer_(writer_),
+        tokens_(buffer_) {
+  }
+#else
+        tokens_(writer_) {
+  }
+#endif
+
+  StreamingWriter(const StreamingWriter&) = delete;
+  StreamingWriter& operator=(const StreamingWriter&) = delete;
+
+  ~StreamingWriter() {
+    flush();
+  }
+
+  void endArray() {
+#if ARDUINOJSON_DEBUG
+    bool ok = validator_.endCollection(false);
+    ARDUINOJSON_ASSERT(ok);
+    (void)ok;
+#endif
+    tokens_.endArray();
+    endValue(1);
+  }
+
+  void endObject() {
+#if ARDUINOJSON_DEBUG
+    bool ok = validator_.endCollection(true);
+    ARDUINOJSON_ASSERT(ok);
+    (void)ok;
+#endif
+    tokens_.endObject();
+    endValue(1);
+  }
+
+  template <typename TString,
+            detail::enable_if_t<IsString<TString>::value, int> = 0>
+  void key(const TString& s) {
+#if ARDUINOJSON_DEBUG
+    bool ok = validator_.key();
+    ARDUINOJSON_ASSERT(ok);
+    (void)ok;
+#endif
+    auto str = adaptString(s);
+    if (str.isNull())
+      tokens_.writeKey(RamString("", 0));
+    else
+      tokens_.writeKey(str);
+  }
+
+  template <typename TString,
+            detail::enable_if_t<IsString<TString>::value, int> = 0>
+  void value(const TString& s) {
+    beginValue();
+    auto str = adaptString(s);
+    if (str.isNull())
+      tokens_.writeNull();
+    else
+      tokens_.writeString(str);
+    endValue(0);
+  }
+
+  template <typename T,
+            detail::enable_if_t<is_integral<T>::value && !is_same<T, bool>::value,
+                                int> = 0>
+  void value(T n) {
+    beginValue();
+    tokens_.writeInteger(n);
+    endValue(0);
+  }
+
+  template <typename T,
+            detail::enable_if_t<is_floating_point<T>::value, int> = 0>
+  void value(T n) {
+    beginValue();
+    tokens_.writeFloat(n);
+    endValue(0);
+  }
+
+  // bool and nullptr_t are templates so that MemberProxy and ElementProxy,
+  // which convert to anything, pick the JsonVariantConst overload
+  template <typename T, detail::enable_if_t<is_same<T, bool>::value, int> = 0>
+  void value(T b) {
+    beginValue();
+    tokens_.writeBoolean(b);
+    endValue(0);
+  }
+
+  template <typename T,
+            detail::enable_if_t<is_same<T, nullptr_t>::value, int> = 0>
+  void value(T) {
+    beginValue();
+    tokens_.writeNull();
+    endValue(0);
+  }
+
+  // Writes the content of a JsonDocument, a JsonArray, etc.
+  void value(JsonVariantConst variant) {
+    beginValue();
+    tokens_.writeVariant(variant);
+    endValue(0);
+  }
+
+  // Sends the buffered bytes to the destination and returns the number of
+  // bytes written so far.
+  // This is done automatically at the end of the root value.
+  size_t flush() {
+#if ARDUINOJSON_WRITE_BUFFER_SIZE
+    size_t n = buffer_.flush();
+#else
+    size_t n = tokens_.bytesWritten();
+#endif
+    flushWriter(writer_);
+    return n;
+  }
+
+ protected:
+  void beginCollection(bool isObject, size_t size) {
+#if ARDUINOJSON_DEBUG
+    bool ok = validator_.beginCollection(isObject, size);
+    ARDUINOJSON_ASSERT(ok);
+    (void)ok;
+#endif
+    tokens_.beginCollection(isObject, size);
+    depth_++;
+  }
+
+ private:
+  void beginValue() {
+#if ARDUINOJSON_DEBUG
+    bool ok = validator_.value();
+    ARDUINOJSON_ASSERT(ok);
+    (void)ok;
+#endif
+  }
+
+  template <typename TWriter>
+  static enable_if_t<HasFlush<TWriter>::value> flushWriter(TWriter& writer) {
+    writer.flush();
+  }
+
+  template <typename TWriter>
+  static enable_if_t<!HasFlush<TWriter>::value> flushWriter(TWriter&) {}
+
+  void endValue(uint8_t closedCollections) {
+    if (depth_ > closedCollections)
+      depth_ = uint8_t(depth_ - closedCollections);
+    else  // an endArray() or endObject() without a beginning
+      depth_ = 0;
+    if (depth_ == 0)
+      flush();
+  }
+
+  Writer<TDestination> writer_;
+#if ARDUINOJSON_WRITE_BUFFER_SIZE
+  output_type buffer_;
+#endif
+  TTokenWriter<output_type&> tokens_;
+  uint8_t depth_ = 0;
+#if ARDUINOJSON_DEBUG
+  WriterValidator validator_;
+#endif
+};
+
+ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <ArduinoJson/Serialization/BufferingDecorator.hpp>
 #include <ArduinoJson/Serialization/Writer.hpp>
 
 ARDUINOJSON_BEGIN_PRIVATE_NAMESPACE
@@ -20,7 +21,15 @@ template <template <typename> class TSerializer, typename TDestination>
 size_t serialize(ArduinoJson::JsonVariantConst source,
                  TDestination& destination) {
   Writer<TDestination> writer(destination);
+#if ARDUINOJSON_WRITE_BUFFER_SIZE
+  // the destination receives a few large writes instead of one per token
+  BufferingDecorator<Writer<TDestination>> buffer(writer);
+  doSerialize<TSerializer, BufferingDecorator<Writer<TDestination>>&>(source,
+                                                                      buffer);
+  return buffer.flush();
+#else
   return doSerialize<TSerializer>(source, writer);
+#endif
 }
 
 template <template <typename> class TSerializer>
@@ -69,4 +69,23 @@ static void stringGetChars(TAdaptedString s, char* p, size_t n) {
   }
 }
 
+// Hashes all the characters, so that strings that differ anywhere rarely
+// collide, eight at a time to limit the cost on long texts.
+// Each step folds the high bits into the low bits because the hash tables use
+// the low bits to select the bucket.
+template <typename TAdaptedString>
+uint32_t stringHash(const TAdaptedString& s) {
+  const uint64_t multiplier = 0x9E3779B97F4A7C15;
+  size_t n = s.size();
+  uint64_t h = n;
+  for (size_t i = 0; i < n; i += 8) {
+    uint64_t word = 0;
+    for (size_t j = 0; j < 8 && i + j < n; j++)
+      word |= uint64_t(uint8_t(s[i + j])) << (8 * j);
+    h = (h ^ word) * multiplier;
+    h ^= h >> 32;
+  }
+  return uint32_t(h ^ (h >> 16));
+}
+
 ARDUINOJSON_END_PRIVATE_NAMESPACE
@@ -52,6 +52,8 @@ struct VariantData {
       case VariantType::LongString:
         return JsonString(content.asStringNode->data,
                           content.asStringNode->length);
+      case VariantType::LinkedString:
+        return JsonString(content.asLinkedString);
       default:
         return JsonString();
     }
@@ -82,7 +84,8 @@ struct VariantData {
   }
 
   bool isString() const {
-    return type == VariantType::LongString || type == VariantType::TinyString;
+    return type == VariantType::LongString ||
+           type == VariantType::TinyString || type == VariantType::LinkedString;
   }
 
   void setBoolean(bool value) {
@@ -122,6 +125,14 @@ struct VariantData {
     content.asStringNode = s;
   }
 
+  // The string is not copied, it must outlive the variant
+  void setLinkedString(const char* s) {
+    ARDUINOJSON_ASSERT(type == VariantType::Null);
+    ARDUINOJSON_ASSERT(s);
+    type = VariantType::LinkedString;
+    content.asLinkedString = s;
+  }
+
   CollectionData* toArray() {
     ARDUINOJSON_ASSERT(type == VariantType::Null);
     type = VariantType::Array;
@@ -70,6 +70,9 @@ class VariantImpl {
         return visit.visit(JsonString(data->content.asStringNode->data,
                                       data->content.asStringNode->length));
 
+      case VariantType::LinkedString:
+        return visit.visit(JsonString(data->content.asLinkedString));
+
       case VariantType::RawString:
         return visit.visit(RawString(data->content.asStringNode->data,
                                      data->content.asStringNode->length));
@@ -196,6 +199,9 @@ class VariantImpl {
       case VariantType::LongString:
         str = data->content.asStringNode->data;
         break;
+      case VariantType::LinkedString:
+        str = data->content.asLinkedString;
+        break;
       case VariantType::Float:
         return static_cast<T>(data->content.asFloat);
 #if ARDUINOJSON_USE_DOUBLE
@@ -244,6 +250,9 @@ class VariantImpl {
       case VariantType::LongString:
         str = data->content.asStringNode->data;
         break;
+      case VariantType::LinkedString:
+        str = data->content.asLinkedString;
+        break;
       case VariantType::Float:
         return convertNumber<T>(data->content.asFloat);
 #if ARDUINOJSON_USE_DOUBLE
@@ -373,6 +382,12 @@ class VariantImpl {
     removePair(it);
   }
 
+  // Removes the elements of an array, or the members of an object, for which
+  // pred(iterator) returns true, in a single pass.
+  // Returns the number of elements or members removed.
+  template <typename TPredicate>
+  size_t removeIf(TPredicate& pred);
+
   bool setBoolean(bool value) {
     if (!data_)
       return false;
@@ -543,10 +558,19 @@ class VariantImpl {
     ARDUINOJSON_ASSERT(data->isCollection());
     ARDUINOJSON_ASSERT(resources != nullptr);
 
-    size_t n = 0;
-    for (auto it = createIterator(data, resources); !it.done();
-         it.move(resources))
-      n++;
+    size_t n;
+    if (resources->frozen()) {
+      n = countFrozenSlots(data);
+    } else {
+#if ARDUINOJSON_COLLECTION_CACHE_SIZE
+      auto cache = resources->cacheCollection(data);
+      if (cache->slotCount == CollectionCache::unknownSize)
+        cache->slotCount = countSlots(data, resources);
+      n = cache->slotCount;
+#else
+      n = countSlots(data, resources);
+#endif
+    }
 
     if (data->type == VariantType::Object) {
       ARDUINOJSON_ASSERT((n % 2) == 0);
@@ -589,7 +613,7 @@ class VariantImpl {
     ARDUINOJSON_ASSERT(resources != nullptr);
 
     if (data->type & VariantTypeBits::OwnedStringBit)
-      resources->dereferenceString(data->content.asStringNode->data);
+      resources->dereferenceString(data->content.asStringNode);
 
 #if ARDUINOJSON_USE_8_BYTE_POOL
     if (data->type & VariantTypeBits::EightByteBit)
@@ -610,6 +634,16 @@ class VariantImpl {
 
   static void empty(VariantData*, ResourceManager*);
 
+  static size_t countSlots(VariantData*, ResourceManager*);
+
+  // In a frozen document, the children of a collection have consecutive ids
+  static size_t countFrozenSlots(const VariantData* data) {
+    auto& coll = data->content.asCollection;
+    if (coll.head == NULL_SLOT)
+      return 0;
+    return size_t(coll.tail - coll.head) + 1;
+  }
+
   static void freeVariant(Slot<VariantData> slot, ResourceManager* resources) {
     clear(slot.ptr(), resources);
     resources->freeVariant(slot);
@@ -629,13 +663,31 @@ class VariantImpl {
   template <typename TAdaptedString>
   static iterator findKey(TAdaptedString key, VariantData*, ResourceManager*);
 
+  template <typename TAdaptedString>
+  static iterator findFrozenKey(TAdaptedString key, VariantData*,
+                                ResourceManager*);
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  static ObjectIndex* getObjectIndex(VariantData*, ResourceManager*);
+  static ObjectIndex* buildObjectIndex(VariantData*, ResourceManager*);
+
+  template <typename TAdaptedString>
+  static iterator findKeyInIndex(TAdaptedString key, ObjectIndex*,
+                                 ResourceManager*);
+
+  static void addToIndex(SlotId keyId, ObjectIndex*, ResourceManager*);
+  static bool removeFromIndex(SlotId keyId, ObjectIndex*, ResourceManager*);
+#endif
+
   static void appendPair(Slot<VariantData> key, Slot<VariantData> value,
                          VariantData*, ResourceManager*);
 
+  void unlinkSlots(Slot<VariantData> prev, SlotId next, size_t count);
   void removeOne(iterator it);
   void removePair(iterator it);
 
   Slot<VariantData> getPreviousSlot(VariantData*) const;
+  Slot<VariantData> getPreviousSlot(iterator) const;
 };
 
 ARDUINOJSON_END_PRIVATE_NAMESPACE
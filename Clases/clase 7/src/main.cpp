@@ -81,26 +81,46 @@ String askGemini(const String& userInput) {
 
     https.addHeader("Content-Type", "application/json");
 
-    JsonDocument payloadDoc;
-
-    JsonObject systemInstruction = payloadDoc.createNestedObject("systemInstruction");
-    systemInstruction["role"] = "system";
-    JsonArray systemParts = systemInstruction.createNestedArray("parts");
-    JsonObject systemPart0 = systemParts.createNestedObject();
-    systemPart0["text"] = SYSTEM_PROMPT;    // Aquí va el SYSTEM_PROMPT completo
-
-    JsonArray contents = payloadDoc.createNestedArray("contents");
-    JsonObject userMsg = contents.createNestedObject();
-    userMsg["role"] = "user";
-    JsonArray userParts = userMsg.createNestedArray("parts");
-    JsonObject userPart0 = userParts.createNestedObject();
-    userPart0["text"] = userInput;           // Aquí va lo que el estudiante escribe
-
-    JsonObject genCfg = payloadDoc.createNestedObject("generationConfig");
-    genCfg["maxOutputTokens"] = GEMINI_MAX_TOKENS;
-
+    // El JSON se escribe directamente en el String, sin JsonDocument
     String payload;
-    serializeJson(payloadDoc, payload);
+    JsonWriter<String> writer(payload);
+    writer.beginObject();
+
+    writer.key("systemInstruction");
+    writer.beginObject();
+    writer.key("role");
+    writer.value("system");
+    writer.key("parts");
+    writer.beginArray();
+    writer.beginObject();
+    writer.key("text");
+    writer.value(SYSTEM_PROMPT);    // Aquí va el SYSTEM_PROMPT completo
+    writer.endObject();
+    writer.endArray();
+    writer.endObject();
+
+    writer.key("contents");
+    writer.beginArray();
+    writer.beginObject();
+    writer.key("role");
+    writer.value("user");
+    writer.key("parts");
+    writer.beginArray();
+    writer.beginObject();
+    writer.key("text");
+    writer.value(userInput);        // Aquí va lo que el estudiante escribe
+    writer.endObject();
+    writer.endArray();
+    writer.endObject();
+    writer.endArray();
+
+    writer.key("generationConfig");
+    writer.beginObject();
+    writer.key("maxOutputTokens");
+    writer.value(GEMINI_MAX_TOKENS);
+    writer.endObject();
+
+    writer.endObject();             // aquí se completa el payload
 
     int httpResponseCode = https.POST(payload);
 
@@ -114,16 +134,18 @@ String askGemini(const String& userInput) {
     String response = https.getString();
     https.end();
 
+    // Solo se guarda el texto generado, el resto de la respuesta se descarta
     JsonDocument responseDoc;
+    const char* pointers[] = {"/candidates/0/content/parts/0/text"};
 
-    DeserializationError error = deserializeJson(responseDoc, response);
+    DeserializationError error = extractJson(responseDoc, response, pointers);
     if (error) {
         Serial.print("JSON deserialization error: ");
         Serial.println(error.c_str());
         return "ERROR en JSON";
     }
 
-    const char* generatedText = responseDoc["candidates"][0]["content"]["parts"][0]["text"];
+    const char* generatedText = responseDoc[0];
     if(!generatedText) {
         Serial.println("No se encontro texto generado");
         return "NONE";